@@ -13,6 +13,9 @@
  * 
  * @note The ESP-EDU have 4 analog inputs and 1 analog output, but the designated pin for 
  * the latter is shared with analog output 0 (CH0).
+ * 
+ * The calibration curve of each channel is tabulated for every raw value (4096 entries, 8 kB per
+ * channel) when the channel is initialized, so raw values are converted to mV with one table read. 
  *
  * @author Albano Peñalva
  *
@@ -21,11 +24,17 @@
  * |   Date	    | Description                                    						|
  * |:----------:|:----------------------------------------------------------------------|
  * | 24/02/2024 | Document creation		                         						|
+ * | 17/10/2026 | Continuous mode (DMA) with double-buffered blocks						|
+ * | 17/10/2026 | Multi-channel scan groups with per-channel ring buffers				|
+ * | 17/10/2026 | Calibration tables and block conversion to mV							|
+ * | 17/10/2026 | Timer-driven DAC waveform player										|
+ * | 17/10/2026 | Oversampling with CIC decimation in continuous mode					|
  * 
  **/
 
 /*==================[inclusions]=============================================*/
 #include "stdint.h"
+#include "stdbool.h"
 /*==================[macros]=================================================*/
 typedef enum adc_ch {
 	CH0 = 0,				/*!< Channel 0 */
@@ -40,6 +49,11 @@ typedef enum adc_mode {
 } adc_mode_t;
 
 #define DAC	0    			/*!< DAC pin. Override CH0 declaration*/
+
+#define ADC_CONTINUOUS_BLOCK_SIZE	256		/*!< Default samples per block in continuous mode */
+#define ADC_SCAN_MAX_INPUTS			4		/*!< Max channels in a scan group */
+#define DAC_PLAYER_QUEUE			4		/*!< Max buffers queued in the waveform player */
+#define ADC_OVERSAMPLING_MAX		64		/*!< Max conversions per sample in continuous mode */
 /*==================[typedef]================================================*/
 /**
  * @brief Analog inputs config structure
@@ -48,17 +62,62 @@ typedef enum adc_mode {
 typedef struct {			
 	adc_ch_t input;			/*!< Inputs: CH0, CH1, CH2, CH3 */
 	adc_mode_t mode;		/*!< Mode: single read or continuous read */
-	void *func_p;			/*!< Pointer to callback function for convertion end (only for continuous mode) */
+	void *func_p;			/*!< Pointer to callback function called from the ADC ISR each time a block is complete (only for continuous mode) */
 	void *param_p;			/*!< Pointer to callback function parameters (only for continuous mode) */
-	uint16_t sample_frec;	/*!< Sample frequency min: 20kHz - max: 2MHz (only for continuous mode)  */
+	uint32_t sample_frec;	/*!< Sample frequency, sample_frec * oversampling min: 611Hz - max: 83333Hz (only for continuous mode)  */
+	uint16_t block_size;	/*!< Samples per block, 0 for ADC_CONTINUOUS_BLOCK_SIZE (only for continuous mode) */
+	uint8_t oversampling;	/*!< Conversions per sample, power of 2 up to ADC_OVERSAMPLING_MAX (16, 64...), 0 or 1 for none (only for continuous mode) */
+	uint8_t output_bits;	/*!< Sample resolution with oversampling, 12 to 16 bits, 0 for 12 + log2(oversampling) / 2 (only for continuous mode) */
+	uint8_t cic_order;		/*!< Decimation filter order with oversampling, 1 (averaging) to 3, 0 for 1 (only for continuous mode) */
 } analog_input_config_t;	
 
+/**
+ * @brief Scan group config structure
+ * 
+ */
+typedef struct {
+	const adc_ch_t *inputs;	/*!< Channels of the group, in conversion order (up to ADC_SCAN_MAX_INPUTS) */
+	uint8_t n_inputs;		/*!< Number of channels */
+	uint32_t scan_frec;		/*!< Scans per second, scan_frec * n_inputs min: 611Hz - max: 83333Hz */
+	uint16_t ring_size;		/*!< Scans stored per channel until they are read, 1 to 65534 */
+	uint16_t block_scans;	/*!< Scans per DMA frame (func_p is called once per frame), 0 for default */
+	void *func_p;			/*!< Pointer to callback function called from the ADC ISR when new scans are stored */
+	void *param_p;			/*!< Pointer to callback function parameters */
+} analog_scan_config_t;
+
+/**
+ * @brief Waveform player config structure
+ * 
+ */
+typedef struct {
+	uint32_t sample_frec;	/*!< Samples per second (the period is rounded to 1 us) */
+	bool loop;				/*!< true: played buffers are queued again (periodic waveforms), false: played buffers are released */
+	void *func_p;			/*!< Pointer to callback function called from the timer ISR each time a buffer has been played */
+	void *param_p;			/*!< Pointer to callback function parameters */
+} analog_player_config_t;
+
 /*==================[external data declaration]==============================*/
 
 /*==================[external functions declaration]=========================*/
 /**
  * @brief Analog input initialization
  * 
+ * In continuous mode the ADC converts the channel at sample_frec by DMA, without CPU
+ * intervention per sample. Samples are stored in two blocks of block_size samples: while 
+ * one is being filled, the other (the last complete one) can be read with AnalogInputReadContinuous().
+ * func_p is called from the ADC ISR each time a block is complete (notify a task from it, as with 
+ * the timer callbacks).
+ * 
+ * With oversampling the channel is converted oversampling times faster and each sample is the 
+ * output of a CIC decimation filter (integer, in the ADC ISR): an average of oversampling conversions
+ * for cic_order 1, with more attenuation of the frequencies that alias for higher orders. With the
+ * ADC noise acting as dither, the noise is reduced about sqrt(oversampling) times (2 bits more for 16x,
+ * 3 bits for 64x), so samples are given with output_bits (raw value * 2^(output_bits - 12)). 
+ * The first cic_order - 1 samples after a start are the filter settling.
+ * 
+ * @note Only one channel can be in continuous mode, a new continuous initialization replaces the
+ * previous one. Single reads are not possible while continuous conversions are running.
+ * 
  * @param config Analog inputs config structure
  * @return null
  */
@@ -80,10 +139,24 @@ void AnalogOutputInit(void);
  */
 void AnalogInputReadSingle(adc_ch_t channel, uint16_t *value);
 
+/**
+ * @brief Convert raw values (continuous mode blocks, scans) to mV with the channel calibration
+ * 
+ * @note The calibration table is built on the first call for a channel not initialized before.
+ * 
+ * @param channel Channel the values were read from
+ * @param raw Raw values (12 bit, shift oversampled values right by output_bits - 12)
+ * @param mv Values in mV (may be the raw array)
+ * @param n Number of values
+ */
+void AnalogInputConvertBlock(adc_ch_t channel, const uint16_t *raw, uint16_t *mv, uint16_t n);
+
 /**
  * @brief Start convertion for ADC module in continuous mode
  * 
- * @param channel Channel selected
+ * Blocks not read before are discarded.
+ * 
+ * @param channel Channel selected (initialized in continuous mode)
  */
 void AnalogStartContinuous(adc_ch_t channel);
 
@@ -95,12 +168,115 @@ void AnalogStartContinuous(adc_ch_t channel);
 void AnalogStopContinuous(adc_ch_t channel);
 
 /**
- * @brief 
+ * @brief Read the last complete block of a channel in continuous mode
  * 
  * @param channel Channel selected.
- * @param values Read variable array
+ * @param values Read variable array (block_size raw values, 12 bit or output_bits with oversampling)
+ * @return true if a new block was read, false if there is no complete block since the last read
+ */
+bool AnalogInputReadContinuous(adc_ch_t channel, uint16_t *values);
+
+/**
+ * @brief Number of blocks lost because they were not read before the next one was complete
+ * 
+ * @param channel Channel selected.
+ * @return Blocks lost since the last AnalogStartContinuous()
+ */
+uint32_t AnalogInputContinuousOverruns(adc_ch_t channel);
+
+/**
+ * @brief Scan group initialization
+ * 
+ * The channels of the group are converted one after the other by DMA, scan_frec times per second.
+ * Each scan (one sample of every channel) is stored in per-channel rings of ring_size scans with one 
+ * timestamp shared by its channels, so channels of the same scan can be processed together (ECG leads,
+ * accelerometer axes...). When the rings are full the oldest scan is overwritten and counted as overrun.
+ * 
+ * @note The group uses the DMA of continuous mode: it replaces a channel in continuous mode and a 
+ * continuous initialization replaces it. Single reads are not possible while the group is running.
+ * 
+ * @param config Scan group config structure
+ */
+void AnalogScanInit(analog_scan_config_t *config);
+
+/**
+ * @brief Start the scan group conversions
+ * 
+ * Scans not read before are discarded.
+ */
+void AnalogScanStart(void);
+
+/**
+ * @brief Stop the scan group conversions
+ */
+void AnalogScanStop(void);
+
+/**
+ * @brief Read the oldest scans not read yet
+ * 
+ * @param values Array of n_inputs pointers, values[i] receives the raw values (12 bit) of inputs[i]
+ * @param timestamps Time of each scan (us, esp_timer time base), may be NULL
+ * @param max_scans Max scans to read (length of each values[i] array)
+ * @return Scans read
+ */
+uint16_t AnalogScanRead(uint16_t *values[], int64_t *timestamps, uint16_t max_scans);
+
+/**
+ * @brief Number of scans lost because they were not read before the rings were full
+ * 
+ * @return Scans lost since the last AnalogScanStart()
+ */
+uint32_t AnalogScanOverruns(void);
+
+/**
+ * @brief Waveform player initialization
+ * 
+ * The player outputs queued buffers through the DAC at sample_frec, writing each sample from a 
+ * timer ISR (no task wake-up per sample). Buffers are played in order without gaps between them. 
+ * func_p is called each time a buffer has been played: without loop the buffer is released and can be 
+ * refilled and queued again (double buffering with two buffers), with loop it has been queued again 
+ * (one buffer repeats a table, e.g. an ECG).
+ * When there is nothing to play the output keeps the last sample and the periods are counted as underruns.
+ * 
+ * @note AnalogOutputInit() must be called before. AnalogOutputWrite() should not be used while the 
+ * player is running.
+ * 
+ * @param config Waveform player config structure
+ */
+void AnalogOutputPlayerInit(analog_player_config_t *config);
+
+/**
+ * @brief Add a buffer at the end of the player queue
+ * 
+ * The buffer is read from the timer ISR until it has been played, it must not be modified before.
+ * 
+ * @param buffer Samples (from 0 to 255, as AnalogOutputWrite())
+ * @param lenght Number of samples
+ * @return true if the buffer was queued, false if the queue is full (DAC_PLAYER_QUEUE buffers)
+ */
+bool AnalogOutputPlayerQueue(const uint8_t *buffer, uint16_t lenght);
+
+/**
+ * @brief Start (or resume) the waveform player
+ */
+void AnalogOutputPlayerStart(void);
+
+/**
+ * @brief Stop (pause) the waveform player, the queue is kept
+ */
+void AnalogOutputPlayerStop(void);
+
+/**
+ * @brief Remove every buffer from the player queue and clear the underruns
+ */
+void AnalogOutputPlayerFlush(void);
+
+/**
+ * @brief Number of sample periods without a buffer to play
+ * 
+ * @return Underruns since AnalogOutputPlayerInit() or AnalogOutputPlayerFlush()
  */
-void AnalogInputReadContinuous(adc_ch_t channel, uint16_t *values);
+uint32_t AnalogOutputPlayerUnderruns(void);
 
 /**
  * @brief Digital-to-Analog convert.
@@ -10,22 +10,117 @@
  */
 
 /*==================[inclusions]=============================================*/
+#include <string.h>
+#include <stdlib.h>
 #include "analog_io_mcu.h"
+#include "freertos/FreeRTOS.h"
 #include "driver/gptimer.h"
 #include "driver/sdm.h"
 #include "esp_adc/adc_cali_scheme.h"
 #include "esp_adc/adc_oneshot.h"
 #include "esp_adc/adc_continuous.h"
+#include "esp_timer.h"
 /*==================[macros and definitions]=================================*/
 #define ADC_BITWIDTH 		SOC_ADC_DIGI_MAX_BITWIDTH	// 12 bit resolution
 #define ADC_ATTENUATION		ADC_ATTEN_DB_12				// 12dB attenuation (for 0-3,3V ADC range)
+#define ADC_FRAME_RESULTS	128							// Max conversion results per DMA frame (one ISR per frame)
+#define ADC_SCAN_BLOCK		32							// Default scans per DMA frame in scan mode
+#define ADC_CHANNELS		4							// CH0 - CH3
+#define ADC_LUT_SIZE		(1 << ADC_BITWIDTH)			// One entry per raw value
+#define DAC_TIMER_RES_HZ	1000000						// Player timer resolution (1 us)
+#define ADC_CIC_MAX_ORDER	3							// Bit growth 12 + 3 * log2(64) = 30 fits the 32 bit CIC registers
 /*==================[internal data declaration]==============================*/
-adc_cali_handle_t adc_calibration_single_0, adc_calibration_single_1, adc_calibration_single_2, adc_calibration_single_3;
+adc_cali_handle_t adc_calibration[ADC_CHANNELS] = {NULL};
 adc_oneshot_unit_handle_t adc1_single; 
-adc_continuous_handle_t adc2_cont;
+adc_continuous_handle_t adc2_cont = NULL;
 sdm_channel_handle_t dac = NULL;
 bool adc1_single_used = false;
+/**
+ * @brief Continuous mode state: the ISR fills one block while the other can be read
+ */
+typedef struct {
+	adc_ch_t channel;				/*!< Channel converted */
+	uint16_t block_size;			/*!< Samples per block */
+	uint16_t *block[2];				/*!< Double buffer */
+	uint16_t fill;					/*!< Samples in the block being filled */
+	uint8_t write;					/*!< Index of the block being filled */
+	bool ready;						/*!< The other block is complete and not read yet */
+	uint32_t overruns;				/*!< Complete blocks overwritten before being read */
+	void (*func_p)(void*);			/*!< Block complete callback */
+	void *param_p;					/*!< Block complete callback parameter */
+	uint8_t decimation;				/*!< Conversions per sample (1: no oversampling) */
+	uint8_t cic_order;				/*!< Integrator-comb stages */
+	int8_t shift;					/*!< Right shift from the CIC output to output_bits */
+	uint8_t phase;					/*!< Conversions integrated for the next sample */
+	uint32_t integrator[ADC_CIC_MAX_ORDER];	/*!< CIC integrators (modulo 2^32) */
+	uint32_t comb[ADC_CIC_MAX_ORDER];		/*!< CIC comb delays */
+} adc_cont_state_t;
+/**
+ * @brief Scan mode state: one ring per channel, one timestamp per scan
+ * 
+ * The rings have one slot more than ring_size: the scan being converted is written in 
+ * the slot after the newest one, never in one that can be read.
+ */
+typedef struct {
+	uint8_t n_inputs;						/*!< Channels per scan */
+	adc_ch_t inputs[ADC_SCAN_MAX_INPUTS];	/*!< Channels, in conversion order */
+	uint16_t slots;							/*!< Ring slots (ring_size + 1) */
+	uint16_t *ring[ADC_SCAN_MAX_INPUTS];	/*!< Rings, one per channel */
+	int64_t *time;							/*!< Timestamp ring */
+	uint8_t next;							/*!< Next channel of the scan being converted */
+	uint16_t write;							/*!< Slot of the scan being converted */
+	uint16_t read;							/*!< Slot of the oldest scan not read */
+	uint32_t conv_frec;						/*!< Conversions per second (all channels) */
+	uint32_t overruns;						/*!< Scans overwritten before being read */
+	void (*func_p)(void*);					/*!< New scans callback */
+	void *param_p;							/*!< New scans callback parameter */
+} adc_scan_state_t;
+/**
+ * @brief Use of the DMA driver
+ */
+typedef enum {
+	ADC_DMA_NONE,					/*!< Not created */
+	ADC_DMA_CONTINUOUS,				/*!< One channel in continuous mode */
+	ADC_DMA_SCAN					/*!< Scan group */
+} adc_dma_mode_t;
+static adc_cont_state_t adc_cont;
+static adc_scan_state_t adc_scan;
+static adc_dma_mode_t adc_dma_mode = ADC_DMA_NONE;
+static bool adc_dma_running = false;
+static portMUX_TYPE adc_cont_lock = portMUX_INITIALIZER_UNLOCKED;
+static uint16_t *adc_lut[ADC_CHANNELS] = {NULL};	// raw to mV tables (calibration at ADC_ATTENUATION)
+/**
+ * @brief Waveform player buffer
+ */
+typedef struct {
+	const uint8_t *samples;			/*!< Samples (0 to 255) */
+	uint16_t lenght;				/*!< Number of samples */
+} dac_buffer_t;
+/**
+ * @brief Waveform player state: queue of buffers, the first one is being played
+ */
+typedef struct {
+	dac_buffer_t queue[DAC_PLAYER_QUEUE];	/*!< Buffers to play, ring */
+	uint8_t head;							/*!< Buffer being played */
+	uint8_t count;							/*!< Buffers in the queue */
+	uint16_t pos;							/*!< Next sample of the buffer being played */
+	bool loop;								/*!< Buffers are queued again once played */
+	bool running;							/*!< Timer started */
+	uint32_t underruns;						/*!< Sample periods without a buffer to play */
+	void (*func_p)(void*);					/*!< Buffer played callback */
+	void *param_p;							/*!< Buffer played callback parameter */
+} dac_player_state_t;
+static gptimer_handle_t dac_timer = NULL;
+static dac_player_state_t dac_player;
+static portMUX_TYPE dac_player_lock = portMUX_INITIALIZER_UNLOCKED;
 /*==================[internal functions declaration]=========================*/
+static bool IRAM_ATTR AnalogConvDone(adc_continuous_handle_t handle, const adc_continuous_evt_data_t *edata, void *user_data);
+static bool IRAM_ATTR AnalogScanDone(adc_continuous_handle_t handle, const adc_continuous_evt_data_t *edata, void *user_data);
+static void AnalogDmaInit(const adc_ch_t *inputs, uint8_t n_inputs, uint32_t conv_frec, uint32_t frame_results, adc_continuous_callback_t isr);
+static void AnalogDmaDeinit(void);
+static void AnalogContinuousInit(analog_input_config_t *config);
+static void AnalogCalibrationInit(adc_ch_t channel);
+static bool IRAM_ATTR AnalogPlayerTick(gptimer_handle_t timer, const gptimer_alarm_event_data_t *edata, void *user_data);
 
 /*==================[internal data definition]===============================*/
 adc_oneshot_unit_init_cfg_t init_config_single = {
@@ -39,6 +134,235 @@ adc_oneshot_chan_cfg_t adc_config_single = {
 /*==================[external data definition]===============================*/
 
 /*==================[internal functions definition]==========================*/
+/**
+ * @brief Create the calibration curve of a channel and tabulate it for every raw value
+ * 
+ * The curve fitting scheme is evaluated once per raw value here, conversions are then a table read.
+ */
+static void AnalogCalibrationInit(adc_ch_t channel){
+	if(adc_lut[channel] != NULL){
+		return;
+	}
+	adc_cali_curve_fitting_config_t cali_config = {
+		.unit_id = ADC_UNIT_1,
+		.chan = (adc_channel_t)channel, 
+		.atten = ADC_ATTENUATION,
+		.bitwidth = ADC_BITWIDTH,
+	};
+	ESP_ERROR_CHECK(adc_cali_create_scheme_curve_fitting(&cali_config, &adc_calibration[channel]));
+	adc_lut[channel] = malloc(ADC_LUT_SIZE * sizeof(uint16_t));
+	ESP_ERROR_CHECK((adc_lut[channel] == NULL) ? ESP_ERR_NO_MEM : ESP_OK);
+	for(int raw = 0; raw < ADC_LUT_SIZE; raw++){
+		int voltage;
+		ESP_ERROR_CHECK(adc_cali_raw_to_voltage(adc_calibration[channel], raw, &voltage));
+		adc_lut[channel][raw] = (voltage < 0) ? 0 : voltage;
+	}
+}
+
+/**
+ * @brief DMA frame complete: store its samples in the block being filled
+ */
+static bool IRAM_ATTR AnalogConvDone(adc_continuous_handle_t handle, const adc_continuous_evt_data_t *edata, void *user_data){
+	bool block_done = false;
+	portENTER_CRITICAL_ISR(&adc_cont_lock);
+	for(uint32_t i = 0; i < edata->size; i += SOC_ADC_DIGI_RESULT_BYTES){
+		adc_digi_output_data_t *result = (adc_digi_output_data_t*)&edata->conv_frame_buffer[i];
+		if(result->type2.channel != adc_cont.channel){
+			continue;
+		}
+		uint32_t sample = result->type2.data;
+		if(adc_cont.decimation > 1){
+			// CIC decimator: integrators at the conversion rate, combs at the sample rate
+			for(uint8_t k = 0; k < adc_cont.cic_order; k++){
+				adc_cont.integrator[k] += sample;
+				sample = adc_cont.integrator[k];
+			}
+			if(++adc_cont.phase < adc_cont.decimation){
+				continue;
+			}
+			adc_cont.phase = 0;
+			for(uint8_t k = 0; k < adc_cont.cic_order; k++){
+				uint32_t delayed = adc_cont.comb[k];
+				adc_cont.comb[k] = sample;
+				sample -= delayed;
+			}
+			sample = (adc_cont.shift > 0) ? (sample + (1UL << (adc_cont.shift - 1))) >> adc_cont.shift : sample << -adc_cont.shift;
+		}
+		adc_cont.block[adc_cont.write][adc_cont.fill++] = sample;
+		if(adc_cont.fill == adc_cont.block_size){
+			// The previous block is lost if it was not read yet
+			if(adc_cont.ready){
+				adc_cont.overruns++;
+			}
+			adc_cont.ready = true;
+			adc_cont.write ^= 1;
+			adc_cont.fill = 0;
+			block_done = true;
+		}
+	}
+	portEXIT_CRITICAL_ISR(&adc_cont_lock);
+	if(block_done && (adc_cont.func_p != NULL)){
+		adc_cont.func_p(adc_cont.param_p);
+	}
+	return block_done;
+}
+
+/**
+ * @brief DMA frame complete: store its scans in the channel rings
+ */
+static bool IRAM_ATTR AnalogScanDone(adc_continuous_handle_t handle, const adc_continuous_evt_data_t *edata, void *user_data){
+	// The last result of the frame was converted now, the previous ones one conversion period apart each
+	int64_t frame_end = esp_timer_get_time();
+	uint32_t results = edata->size / SOC_ADC_DIGI_RESULT_BYTES;
+	bool scan_done = false;
+	portENTER_CRITICAL_ISR(&adc_cont_lock);
+	for(uint32_t i = 0; i < results; i++){
+		adc_digi_output_data_t *result = (adc_digi_output_data_t*)&edata->conv_frame_buffer[i * SOC_ADC_DIGI_RESULT_BYTES];
+		if(result->type2.channel != adc_scan.inputs[adc_scan.next]){
+			// Result lost: restart the scan at its first channel
+			adc_scan.next = 0;
+			if(result->type2.channel != adc_scan.inputs[0]){
+				continue;
+			}
+		}
+		adc_scan.ring[adc_scan.next][adc_scan.write] = result->type2.data;
+		if(++adc_scan.next == adc_scan.n_inputs){
+			adc_scan.time[adc_scan.write] = frame_end - (int64_t)(results - 1 - i) * 1000000 / adc_scan.conv_frec;
+			adc_scan.next = 0;
+			adc_scan.write = (adc_scan.write + 1) % adc_scan.slots;
+			// Ring full: the oldest scan is lost
+			if(adc_scan.write == adc_scan.read){
+				adc_scan.read = (adc_scan.read + 1) % adc_scan.slots;
+				adc_scan.overruns++;
+			}
+			scan_done = true;
+		}
+	}
+	portEXIT_CRITICAL_ISR(&adc_cont_lock);
+	if(scan_done && (adc_scan.func_p != NULL)){
+		adc_scan.func_p(adc_scan.param_p);
+	}
+	return scan_done;
+}
+
+/**
+ * @brief Player timer alarm: output the next sample
+ */
+static bool IRAM_ATTR AnalogPlayerTick(gptimer_handle_t timer, const gptimer_alarm_event_data_t *edata, void *user_data){
+	bool buffer_done = false;
+	portENTER_CRITICAL_ISR(&dac_player_lock);
+	if(dac_player.count == 0){
+		// Nothing to play: the output keeps the last sample
+		dac_player.underruns++;
+	}
+	else{
+		dac_buffer_t *buffer = &dac_player.queue[dac_player.head];
+		sdm_channel_set_pulse_density(dac, (int8_t)(buffer->samples[dac_player.pos] - 128));
+		if(++dac_player.pos == buffer->lenght){
+			dac_player.pos = 0;
+			if(dac_player.loop){
+				// Same count: the buffer goes to the end of the queue
+				dac_player.queue[(dac_player.head + dac_player.count) % DAC_PLAYER_QUEUE] = *buffer;
+			}
+			else{
+				dac_player.count--;
+			}
+			dac_player.head = (dac_player.head + 1) % DAC_PLAYER_QUEUE;
+			buffer_done = true;
+		}
+	}
+	portEXIT_CRITICAL_ISR(&dac_player_lock);
+	if(buffer_done && (dac_player.func_p != NULL)){
+		dac_player.func_p(dac_player.param_p);
+	}
+	return buffer_done;
+}
+
+/**
+ * @brief Create the DMA driver: the inputs are converted in order, repeatedly, at conv_frec conversions per second
+ */
+static void AnalogDmaInit(const adc_ch_t *inputs, uint8_t n_inputs, uint32_t conv_frec, uint32_t frame_results, adc_continuous_callback_t isr){
+	adc_continuous_handle_cfg_t handle_config = {
+		.max_store_buf_size = 2 * frame_results * SOC_ADC_DIGI_RESULT_BYTES,
+		.conv_frame_size = frame_results * SOC_ADC_DIGI_RESULT_BYTES,
+		.flags.flush_pool = true,		// Frames are used in the ISR, the driver pool is never read
+	};
+	ESP_ERROR_CHECK(adc_continuous_new_handle(&handle_config, &adc2_cont));
+	adc_digi_pattern_config_t pattern[ADC_SCAN_MAX_INPUTS];
+	for(uint8_t i = 0; i < n_inputs; i++){
+		pattern[i].atten = ADC_ATTENUATION;
+		pattern[i].channel = inputs[i];
+		pattern[i].unit = ADC_UNIT_1;
+		pattern[i].bit_width = ADC_BITWIDTH;
+	}
+	adc_continuous_config_t dig_config = {
+		.pattern_num = n_inputs,
+		.adc_pattern = pattern,
+		.sample_freq_hz = conv_frec,
+		.conv_mode = ADC_CONV_SINGLE_UNIT_1,
+		.format = ADC_DIGI_OUTPUT_FORMAT_TYPE2,
+	};
+	ESP_ERROR_CHECK(adc_continuous_config(adc2_cont, &dig_config));
+	adc_continuous_evt_cbs_t callbacks = {
+		.on_conv_done = isr,
+	};
+	ESP_ERROR_CHECK(adc_continuous_register_event_callbacks(adc2_cont, &callbacks, NULL));
+}
+
+/**
+ * @brief Release the DMA driver and the continuous mode blocks or scan rings
+ */
+static void AnalogDmaDeinit(void){
+	if(adc2_cont != NULL){
+		if(adc_dma_running){
+			adc_continuous_stop(adc2_cont);
+		}
+		adc_continuous_deinit(adc2_cont);
+		adc2_cont = NULL;
+	}
+	adc_dma_running = false;
+	adc_dma_mode = ADC_DMA_NONE;
+	free(adc_cont.block[0]);
+	free(adc_cont.block[1]);
+	memset(&adc_cont, 0, sizeof(adc_cont));
+	for(uint8_t i = 0; i < ADC_SCAN_MAX_INPUTS; i++){
+		free(adc_scan.ring[i]);
+	}
+	free(adc_scan.time);
+	memset(&adc_scan, 0, sizeof(adc_scan));
+}
+
+/**
+ * @brief Create the continuous mode driver (DMA) for one channel
+ */
+static void AnalogContinuousInit(analog_input_config_t *config){
+	AnalogDmaDeinit();
+	AnalogCalibrationInit(config->input);
+	adc_cont.channel = config->input;
+	adc_cont.block_size = (config->block_size == 0) ? ADC_CONTINUOUS_BLOCK_SIZE : config->block_size;
+	adc_cont.func_p = config->func_p;
+	adc_cont.param_p = config->param_p;
+	adc_cont.decimation = (config->oversampling == 0) ? 1 : config->oversampling;
+	adc_cont.cic_order = (config->cic_order == 0) ? 1 : config->cic_order;
+	uint8_t log2_decimation = 0;
+	while((1U << log2_decimation) < adc_cont.decimation){
+		log2_decimation++;
+	}
+	// Averaging R conversions of uncorrelated noise adds log2(R) / 2 bits
+	uint8_t output_bits = (config->output_bits == 0) ? ADC_BITWIDTH + log2_decimation / 2 : config->output_bits;
+	bool invalid = (adc_cont.decimation != (1U << log2_decimation)) || (adc_cont.decimation > ADC_OVERSAMPLING_MAX) || 
+		(adc_cont.cic_order > ADC_CIC_MAX_ORDER) || (output_bits < ADC_BITWIDTH) || (output_bits > 16);
+	ESP_ERROR_CHECK(invalid ? ESP_ERR_INVALID_ARG : ESP_OK);
+	adc_cont.shift = ADC_BITWIDTH + adc_cont.cic_order * log2_decimation - output_bits;
+	adc_cont.block[0] = malloc(adc_cont.block_size * sizeof(uint16_t));
+	adc_cont.block[1] = malloc(adc_cont.block_size * sizeof(uint16_t));
+	ESP_ERROR_CHECK(((adc_cont.block[0] == NULL) || (adc_cont.block[1] == NULL)) ? ESP_ERR_NO_MEM : ESP_OK);
+	// Frames of one block at most: the ISR rate is the conversion rate / frame results
+	uint32_t block_results = (uint32_t)adc_cont.block_size * adc_cont.decimation;
+	uint32_t frame_results = (block_results < ADC_FRAME_RESULTS) ? block_results : ADC_FRAME_RESULTS;
+	AnalogDmaInit(&config->input, 1, config->sample_frec * adc_cont.decimation, frame_results, AnalogConvDone);
+	adc_dma_mode = ADC_DMA_CONTINUOUS;
+}
 
 /*==================[external functions definition]==========================*/
 
@@ -54,65 +378,28 @@ void AnalogInputInit(analog_input_config_t *config){
 			switch(config->input){
 				case CH0:
     				adc_oneshot_config_channel(adc1_single, ADC_CHANNEL_0, &adc_config_single);
-					// create calibration curve
-					adc_cali_curve_fitting_config_t cali_config_0 = {
-						.unit_id = ADC_UNIT_1,
-						.chan = ADC_CHANNEL_0, 
-						.atten = ADC_ATTENUATION,
-						.bitwidth = ADC_BITWIDTH,
-					};
-					ESP_ERROR_CHECK(adc_cali_create_scheme_curve_fitting(&cali_config_0, &adc_calibration_single_0));
+					// create calibration curve and its table
+					AnalogCalibrationInit(CH0);
 				break;
 				case CH1:
     				adc_oneshot_config_channel(adc1_single, ADC_CHANNEL_1, &adc_config_single);
-					// create calibration curve
-					adc_cali_curve_fitting_config_t cali_config_1 = {
-						.unit_id = ADC_UNIT_1,
-						.chan = ADC_CHANNEL_1, 
-						.atten = ADC_ATTENUATION,
-						.bitwidth = ADC_BITWIDTH,
-					};
-					ESP_ERROR_CHECK(adc_cali_create_scheme_curve_fitting(&cali_config_1, &adc_calibration_single_1));
+					// create calibration curve and its table
+					AnalogCalibrationInit(CH1);
 				break;
 				case CH2:
     				adc_oneshot_config_channel(adc1_single, ADC_CHANNEL_2, &adc_config_single);
-					// create calibration curve
-					adc_cali_curve_fitting_config_t cali_config_2 = {
-						.unit_id = ADC_UNIT_1,
-						.chan = ADC_CHANNEL_2, 
-						.atten = ADC_ATTENUATION,
-						.bitwidth = ADC_BITWIDTH,
-					};
-					ESP_ERROR_CHECK(adc_cali_create_scheme_curve_fitting(&cali_config_2, &adc_calibration_single_2));
+					// create calibration curve and its table
+					AnalogCalibrationInit(CH2);
 				break;
 				case CH3:
     				adc_oneshot_config_channel(adc1_single, ADC_CHANNEL_3, &adc_config_single);
-					// create calibration curve
-					adc_cali_curve_fitting_config_t cali_config_3 = {
-						.unit_id = ADC_UNIT_1,
-						.chan = ADC_CHANNEL_3, 
-						.atten = ADC_ATTENUATION,
-						.bitwidth = ADC_BITWIDTH,
-					};
-					ESP_ERROR_CHECK(adc_cali_create_scheme_curve_fitting(&cali_config_3, &adc_calibration_single_3));
+					// create calibration curve and its table
+					AnalogCalibrationInit(CH3);
 				break;
 			}
 		break;
 		case ADC_CONTINUOUS:
-			switch(config->input){
-				case CH0:
-
-				break;
-				case CH1:
-
-				break;
-				case CH2:
-
-				break;
-				case CH3:
-
-				break;
-			}
+			AnalogContinuousInit(config);
 		break;
 	}
 }
@@ -128,32 +415,226 @@ void AnalogOutputInit(void){
 }
 
 void AnalogInputReadSingle(adc_ch_t channel, uint16_t *value){
-    switch(channel){
-		case CH0:
-			adc_oneshot_read(adc1_single, ADC_CHANNEL_0, (int*)value);
-		break;
-		case CH1:
-			adc_oneshot_read(adc1_single, ADC_CHANNEL_1, (int*)value);
-		break;
-		case CH2:
-			adc_oneshot_read(adc1_single, ADC_CHANNEL_2, (int*)value);
-		break;
-		case CH3:
-			adc_oneshot_read(adc1_single, ADC_CHANNEL_3, (int*)value);
-		break;
+	int raw = 0;
+	if((adc_lut[channel] != NULL) && (adc_oneshot_read(adc1_single, (adc_channel_t)channel, &raw) == ESP_OK)){
+		*value = adc_lut[channel][raw & (ADC_LUT_SIZE - 1)];
 	}
 }
 
-void AnalogStartContinuous(adc_ch_t channel){
+void AnalogInputConvertBlock(adc_ch_t channel, const uint16_t *raw, uint16_t *mv, uint16_t n){
+	AnalogCalibrationInit(channel);
+	const uint16_t *lut = adc_lut[channel];
+	uint16_t i = 0;
+	// Four independent loads per iteration
+	for(; i + 4 <= n; i += 4){
+		uint16_t v0 = lut[raw[i] & (ADC_LUT_SIZE - 1)];
+		uint16_t v1 = lut[raw[i + 1] & (ADC_LUT_SIZE - 1)];
+		uint16_t v2 = lut[raw[i + 2] & (ADC_LUT_SIZE - 1)];
+		uint16_t v3 = lut[raw[i + 3] & (ADC_LUT_SIZE - 1)];
+		mv[i] = v0;
+		mv[i + 1] = v1;
+		mv[i + 2] = v2;
+		mv[i + 3] = v3;
+	}
+	for(; i < n; i++){
+		mv[i] = lut[raw[i] & (ADC_LUT_SIZE - 1)];
+	}
+}
 
+void AnalogStartContinuous(adc_ch_t channel){
+	if((adc_dma_mode != ADC_DMA_CONTINUOUS) || (channel != adc_cont.channel) || adc_dma_running){
+		return;
+	}
+	adc_cont.fill = 0;
+	adc_cont.ready = false;
+	adc_cont.overruns = 0;
+	adc_cont.phase = 0;
+	memset(adc_cont.integrator, 0, sizeof(adc_cont.integrator));
+	memset(adc_cont.comb, 0, sizeof(adc_cont.comb));
+	ESP_ERROR_CHECK(adc_continuous_start(adc2_cont));
+	adc_dma_running = true;
 }
 
 void AnalogStopContinuous(adc_ch_t channel){
+	if((adc_dma_mode != ADC_DMA_CONTINUOUS) || (channel != adc_cont.channel) || !adc_dma_running){
+		return;
+	}
+	adc_continuous_stop(adc2_cont);
+	adc_dma_running = false;
+}
+
+bool AnalogInputReadContinuous(adc_ch_t channel, uint16_t *values){
+	bool new_block = false;
+	if((adc_dma_mode != ADC_DMA_CONTINUOUS) || (channel != adc_cont.channel)){
+		return false;
+	}
+	// The ISR must not complete a block (and start filling this one) while it is copied
+	portENTER_CRITICAL(&adc_cont_lock);
+	if(adc_cont.ready){
+		memcpy(values, adc_cont.block[adc_cont.write ^ 1], adc_cont.block_size * sizeof(uint16_t));
+		adc_cont.ready = false;
+		new_block = true;
+	}
+	portEXIT_CRITICAL(&adc_cont_lock);
+	return new_block;
+}
+
+uint32_t AnalogInputContinuousOverruns(adc_ch_t channel){
+	return ((adc_dma_mode == ADC_DMA_CONTINUOUS) && (channel == adc_cont.channel)) ? adc_cont.overruns : 0;
+}
 
+void AnalogScanInit(analog_scan_config_t *config){
+	AnalogDmaDeinit();
+	// ring_size + 1 slots must fit in uint16_t
+	bool invalid = (config->n_inputs == 0) || (config->n_inputs > ADC_SCAN_MAX_INPUTS) || (config->ring_size == 0) ||
+		(config->ring_size > UINT16_MAX - 1);
+	ESP_ERROR_CHECK(invalid ? ESP_ERR_INVALID_ARG : ESP_OK);
+	adc_scan.n_inputs = config->n_inputs;
+	memcpy(adc_scan.inputs, config->inputs, config->n_inputs * sizeof(adc_ch_t));
+	for(uint8_t i = 0; i < adc_scan.n_inputs; i++){
+		AnalogCalibrationInit(adc_scan.inputs[i]);
+	}
+	adc_scan.slots = config->ring_size + 1;
+	adc_scan.conv_frec = config->scan_frec * config->n_inputs;
+	adc_scan.func_p = config->func_p;
+	adc_scan.param_p = config->param_p;
+	bool no_mem = false;
+	for(uint8_t i = 0; i < adc_scan.n_inputs; i++){
+		adc_scan.ring[i] = malloc(adc_scan.slots * sizeof(uint16_t));
+		no_mem |= (adc_scan.ring[i] == NULL);
+	}
+	adc_scan.time = malloc(adc_scan.slots * sizeof(int64_t));
+	ESP_ERROR_CHECK((no_mem || (adc_scan.time == NULL)) ? ESP_ERR_NO_MEM : ESP_OK);
+	// Whole scans per DMA frame: func_p is called once per block_scans scans
+	uint32_t block_scans = (config->block_scans == 0) ? ADC_SCAN_BLOCK : config->block_scans;
+	if(block_scans * adc_scan.n_inputs > ADC_FRAME_RESULTS){
+		block_scans = ADC_FRAME_RESULTS / adc_scan.n_inputs;
+	}
+	AnalogDmaInit(adc_scan.inputs, adc_scan.n_inputs, adc_scan.conv_frec, block_scans * adc_scan.n_inputs, AnalogScanDone);
+	adc_dma_mode = ADC_DMA_SCAN;
+}
+
+void AnalogScanStart(void){
+	if((adc_dma_mode != ADC_DMA_SCAN) || adc_dma_running){
+		return;
+	}
+	adc_scan.next = 0;
+	adc_scan.write = 0;
+	adc_scan.read = 0;
+	adc_scan.overruns = 0;
+	ESP_ERROR_CHECK(adc_continuous_start(adc2_cont));
+	adc_dma_running = true;
+}
+
+void AnalogScanStop(void){
+	if((adc_dma_mode != ADC_DMA_SCAN) || !adc_dma_running){
+		return;
+	}
+	adc_continuous_stop(adc2_cont);
+	adc_dma_running = false;
+}
+
+uint16_t AnalogScanRead(uint16_t *values[], int64_t *timestamps, uint16_t max_scans){
+	uint16_t n = 0;
+	if(adc_dma_mode != ADC_DMA_SCAN){
+		return 0;
+	}
+	portENTER_CRITICAL(&adc_cont_lock);
+	uint16_t available = (adc_scan.write + adc_scan.slots - adc_scan.read) % adc_scan.slots;
+	n = (available < max_scans) ? available : max_scans;
+	for(uint16_t s = 0; s < n; s++){
+		for(uint8_t i = 0; i < adc_scan.n_inputs; i++){
+			values[i][s] = adc_scan.ring[i][adc_scan.read];
+		}
+		if(timestamps != NULL){
+			timestamps[s] = adc_scan.time[adc_scan.read];
+		}
+		adc_scan.read = (adc_scan.read + 1) % adc_scan.slots;
+	}
+	portEXIT_CRITICAL(&adc_cont_lock);
+	return n;
+}
+
+uint32_t AnalogScanOverruns(void){
+	return (adc_dma_mode == ADC_DMA_SCAN) ? adc_scan.overruns : 0;
+}
+
+void AnalogOutputPlayerInit(analog_player_config_t *config){
+	if(dac_timer != NULL){
+		if(dac_player.running){
+			gptimer_stop(dac_timer);
+		}
+		gptimer_disable(dac_timer);
+		gptimer_del_timer(dac_timer);
+		dac_timer = NULL;
+	}
+	memset(&dac_player, 0, sizeof(dac_player));
+	dac_player.loop = config->loop;
+	dac_player.func_p = config->func_p;
+	dac_player.param_p = config->param_p;
+	gptimer_config_t timer_config = {
+		.clk_src = GPTIMER_CLK_SRC_DEFAULT,
+		.direction = GPTIMER_COUNT_UP,
+		.resolution_hz = DAC_TIMER_RES_HZ,
+	};
+	ESP_ERROR_CHECK(gptimer_new_timer(&timer_config, &dac_timer));
+	gptimer_alarm_config_t alarm_config = {
+		.alarm_count = (DAC_TIMER_RES_HZ + config->sample_frec / 2) / config->sample_frec,
+		.reload_count = 0,
+		.flags.auto_reload_on_alarm = true,
+	};
+	ESP_ERROR_CHECK(gptimer_set_alarm_action(dac_timer, &alarm_config));
+	gptimer_event_callbacks_t callbacks = {
+		.on_alarm = AnalogPlayerTick,
+	};
+	ESP_ERROR_CHECK(gptimer_register_event_callbacks(dac_timer, &callbacks, NULL));
+	ESP_ERROR_CHECK(gptimer_enable(dac_timer));
+}
+
+bool AnalogOutputPlayerQueue(const uint8_t *buffer, uint16_t lenght){
+	bool queued = false;
+	if((dac_timer == NULL) || (lenght == 0)){
+		return false;
+	}
+	portENTER_CRITICAL(&dac_player_lock);
+	if(dac_player.count < DAC_PLAYER_QUEUE){
+		dac_buffer_t *slot = &dac_player.queue[(dac_player.head + dac_player.count) % DAC_PLAYER_QUEUE];
+		slot->samples = buffer;
+		slot->lenght = lenght;
+		dac_player.count++;
+		queued = true;
+	}
+	portEXIT_CRITICAL(&dac_player_lock);
+	return queued;
+}
+
+void AnalogOutputPlayerStart(void){
+	if((dac_timer == NULL) || dac_player.running){
+		return;
+	}
+	ESP_ERROR_CHECK(gptimer_start(dac_timer));
+	dac_player.running = true;
 }
 
-void AnalogInputReadContinuous(adc_ch_t channel, uint16_t *values){
+void AnalogOutputPlayerStop(void){
+	if((dac_timer == NULL) || !dac_player.running){
+		return;
+	}
+	gptimer_stop(dac_timer);
+	dac_player.running = false;
+}
+
+void AnalogOutputPlayerFlush(void){
+	portENTER_CRITICAL(&dac_player_lock);
+	dac_player.head = 0;
+	dac_player.count = 0;
+	dac_player.pos = 0;
+	dac_player.underruns = 0;
+	portEXIT_CRITICAL(&dac_player_lock);
+}
 
+uint32_t AnalogOutputPlayerUnderruns(void){
+	return dac_player.underruns;
 }
 
 void AnalogOutputWrite(uint8_t value){
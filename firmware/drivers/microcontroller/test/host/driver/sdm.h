@@ -0,0 +1,34 @@
+#ifndef HOST_SDM_H
+#define HOST_SDM_H
+/** \brief Host stand-in of the sigma-delta modulation driver (the DAC output)
+ **/
+
+/*==================[inclusions]=============================================*/
+#include "host_idf.h"
+/*==================[typedef]================================================*/
+typedef struct host_sdm *sdm_channel_handle_t;
+
+typedef enum {
+	SDM_CLK_SRC_DEFAULT
+} sdm_clock_source_t;
+
+typedef struct {
+	int gpio_num;
+	sdm_clock_source_t clk_src;
+	uint32_t sample_rate_hz;
+	struct {
+		uint32_t invert_out: 1;
+		uint32_t io_loop_back: 1;
+	} flags;
+} sdm_config_t;
+/*==================[external data declaration]==============================*/
+extern int8_t host_sdm_density;		/*!< Last pulse density written */
+extern uint32_t host_sdm_writes;	/*!< Pulse density writes */
+/*==================[external functions declaration]=========================*/
+esp_err_t sdm_new_channel(const sdm_config_t *config, sdm_channel_handle_t *ret_chan);
+esp_err_t sdm_channel_enable(sdm_channel_handle_t chan);
+esp_err_t sdm_channel_set_pulse_density(sdm_channel_handle_t chan, int8_t density);
+
+#endif /* HOST_SDM_H */
+
+/*==================[end of file]============================================*/
@@ -0,0 +1,27 @@
+#ifndef HOST_ADC_CALI_SCHEME_H
+#define HOST_ADC_CALI_SCHEME_H
+/** \brief Host stand-in of the ADC calibration (curve fitting scheme)
+ *
+ * The curve is a model: slightly non-linear, with a different offset per channel.
+ **/
+
+/*==================[inclusions]=============================================*/
+#include "hal/adc_types.h"
+/*==================[typedef]================================================*/
+typedef struct host_cali *adc_cali_handle_t;
+
+typedef struct {
+	adc_unit_t unit_id;
+	adc_channel_t chan;
+	adc_atten_t atten;
+	adc_bitwidth_t bitwidth;
+} adc_cali_curve_fitting_config_t;
+/*==================[external data declaration]==============================*/
+extern uint32_t host_cali_calls;	/*!< adc_cali_raw_to_voltage() calls */
+/*==================[external functions declaration]=========================*/
+esp_err_t adc_cali_create_scheme_curve_fitting(const adc_cali_curve_fitting_config_t *config, adc_cali_handle_t *ret_handle);
+esp_err_t adc_cali_raw_to_voltage(adc_cali_handle_t handle, int raw, int *voltage);
+
+#endif /* HOST_ADC_CALI_SCHEME_H */
+
+/*==================[end of file]============================================*/
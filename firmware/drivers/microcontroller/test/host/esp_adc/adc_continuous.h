@@ -0,0 +1,78 @@
+#ifndef HOST_ADC_CONTINUOUS_H
+#define HOST_ADC_CONTINUOUS_H
+/** \brief Host stand-in of the ADC continuous (DMA) driver
+ *
+ * One handle at a time. The tests deliver DMA frames with HostAdcFrame(), which calls the 
+ * conversion done callback as the driver ISR does. The configuration is kept in the host_adc_* hooks.
+ **/
+
+/*==================[inclusions]=============================================*/
+#include "hal/adc_types.h"
+/*==================[typedef]================================================*/
+typedef struct host_continuous *adc_continuous_handle_t;
+
+typedef struct {
+	uint32_t max_store_buf_size;
+	uint32_t conv_frame_size;
+	struct {
+		uint32_t flush_pool: 1;
+	} flags;
+} adc_continuous_handle_cfg_t;
+
+typedef struct {
+	uint8_t atten;
+	uint8_t channel;
+	uint8_t unit;
+	uint8_t bit_width;
+} adc_digi_pattern_config_t;
+
+typedef struct {
+	uint32_t pattern_num;
+	adc_digi_pattern_config_t *adc_pattern;
+	uint32_t sample_freq_hz;
+	adc_digi_convert_mode_t conv_mode;
+	adc_digi_output_format_t format;
+} adc_continuous_config_t;
+
+typedef struct {
+	uint8_t *conv_frame_buffer;
+	uint32_t size;
+} adc_continuous_evt_data_t;
+
+typedef bool (*adc_continuous_callback_t)(adc_continuous_handle_t handle, const adc_continuous_evt_data_t *edata, void *user_data);
+
+typedef struct {
+	adc_continuous_callback_t on_conv_done;
+	adc_continuous_callback_t on_pool_ovf;
+} adc_continuous_evt_cbs_t;
+/*==================[external data declaration]==============================*/
+extern adc_continuous_handle_cfg_t host_adc_handle_config;			/*!< Last handle configuration */
+extern adc_continuous_config_t host_adc_config;						/*!< Last conversion configuration */
+extern adc_digi_pattern_config_t host_adc_pattern[SOC_ADC_PATT_LEN_MAX];	/*!< Its conversion pattern */
+extern int host_adc_handles;										/*!< Handles not released */
+extern bool host_adc_running;										/*!< Conversions started */
+/*==================[external functions declaration]=========================*/
+esp_err_t adc_continuous_new_handle(const adc_continuous_handle_cfg_t *hdl_config, adc_continuous_handle_t *ret_handle);
+esp_err_t adc_continuous_config(adc_continuous_handle_t handle, const adc_continuous_config_t *config);
+esp_err_t adc_continuous_register_event_callbacks(adc_continuous_handle_t handle, const adc_continuous_evt_cbs_t *cbs, void *user_data);
+esp_err_t adc_continuous_start(adc_continuous_handle_t handle);
+esp_err_t adc_continuous_stop(adc_continuous_handle_t handle);
+esp_err_t adc_continuous_deinit(adc_continuous_handle_t handle);
+
+/**
+ * @brief Conversion result of a channel, as written by the DMA
+ */
+uint32_t HostAdcResult(uint8_t channel, uint16_t data);
+
+/**
+ * @brief Deliver a DMA frame: call the conversion done callback (conversions must be running)
+ *
+ * @param results Conversion results (HostAdcResult())
+ * @param n Number of results
+ * @return Value returned by the callback
+ */
+bool HostAdcFrame(const uint32_t *results, uint32_t n);
+
+#endif /* HOST_ADC_CONTINUOUS_H */
+
+/*==================[end of file]============================================*/
@@ -0,0 +1,13 @@
+#ifndef HOST_ESP_TIMER_H
+#define HOST_ESP_TIMER_H
+/** \brief Host stand-in of esp_timer: the time is set by the tests (host_time_us)
+ **/
+
+/*==================[inclusions]=============================================*/
+#include "host_idf.h"
+/*==================[external functions declaration]=========================*/
+int64_t esp_timer_get_time(void);
+
+#endif /* HOST_ESP_TIMER_H */
+
+/*==================[end of file]============================================*/
@@ -0,0 +1,28 @@
+#ifndef HOST_FREERTOS_H
+#define HOST_FREERTOS_H
+/** \brief Host stand-in of FreeRTOS: critical sections only (spinlocks of the port)
+ **/
+
+/*==================[inclusions]=============================================*/
+#include "host_idf.h"
+/*==================[macros]=================================================*/
+#define portMUX_INITIALIZER_UNLOCKED	0
+#define portENTER_CRITICAL(mux)			HostEnterCritical(mux)
+#define portEXIT_CRITICAL(mux)			HostExitCritical(mux)
+#define portENTER_CRITICAL_ISR(mux)		HostEnterCritical(mux)
+#define portEXIT_CRITICAL_ISR(mux)		HostExitCritical(mux)
+
+#define pdTRUE			1
+#define pdFALSE			0
+#define portMAX_DELAY	0xFFFFFFFF
+/*==================[typedef]================================================*/
+typedef int portMUX_TYPE;
+typedef int BaseType_t;
+typedef uint32_t TickType_t;
+/*==================[external functions declaration]=========================*/
+void HostEnterCritical(portMUX_TYPE *mux);
+void HostExitCritical(portMUX_TYPE *mux);
+
+#endif /* HOST_FREERTOS_H */
+
+/*==================[end of file]============================================*/
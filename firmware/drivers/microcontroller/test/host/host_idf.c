@@ -0,0 +1,226 @@
+/**
+ * @file host_idf.c
+ * @author Albano Peñalva (albano.penalva@uner.edu.ar)
+ * @brief Host stand-in of the ESP-IDF drivers used by the microcontroller drivers
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+/*==================[inclusions]=============================================*/
+#include <string.h>
+#include "host_idf.h"
+#include "freertos/FreeRTOS.h"
+#include "driver/gptimer.h"
+#include "driver/sdm.h"
+#include "esp_adc/adc_cali_scheme.h"
+#include "esp_adc/adc_oneshot.h"
+#include "esp_adc/adc_continuous.h"
+#include "esp_timer.h"
+/*==================[macros and definitions]=================================*/
+#define HOST_HANDLE(type, n)	((type)(uintptr_t)(n))
+/*==================[internal data declaration]==============================*/
+static adc_continuous_evt_cbs_t adc_callbacks;
+static void *adc_user_data;
+static gptimer_alarm_cb_t timer_callback;
+static void *timer_user_data;
+/*==================[external data definition]===============================*/
+int host_critical_depth = 0;
+int64_t host_time_us = 0;
+adc_continuous_handle_cfg_t host_adc_handle_config;
+adc_continuous_config_t host_adc_config;
+adc_digi_pattern_config_t host_adc_pattern[SOC_ADC_PATT_LEN_MAX];
+int host_adc_handles = 0;
+bool host_adc_running = false;
+int host_oneshot_value[ADC_CHANNEL_6 + 1];
+uint32_t host_cali_calls = 0;
+bool host_timer_running = false;
+uint64_t host_timer_alarm = 0;
+int8_t host_sdm_density = 0;
+uint32_t host_sdm_writes = 0;
+/*==================[external functions definition]==========================*/
+void HostEnterCritical(portMUX_TYPE *mux){
+	// Critical sections of the drivers are never nested, and callbacks run outside them
+	assert(host_critical_depth == 0);
+	host_critical_depth++;
+}
+
+void HostExitCritical(portMUX_TYPE *mux){
+	assert(host_critical_depth == 1);
+	host_critical_depth--;
+}
+
+int64_t esp_timer_get_time(void){
+	return host_time_us;
+}
+
+esp_err_t adc_continuous_new_handle(const adc_continuous_handle_cfg_t *hdl_config, adc_continuous_handle_t *ret_handle){
+	assert(host_adc_handles == 0);
+	host_adc_handles++;
+	host_adc_handle_config = *hdl_config;
+	*ret_handle = HOST_HANDLE(adc_continuous_handle_t, 1);
+	return ESP_OK;
+}
+
+esp_err_t adc_continuous_config(adc_continuous_handle_t handle, const adc_continuous_config_t *config){
+	assert(!host_adc_running);
+	if((config->sample_freq_hz < SOC_ADC_SAMPLE_FREQ_THRES_LOW) || (config->sample_freq_hz > SOC_ADC_SAMPLE_FREQ_THRES_HIGH) ||
+		(config->pattern_num == 0) || (config->pattern_num > SOC_ADC_PATT_LEN_MAX)){
+		return ESP_ERR_INVALID_ARG;
+	}
+	host_adc_config = *config;
+	memcpy(host_adc_pattern, config->adc_pattern, config->pattern_num * sizeof(adc_digi_pattern_config_t));
+	host_adc_config.adc_pattern = host_adc_pattern;
+	return ESP_OK;
+}
+
+esp_err_t adc_continuous_register_event_callbacks(adc_continuous_handle_t handle, const adc_continuous_evt_cbs_t *cbs, void *user_data){
+	adc_callbacks = *cbs;
+	adc_user_data = user_data;
+	return ESP_OK;
+}
+
+esp_err_t adc_continuous_start(adc_continuous_handle_t handle){
+	if(host_adc_running){
+		return ESP_ERR_INVALID_STATE;
+	}
+	host_adc_running = true;
+	return ESP_OK;
+}
+
+esp_err_t adc_continuous_stop(adc_continuous_handle_t handle){
+	if(!host_adc_running){
+		return ESP_ERR_INVALID_STATE;
+	}
+	host_adc_running = false;
+	return ESP_OK;
+}
+
+esp_err_t adc_continuous_deinit(adc_continuous_handle_t handle){
+	assert(!host_adc_running && (host_adc_handles == 1));
+	host_adc_handles--;
+	memset(&adc_callbacks, 0, sizeof(adc_callbacks));
+	return ESP_OK;
+}
+
+uint32_t HostAdcResult(uint8_t channel, uint16_t data){
+	adc_digi_output_data_t result = {0};
+	result.type2.channel = channel;
+	result.type2.data = data;
+	return result.val;
+}
+
+bool HostAdcFrame(const uint32_t *results, uint32_t n){
+	adc_continuous_evt_data_t edata = {
+		.conv_frame_buffer = (uint8_t *)results,
+		.size = n * SOC_ADC_DIGI_RESULT_BYTES,
+	};
+	assert(host_adc_running && (adc_callbacks.on_conv_done != NULL));
+	return adc_callbacks.on_conv_done(HOST_HANDLE(adc_continuous_handle_t, 1), &edata, adc_user_data);
+}
+
+esp_err_t adc_cali_create_scheme_curve_fitting(const adc_cali_curve_fitting_config_t *config, adc_cali_handle_t *ret_handle){
+	*ret_handle = HOST_HANDLE(adc_cali_handle_t, config->chan + 1);
+	return ESP_OK;
+}
+
+esp_err_t adc_cali_raw_to_voltage(adc_cali_handle_t handle, int raw, int *voltage){
+	// Model curve: slightly non-linear, 3 mV more offset per channel
+	int channel = (int)(uintptr_t)handle - 1;
+	double x = raw / 4095.0;
+	*voltage = (int)(0.5 + 10 + channel * 3 + 3100 * x + 120 * x * x - 60 * x * x * x);
+	host_cali_calls++;
+	return ESP_OK;
+}
+
+esp_err_t adc_oneshot_new_unit(const adc_oneshot_unit_init_cfg_t *init_config, adc_oneshot_unit_handle_t *ret_unit){
+	*ret_unit = HOST_HANDLE(adc_oneshot_unit_handle_t, 2);
+	return ESP_OK;
+}
+
+esp_err_t adc_oneshot_config_channel(adc_oneshot_unit_handle_t handle, adc_channel_t channel, const adc_oneshot_chan_cfg_t *config){
+	return ESP_OK;
+}
+
+esp_err_t adc_oneshot_read(adc_oneshot_unit_handle_t handle, adc_channel_t chan, int *out_raw){
+	// The unit is taken by the continuous conversions
+	if(host_adc_running){
+		return ESP_ERR_INVALID_STATE;
+	}
+	*out_raw = host_oneshot_value[chan];
+	return ESP_OK;
+}
+
+esp_err_t gptimer_new_timer(const gptimer_config_t *config, gptimer_handle_t *ret_timer){
+	*ret_timer = HOST_HANDLE(gptimer_handle_t, 3);
+	return ESP_OK;
+}
+
+esp_err_t gptimer_del_timer(gptimer_handle_t timer){
+	assert(!host_timer_running);
+	timer_callback = NULL;
+	return ESP_OK;
+}
+
+esp_err_t gptimer_set_alarm_action(gptimer_handle_t timer, const gptimer_alarm_config_t *config){
+	host_timer_alarm = config->alarm_count;
+	return ESP_OK;
+}
+
+esp_err_t gptimer_register_event_callbacks(gptimer_handle_t timer, const gptimer_event_callbacks_t *cbs, void *user_data){
+	timer_callback = cbs->on_alarm;
+	timer_user_data = user_data;
+	return ESP_OK;
+}
+
+esp_err_t gptimer_enable(gptimer_handle_t timer){
+	return ESP_OK;
+}
+
+esp_err_t gptimer_disable(gptimer_handle_t timer){
+	return ESP_OK;
+}
+
+esp_err_t gptimer_start(gptimer_handle_t timer){
+	if(host_timer_running){
+		return ESP_ERR_INVALID_STATE;
+	}
+	host_timer_running = true;
+	return ESP_OK;
+}
+
+esp_err_t gptimer_stop(gptimer_handle_t timer){
+	if(!host_timer_running){
+		return ESP_ERR_INVALID_STATE;
+	}
+	host_timer_running = false;
+	return ESP_OK;
+}
+
+bool HostTimerAlarm(void){
+	gptimer_alarm_event_data_t edata = {
+		.count_value = host_timer_alarm,
+		.alarm_value = host_timer_alarm,
+	};
+	assert(host_timer_running && (timer_callback != NULL));
+	return timer_callback(HOST_HANDLE(gptimer_handle_t, 3), &edata, timer_user_data);
+}
+
+esp_err_t sdm_new_channel(const sdm_config_t *config, sdm_channel_handle_t *ret_chan){
+	*ret_chan = HOST_HANDLE(sdm_channel_handle_t, 4);
+	return ESP_OK;
+}
+
+esp_err_t sdm_channel_enable(sdm_channel_handle_t chan){
+	return ESP_OK;
+}
+
+esp_err_t sdm_channel_set_pulse_density(sdm_channel_handle_t chan, int8_t density){
+	host_sdm_density = density;
+	host_sdm_writes++;
+	return ESP_OK;
+}
+
+/*==================[end of file]============================================*/
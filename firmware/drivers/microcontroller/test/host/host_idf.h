@@ -0,0 +1,55 @@
+#ifndef HOST_IDF_H
+#define HOST_IDF_H
+/** \brief Host stand-in of the ESP-IDF definitions used by the microcontroller drivers
+ *
+ * The headers of this directory replace the ESP-IDF ones (same include paths), so a driver
+ * source can be built and tested on the host. The peripherals are models: the tests feed them
+ * (DMA frames, timer alarms) and read what the driver did through the host_* hooks.
+ *
+ * @author Albano Peñalva
+ *
+ * @section changelog
+ *
+ * |   Date	    | Description                                    						|
+ * |:----------:|:----------------------------------------------------------------------|
+ * | 17/10/2026 | Document creation		                         						|
+ *
+ **/
+
+/*==================[inclusions]=============================================*/
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <assert.h>
+/*==================[macros]=================================================*/
+#define ESP_OK						0
+#define ESP_FAIL					-1
+#define ESP_ERR_NO_MEM				0x101
+#define ESP_ERR_INVALID_ARG			0x102
+#define ESP_ERR_INVALID_STATE		0x103
+#define ESP_ERROR_CHECK(x)			do { esp_err_t err_rc = (x); assert(err_rc == ESP_OK); (void)err_rc; } while(0)
+
+#define IRAM_ATTR
+
+#define SOC_ADC_DIGI_RESULT_BYTES		4
+#define SOC_ADC_DIGI_MAX_BITWIDTH		12
+#define SOC_ADC_PATT_LEN_MAX			8
+#define SOC_ADC_SAMPLE_FREQ_THRES_HIGH	83333
+#define SOC_ADC_SAMPLE_FREQ_THRES_LOW	611
+/*==================[typedef]================================================*/
+typedef int esp_err_t;
+/*==================[external data declaration]==============================*/
+/**
+ * @brief Critical section nesting: the stand-in fails on a nested or unbalanced section
+ */
+extern int host_critical_depth;
+
+/**
+ * @brief Time returned by esp_timer_get_time() (us)
+ */
+extern int64_t host_time_us;
+/*==================[external functions declaration]=========================*/
+
+#endif /* HOST_IDF_H */
+
+/*==================[end of file]============================================*/
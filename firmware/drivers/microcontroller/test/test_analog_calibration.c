@@ -0,0 +1,161 @@
+/**
+ * @file test_analog_calibration.c
+ * @author Albano Peñalva (albano.penalva@uner.edu.ar)
+ * @brief Host tests and benchmark of the analog input calibration tables
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+/*==================[inclusions]=============================================*/
+#include <stdio.h>
+#include <string.h>
+#include <assert.h>
+#include <time.h>
+#include "esp_adc/adc_cali_scheme.h"
+#include "esp_adc/adc_oneshot.h"
+#include "analog_io_mcu.h"
+/*==================[macros and definitions]=================================*/
+#define BLOCK			256
+#define REPEAT			200000
+#define TERMS			5
+/**
+ * @brief Curve fitting context, as in the IDF scheme: linear fit plus a polynomial error
+ */
+typedef struct {
+	uint32_t coeff_a;					/*!< Linear fit slope (x 1000000) */
+	uint32_t coeff_b;					/*!< Linear fit offset */
+	uint8_t term_num;					/*!< Error polynomial terms */
+	const uint64_t (*coeff)[TERMS][2];	/*!< Error coefficients (numerator, denominator) */
+	const int32_t (*sign)[TERMS];		/*!< Error coefficient signs */
+} cali_model_t;
+/*==================[internal data definition]===============================*/
+static const uint64_t error_coeff[TERMS][2] = {{225966470500043, 1e15}, {7265418501948, 1e16}, {109410402681, 1e16}, {7, 1e8}, {1, 1e10}};
+static const int32_t error_sign[TERMS] = {-1, -1, 1, -1, 1};
+static const cali_model_t cali_model = {802156, 0, TERMS, &error_coeff, &error_sign};
+/*==================[internal functions definition]==========================*/
+/**
+ * @brief Error term of the IDF curve fitting: 64 bit products and divisions per term
+ */
+static int32_t ModelReadingError(uint64_t v, const cali_model_t *ctx){
+	if((v == 0) || (ctx->term_num == 0)){
+		return 0;
+	}
+	uint64_t variable = 1;
+	int32_t error = (int32_t)((*ctx->coeff)[0][0] / (*ctx->coeff)[0][1]) * (*ctx->sign)[0];
+	for(uint8_t i = 1; i < ctx->term_num; i++){
+		variable *= v;
+		uint64_t term = variable * (*ctx->coeff)[i][0] / (*ctx->coeff)[i][1];
+		error += (int32_t)term * (*ctx->sign)[i];
+	}
+	return error;
+}
+
+/**
+ * @brief Per sample conversion through the IDF curve fitting path
+ */
+static __attribute__((noinline)) esp_err_t ModelRawToVoltage(const cali_model_t *ctx, int raw, int *voltage){
+	if((ctx == NULL) || (voltage == NULL) || (raw < 0) || (raw >= 4096)){
+		return ESP_ERR_INVALID_ARG;
+	}
+	uint64_t v = (uint64_t)raw * ctx->coeff_a / 1000000 + ctx->coeff_b;
+	*voltage = (int32_t)v - ModelReadingError(v, ctx);
+	return ESP_OK;
+}
+
+static double Seconds(void){
+	struct timespec t;
+	clock_gettime(CLOCK_MONOTONIC, &t);
+	return t.tv_sec + t.tv_nsec * 1e-9;
+}
+
+static void TestTables(void){
+	uint16_t raw[BLOCK], mv[BLOCK];
+	// The table is built once per channel, on its first initialization
+	analog_input_config_t config = {
+		.input = CH1,
+		.mode = ADC_SINGLE,
+	};
+	uint32_t calls = host_cali_calls;
+	AnalogInputInit(&config);
+	assert(host_cali_calls - calls == 4096);
+	AnalogInputInit(&config);
+	assert(host_cali_calls - calls == 4096);
+	// Every raw value against the calibration, for each channel (different curves)
+	for(adc_ch_t channel = CH0; channel <= CH3; channel++){
+		for(uint16_t start = 0; start < 4096; start += BLOCK){
+			for(uint16_t i = 0; i < BLOCK; i++){
+				raw[i] = start + i;
+			}
+			AnalogInputConvertBlock(channel, raw, mv, BLOCK);
+			for(uint16_t i = 0; i < BLOCK; i++){
+				adc_cali_handle_t handle;
+				adc_cali_curve_fitting_config_t cali_config = {.chan = (adc_channel_t)channel};
+				int voltage;
+				adc_cali_create_scheme_curve_fitting(&cali_config, &handle);
+				adc_cali_raw_to_voltage(handle, raw[i], &voltage);
+				assert(mv[i] == voltage);
+			}
+		}
+	}
+	// In place, and a lenght that is not a multiple of 4
+	for(uint16_t i = 0; i < 7; i++){
+		raw[i] = 4095 - i;
+	}
+	memcpy(mv, raw, sizeof(mv));
+	AnalogInputConvertBlock(CH2, mv, mv, 7);
+	for(uint16_t i = 0; i < 7; i++){
+		uint16_t expected;
+		AnalogInputConvertBlock(CH2, &raw[i], &expected, 1);
+		assert(mv[i] == expected);
+	}
+	// Single reads return mV
+	host_oneshot_value[CH1] = 4095;
+	uint16_t value = 0;
+	AnalogInputReadSingle(CH1, &value);
+	raw[0] = 4095;
+	AnalogInputConvertBlock(CH1, raw, mv, 1);
+	assert(value == mv[0]);
+	printf("TestTables passed: raw 4095 on CH1 is %d mV\n", value);
+}
+
+static void BenchmarkCalibration(void){
+	uint16_t raw[BLOCK], mv[BLOCK];
+	volatile uint32_t sink = 0;
+	// The context is run time data on the target: no division by a known constant
+	const cali_model_t *volatile model = &cali_model;
+	for(uint16_t i = 0; i < BLOCK; i++){
+		raw[i] = (i * 2654435761u >> 20) & 0xFFF;
+	}
+	double start = Seconds();
+	for(uint32_t r = 0; r < REPEAT; r++){
+		for(uint16_t i = 0; i < BLOCK; i++){
+			int voltage;
+			ModelRawToVoltage(model, raw[i], &voltage);
+			mv[i] = voltage;
+		}
+		sink += mv[r & (BLOCK - 1)];
+	}
+	double per_sample = Seconds() - start;
+	start = Seconds();
+	for(uint32_t r = 0; r < REPEAT; r++){
+		raw[0] = r & 0xFFF;
+		AnalogInputConvertBlock(CH1, raw, mv, BLOCK);
+		sink += mv[r & (BLOCK - 1)];
+	}
+	double table = Seconds() - start;
+	printf("BenchmarkCalibration: blocks of %d, curve fitting per sample %.2f ns/sample, "
+		"AnalogInputConvertBlock %.2f ns/sample (x%.1f)\n", BLOCK, per_sample / REPEAT / BLOCK * 1e9,
+		table / REPEAT / BLOCK * 1e9, per_sample / table);
+}
+
+/*==================[external functions definition]==========================*/
+int main(void){
+	TestTables();
+	BenchmarkCalibration();
+	return 0;
+}
+
+/*==================[end of file]============================================*/
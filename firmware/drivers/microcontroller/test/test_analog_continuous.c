@@ -0,0 +1,169 @@
+/**
+ * @file test_analog_continuous.c
+ * @author Albano Peñalva (albano.penalva@uner.edu.ar)
+ * @brief Host tests of the analog input continuous mode (DMA blocks)
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+/*==================[inclusions]=============================================*/
+#include <stdio.h>
+#include <string.h>
+#include <assert.h>
+#include "esp_adc/adc_continuous.h"
+#include "analog_io_mcu.h"
+/*==================[macros and definitions]=================================*/
+#define FRAME_RESULTS	37		/* Results per DMA frame, not a divisor of the block size */
+#define BLOCK			100
+/*==================[internal data definition]===============================*/
+static int callbacks = 0;
+/*==================[internal functions definition]==========================*/
+/**
+ * @brief Block complete callback: called from the ISR, outside its critical section
+ */
+static void BlockDone(void *param){
+	assert(host_critical_depth == 0);
+	callbacks++;
+	(*(int *)param)++;
+}
+
+/**
+ * @brief Deliver n conversions of a channel with consecutive values, one frame each
+ */
+static void Conversions(adc_ch_t channel, uint16_t *value, uint32_t n){
+	for(uint32_t i = 0; i < n; i++){
+		uint32_t result = HostAdcResult(channel, (*value)++ & 0xFFF);
+		HostAdcFrame(&result, 1);
+	}
+}
+
+static void TestConfiguration(void){
+	int param = 0;
+	analog_input_config_t config = {
+		.input = CH2,
+		.mode = ADC_CONTINUOUS,
+		.func_p = BlockDone,
+		.param_p = &param,
+		.sample_frec = 20000,
+		.block_size = BLOCK,
+	};
+	AnalogInputInit(&config);
+	assert((host_adc_config.pattern_num == 1) && (host_adc_pattern[0].channel == CH2));
+	assert(host_adc_config.sample_freq_hz == 20000);
+	// One block per frame at most, frames are consumed in the ISR
+	assert(host_adc_handle_config.conv_frame_size == BLOCK * SOC_ADC_DIGI_RESULT_BYTES);
+	assert(host_adc_handle_config.flags.flush_pool);
+	uint16_t values[BLOCK];
+	assert(!AnalogInputReadContinuous(CH2, values));
+	AnalogStartContinuous(CH2);
+	assert(host_adc_running);
+	AnalogStopContinuous(CH2);
+	assert(!host_adc_running);
+	// A new initialization replaces the channel, default block size
+	analog_input_config_t other = {
+		.input = CH1,
+		.mode = ADC_CONTINUOUS,
+		.sample_frec = 50000,
+	};
+	AnalogInputInit(&other);
+	assert((host_adc_handles == 1) && !host_adc_running && (host_adc_pattern[0].channel == CH1));
+	assert(host_adc_handle_config.conv_frame_size == 128 * SOC_ADC_DIGI_RESULT_BYTES);
+	AnalogStartContinuous(CH1);
+	uint16_t value = 0;
+	uint16_t block[ADC_CONTINUOUS_BLOCK_SIZE];
+	Conversions(CH1, &value, ADC_CONTINUOUS_BLOCK_SIZE);
+	assert(AnalogInputReadContinuous(CH1, block) && (block[0] == 0) && (block[ADC_CONTINUOUS_BLOCK_SIZE - 1] == ADC_CONTINUOUS_BLOCK_SIZE - 1));
+	assert(!AnalogInputReadContinuous(CH2, block));
+	AnalogStopContinuous(CH1);
+	printf("TestConfiguration passed\n");
+}
+
+static void TestBlocks(void){
+	int param = 0;
+	analog_input_config_t config = {
+		.input = CH2,
+		.mode = ADC_CONTINUOUS,
+		.func_p = BlockDone,
+		.param_p = &param,
+		.sample_frec = 20000,
+		.block_size = BLOCK,
+	};
+	AnalogInputInit(&config);
+	AnalogStartContinuous(CH2);
+	callbacks = 0;
+	// Frames of 37 results of the channel, with results of another channel every 10: blocks
+	// are sample-exact across frame boundaries and only hold the channel
+	uint32_t frame[2 * FRAME_RESULTS];
+	uint16_t values[BLOCK];
+	uint16_t value = 0, expected = 0;
+	for(uint8_t f = 0; f < 10; f++){
+		uint32_t n = 0;
+		for(uint8_t i = 0; i < FRAME_RESULTS; i++){
+			frame[n++] = HostAdcResult(CH2, value++);
+			if(i % 10 == 0){
+				frame[n++] = HostAdcResult(CH3, 4095);
+			}
+		}
+		bool block_done = HostAdcFrame(frame, n);
+		assert(block_done == (value / BLOCK != (value - FRAME_RESULTS) / BLOCK));
+		if(AnalogInputReadContinuous(CH2, values)){
+			for(uint16_t i = 0; i < BLOCK; i++){
+				assert(values[i] == expected + i);
+			}
+			expected += BLOCK;
+		}
+	}
+	// 370 samples: 3 blocks, one callback each, all read in time
+	assert((expected == 3 * BLOCK) && (callbacks == 3) && (param == 3));
+	assert(AnalogInputContinuousOverruns(CH2) == 0);
+	assert(!AnalogInputReadContinuous(CH2, values));
+	assert(!AnalogInputReadContinuous(CH1, values));
+	AnalogStopContinuous(CH2);
+	printf("TestBlocks passed: 370 samples in frames of %d, %d blocks, %d callbacks\n", FRAME_RESULTS, expected / BLOCK, callbacks);
+}
+
+static void TestOverruns(void){
+	analog_input_config_t config = {
+		.input = CH2,
+		.mode = ADC_CONTINUOUS,
+		.sample_frec = 20000,
+		.block_size = BLOCK,
+	};
+	AnalogInputInit(&config);
+	AnalogStartContinuous(CH2);
+	uint16_t values[BLOCK];
+	uint16_t value = 0;
+	// Late reader: 3 blocks complete without reads, the first two are lost and the newest one is read
+	Conversions(CH2, &value, 3 * BLOCK + 30);
+	assert(AnalogInputContinuousOverruns(CH2) == 2);
+	assert(AnalogInputReadContinuous(CH2, values) && (values[0] == 2 * BLOCK) && (values[BLOCK - 1] == 3 * BLOCK - 1));
+	assert(!AnalogInputReadContinuous(CH2, values));
+	// The partial block goes on
+	Conversions(CH2, &value, BLOCK - 30);
+	assert(AnalogInputReadContinuous(CH2, values) && (values[0] == 3 * BLOCK));
+	assert(AnalogInputContinuousOverruns(CH2) == 2);
+	// A restart discards the partial and unread blocks and clears the overruns
+	Conversions(CH2, &value, BLOCK + 50);
+	AnalogStopContinuous(CH2);
+	AnalogStartContinuous(CH2);
+	assert(!AnalogInputReadContinuous(CH2, values));
+	assert(AnalogInputContinuousOverruns(CH2) == 0);
+	value = 0;
+	Conversions(CH2, &value, BLOCK);
+	assert(AnalogInputReadContinuous(CH2, values) && (values[0] == 0) && (values[BLOCK - 1] == BLOCK - 1));
+	AnalogStopContinuous(CH2);
+	printf("TestOverruns passed\n");
+}
+
+/*==================[external functions definition]==========================*/
+int main(void){
+	TestConfiguration();
+	TestBlocks();
+	TestOverruns();
+	return 0;
+}
+
+/*==================[end of file]============================================*/
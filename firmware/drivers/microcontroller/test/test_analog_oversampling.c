@@ -0,0 +1,163 @@
+/**
+ * @file test_analog_oversampling.c
+ * @author Albano Peñalva (albano.penalva@uner.edu.ar)
+ * @brief Host tests of the continuous mode oversampling (CIC decimation in the ADC ISR)
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+/*==================[inclusions]=============================================*/
+#include <stdio.h>
+#include <math.h>
+#include <assert.h>
+#include "esp_adc/adc_continuous.h"
+#include "analog_io_mcu.h"
+/*==================[macros and definitions]=================================*/
+#define SAMPLE_FREC		1000
+#define BLOCK			256
+#define BLOCKS			8			/* Blocks measured, after one block of settling */
+#define INPUT_DC		1234.37		/* Input (12 bit LSB), between two codes */
+/**
+ * @brief Measured output of the model
+ */
+typedef struct {
+	double mean;		/*!< Mean (12 bit LSB) */
+	double noise;		/*!< Standard deviation (12 bit LSB) */
+	double extra_bits;	/*!< log2(input noise / output noise) */
+} oversampling_result_t;
+/*==================[internal functions definition]==========================*/
+/**
+ * @brief Deterministic gaussian noise (Box-Muller on a LCG)
+ */
+static double Gauss(uint32_t *seed){
+	*seed = *seed * 1664525 + 1013904223;
+	double u = ((*seed >> 8) + 1.0) / 16777218.0;
+	*seed = *seed * 1664525 + 1013904223;
+	double v = ((*seed >> 8) + 1.0) / 16777218.0;
+	return sqrt(-2 * log(u)) * cos(2 * M_PI * v);
+}
+
+/**
+ * @brief Model of the ADC: conversions of DC plus gaussian noise, quantized to 12 bits, through the driver ISR
+ *
+ * @param output_bits Resolution the blocks are given with (0 for the default)
+ */
+static oversampling_result_t Measure(uint8_t oversampling, uint8_t cic_order, uint8_t output_bits, double sigma){
+	analog_input_config_t config = {
+		.input = CH2,
+		.mode = ADC_CONTINUOUS,
+		.sample_frec = SAMPLE_FREC,
+		.block_size = BLOCK,
+		.oversampling = oversampling,
+		.output_bits = output_bits,
+		.cic_order = cic_order,
+	};
+	AnalogInputInit(&config);
+	AnalogStartContinuous(CH2);
+	uint8_t decimation = (oversampling == 0) ? 1 : oversampling;
+	if(output_bits == 0){
+		output_bits = 12 + (uint8_t)log2(decimation) / 2;
+	}
+	assert(host_adc_config.sample_freq_hz == SAMPLE_FREC * decimation);
+	uint32_t frame_results = host_adc_handle_config.conv_frame_size / SOC_ADC_DIGI_RESULT_BYTES;
+	uint32_t frame[128];
+	assert(frame_results <= 128);
+	uint16_t values[BLOCK];
+	uint32_t seed = 1;
+	double sum = 0, sum2 = 0;
+	uint32_t n = 0;
+	uint8_t blocks = 0;
+	while(blocks <= BLOCKS){
+		for(uint32_t i = 0; i < frame_results; i++){
+			long raw = lround(INPUT_DC + sigma * Gauss(&seed));
+			frame[i] = HostAdcResult(CH2, (raw < 0) ? 0 : (raw > 4095) ? 4095 : raw);
+		}
+		HostAdcFrame(frame, frame_results);
+		if(AnalogInputReadContinuous(CH2, values)){
+			// The first block holds the CIC settling
+			if(blocks++ == 0){
+				continue;
+			}
+			for(uint16_t i = 0; i < BLOCK; i++){
+				double x = values[i] / (double)(1 << (output_bits - 12));
+				sum += x;
+				sum2 += x * x;
+				n++;
+			}
+		}
+	}
+	AnalogStopContinuous(CH2);
+	oversampling_result_t result;
+	result.mean = sum / n;
+	result.noise = sqrt(sum2 / n - result.mean * result.mean);
+	result.extra_bits = log2(sigma / result.noise);
+	printf("input noise %.1f LSB, %2dx, order %d, %d bits: mean %.3f, noise %.3f LSB (%+.2f bits)\n",
+		sigma, decimation, (cic_order == 0) ? 1 : cic_order, output_bits, result.mean, result.noise, result.extra_bits);
+	return result;
+}
+
+static void TestNoise(void){
+	// The ADC noise dithers the input: averaging R conversions adds log2(R) / 2 bits
+	const double sigmas[] = {1.0, 3.0};
+	for(uint8_t s = 0; s < sizeof(sigmas) / sizeof(double); s++){
+		double sigma = sigmas[s];
+		oversampling_result_t none = Measure(0, 0, 0, sigma);
+		assert(fabs(none.noise - sigma) < 0.1);
+		oversampling_result_t x16 = Measure(16, 1, 0, sigma);
+		assert(x16.extra_bits > 1.8);
+		oversampling_result_t x16_order3 = Measure(16, 3, 16, sigma);
+		assert(x16_order3.noise < x16.noise);
+		oversampling_result_t x64 = Measure(64, 1, 0, sigma);
+		assert(x64.extra_bits > 2.8);
+		Measure(64, 2, 16, sigma);
+		oversampling_result_t x64_order3 = Measure(64, 3, 16, sigma);
+		assert(x64_order3.noise < x64.noise);
+		// No bias: the mean follows the input between codes
+		oversampling_result_t results[] = {none, x16, x16_order3, x64, x64_order3};
+		for(uint8_t i = 0; i < sizeof(results) / sizeof(oversampling_result_t); i++){
+			assert(fabs(results[i].mean - INPUT_DC) < 0.05);
+		}
+	}
+	printf("TestNoise passed\n");
+}
+
+static void TestFullScale(void){
+	// Full scale at the highest gain: 4095 * 16 = 65520, no overflow of the CIC or of 16 bits
+	analog_input_config_t config = {
+		.input = CH2,
+		.mode = ADC_CONTINUOUS,
+		.sample_frec = SAMPLE_FREC,
+		.block_size = 64,
+		.oversampling = 64,
+		.output_bits = 16,
+		.cic_order = 3,
+	};
+	AnalogInputInit(&config);
+	AnalogStartContinuous(CH2);
+	uint32_t frame[128];
+	uint16_t values[64];
+	for(uint8_t i = 0; i < 128; i++){
+		frame[i] = HostAdcResult(CH2, 4095);
+	}
+	for(uint8_t k = 0; k < 64; k++){
+		HostAdcFrame(frame, 128);
+	}
+	assert(AnalogInputReadContinuous(CH2, values));
+	for(uint8_t i = 2; i < 64; i++){
+		assert(values[i] == 65520);
+	}
+	AnalogStopContinuous(CH2);
+	printf("TestFullScale passed\n");
+}
+
+/*==================[external functions definition]==========================*/
+int main(void){
+	TestNoise();
+	TestFullScale();
+	return 0;
+}
+
+/*==================[end of file]============================================*/
@@ -0,0 +1,174 @@
+/**
+ * @file test_analog_player.c
+ * @author Albano Peñalva (albano.penalva@uner.edu.ar)
+ * @brief Host tests of the DAC waveform player
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+/*==================[inclusions]=============================================*/
+#include <stdio.h>
+#include <assert.h>
+#include "driver/gptimer.h"
+#include "driver/sdm.h"
+#include "analog_io_mcu.h"
+/*==================[internal data definition]===============================*/
+static const uint8_t buffer_a[5] = {10, 11, 12, 13, 14};
+static const uint8_t buffer_b[3] = {20, 21, 22};
+static const uint8_t buffer_c[2] = {30, 31};
+static int played = 0;
+static bool refill = false;
+/*==================[internal functions definition]==========================*/
+/**
+ * @brief Buffer played callback: called from the timer ISR, outside its critical section
+ */
+static void BufferPlayed(void *param){
+	assert(host_critical_depth == 0);
+	played++;
+	// Double buffering: the released buffer is queued again from the callback
+	if(refill){
+		assert(AnalogOutputPlayerQueue(buffer_a, sizeof(buffer_a)));
+		refill = false;
+	}
+}
+
+/**
+ * @brief One sample period: the DAC value written (as given to AnalogOutputWrite())
+ */
+static uint8_t Tick(void){
+	HostTimerAlarm();
+	return (uint8_t)(host_sdm_density + 128);
+}
+
+static void TestChainedBuffers(void){
+	AnalogOutputInit();
+	analog_player_config_t config = {
+		.sample_frec = 250,
+		.loop = false,
+		.func_p = BufferPlayed,
+	};
+	AnalogOutputPlayerInit(&config);
+	// 4 ms period at 1 us resolution, not started yet
+	assert((host_timer_alarm == 4000) && !host_timer_running);
+	played = 0;
+	assert(AnalogOutputPlayerQueue(buffer_a, sizeof(buffer_a)));
+	assert(AnalogOutputPlayerQueue(buffer_b, sizeof(buffer_b)));
+	AnalogOutputPlayerStart();
+	assert(host_timer_running);
+	// Back to back in queue order, a released by the callback and queued again while b plays
+	const uint8_t expected[] = {10, 11, 12, 13, 14, 20, 21, 22, 10, 11, 12, 13, 14};
+	refill = true;
+	for(uint8_t k = 0; k < sizeof(expected); k++){
+		assert(Tick() == expected[k]);
+		if(k == 4){
+			assert(played == 1);
+		}
+	}
+	assert((played == 3) && (AnalogOutputPlayerUnderruns() == 0));
+	// Pause and resume at the same sample
+	assert(AnalogOutputPlayerQueue(buffer_b, sizeof(buffer_b)));
+	assert(Tick() == 20);
+	AnalogOutputPlayerStop();
+	assert(!host_timer_running);
+	AnalogOutputPlayerStart();
+	assert(Tick() == 21);
+	assert(Tick() == 22);
+	AnalogOutputPlayerStop();
+	printf("TestChainedBuffers passed\n");
+}
+
+static void TestUnderruns(void){
+	analog_player_config_t config = {
+		.sample_frec = 1000,
+		.loop = false,
+	};
+	AnalogOutputPlayerInit(&config);
+	assert(AnalogOutputPlayerQueue(buffer_c, sizeof(buffer_c)));
+	AnalogOutputPlayerStart();
+	assert((Tick() == 30) && (Tick() == 31));
+	// Empty queue: each period is an underrun and the output keeps the last sample (no write)
+	uint32_t writes = host_sdm_writes;
+	for(uint8_t k = 0; k < 3; k++){
+		assert(Tick() == 31);
+	}
+	assert((AnalogOutputPlayerUnderruns() == 3) && (host_sdm_writes == writes));
+	// A new buffer plays on the next period, the count is kept until a flush
+	assert(AnalogOutputPlayerQueue(buffer_b, sizeof(buffer_b)));
+	assert(Tick() == 20);
+	assert(AnalogOutputPlayerUnderruns() == 3);
+	AnalogOutputPlayerFlush();
+	assert(AnalogOutputPlayerUnderruns() == 0);
+	Tick();
+	assert(AnalogOutputPlayerUnderruns() == 1);
+	AnalogOutputPlayerStop();
+	printf("TestUnderruns passed\n");
+}
+
+static void TestQueueFull(void){
+	analog_player_config_t config = {
+		.sample_frec = 1000,
+		.loop = false,
+	};
+	AnalogOutputPlayerInit(&config);
+	for(uint8_t i = 0; i < DAC_PLAYER_QUEUE; i++){
+		assert(AnalogOutputPlayerQueue(buffer_a, sizeof(buffer_a)));
+	}
+	assert(!AnalogOutputPlayerQueue(buffer_b, sizeof(buffer_b)));
+	assert(!AnalogOutputPlayerQueue(buffer_b, 0));
+	// Room again once a buffer has been played
+	AnalogOutputPlayerStart();
+	for(uint8_t k = 0; k < sizeof(buffer_a); k++){
+		Tick();
+	}
+	assert(AnalogOutputPlayerQueue(buffer_b, sizeof(buffer_b)));
+	assert(!AnalogOutputPlayerQueue(buffer_b, sizeof(buffer_b)));
+	// The rejected buffers were not queued: 3 a and then b
+	for(uint8_t k = 0; k < 3 * sizeof(buffer_a); k++){
+		assert(Tick() == buffer_a[k % sizeof(buffer_a)]);
+	}
+	assert((Tick() == 20) && (Tick() == 21) && (Tick() == 22));
+	assert(AnalogOutputPlayerUnderruns() == 0);
+	AnalogOutputPlayerStop();
+	printf("TestQueueFull passed\n");
+}
+
+static void TestLoop(void){
+	analog_player_config_t config = {
+		.sample_frec = 3000,
+		.loop = true,
+		.func_p = BufferPlayed,
+	};
+	AnalogOutputPlayerInit(&config);
+	// Period rounded to 333 us, a new init stops the timer
+	assert((host_timer_alarm == 333) && !host_timer_running);
+	played = 0;
+	assert(AnalogOutputPlayerQueue(buffer_b, sizeof(buffer_b)));
+	assert(AnalogOutputPlayerQueue(buffer_c, sizeof(buffer_c)));
+	AnalogOutputPlayerStart();
+	// Played buffers are queued again: b c b c ... one callback per buffer, the queue never empties
+	const uint8_t cycle[] = {20, 21, 22, 30, 31};
+	for(uint16_t k = 0; k < 100 * sizeof(cycle); k++){
+		assert(Tick() == cycle[k % sizeof(cycle)]);
+	}
+	assert((played == 200) && (AnalogOutputPlayerUnderruns() == 0));
+	// The queue stays full with the looped buffers
+	assert(AnalogOutputPlayerQueue(buffer_a, sizeof(buffer_a)));
+	assert(AnalogOutputPlayerQueue(buffer_a, sizeof(buffer_a)));
+	assert(!AnalogOutputPlayerQueue(buffer_a, sizeof(buffer_a)));
+	AnalogOutputPlayerStop();
+	printf("TestLoop passed: 100 cycles of two looped buffers, %d callbacks\n", played);
+}
+
+/*==================[external functions definition]==========================*/
+int main(void){
+	TestChainedBuffers();
+	TestUnderruns();
+	TestQueueFull();
+	TestLoop();
+	return 0;
+}
+
+/*==================[end of file]============================================*/
@@ -0,0 +1,291 @@
+/**
+ * @file test_analog_scan.c
+ * @author Albano Peñalva (albano.penalva@uner.edu.ar)
+ * @brief Host tests of the analog input scan groups (DMA pattern, per channel rings)
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+/*==================[inclusions]=============================================*/
+#include <stdio.h>
+#include <assert.h>
+#include "esp_adc/adc_continuous.h"
+#include "analog_io_mcu.h"
+/*==================[macros and definitions]=================================*/
+#define SCAN_FREC		1000
+#define MAX_SCANS		64
+/*==================[internal data definition]===============================*/
+static const adc_ch_t inputs[] = {CH3, CH0, CH2};	/* Not in channel order */
+#define N_INPUTS		(sizeof(inputs) / sizeof(adc_ch_t))
+static int callbacks = 0;
+static uint16_t channel_values[N_INPUTS][MAX_SCANS];
+static uint16_t *values[N_INPUTS] = {channel_values[0], channel_values[1], channel_values[2]};
+static int64_t timestamps[MAX_SCANS];
+/*==================[internal functions definition]==========================*/
+/**
+ * @brief New scans callback: called from the ISR, outside its critical section
+ */
+static void ScansDone(void *param){
+	assert(host_critical_depth == 0);
+	callbacks++;
+	(*(int *)param)++;
+}
+
+/**
+ * @brief Value of input k in scan s: each sample tells its scan and its channel
+ */
+static uint16_t Value(uint32_t s, uint8_t k){
+	return (s * N_INPUTS + k) & 0xFFF;
+}
+
+/**
+ * @brief Results of n whole scans, from scan first
+ */
+static uint32_t Scans(uint32_t *frame, uint32_t first, uint32_t n){
+	for(uint32_t s = 0; s < n; s++){
+		for(uint8_t k = 0; k < N_INPUTS; k++){
+			frame[s * N_INPUTS + k] = HostAdcResult(inputs[k], Value(first + s, k));
+		}
+	}
+	return n * N_INPUTS;
+}
+
+/**
+ * @brief Read scans and check they are consecutive from scan first
+ */
+static uint16_t ReadScans(uint32_t first, uint16_t max_scans){
+	uint16_t n = AnalogScanRead(values, timestamps, max_scans);
+	for(uint16_t s = 0; s < n; s++){
+		for(uint8_t k = 0; k < N_INPUTS; k++){
+			assert(values[k][s] == Value(first + s, k));
+		}
+	}
+	return n;
+}
+
+static analog_scan_config_t Config(uint16_t ring_size, uint16_t block_scans, int *param){
+	analog_scan_config_t config = {
+		.inputs = inputs,
+		.n_inputs = N_INPUTS,
+		.scan_frec = SCAN_FREC,
+		.ring_size = ring_size,
+		.block_scans = block_scans,
+		.func_p = (param == NULL) ? NULL : ScansDone,
+		.param_p = param,
+	};
+	return config;
+}
+
+static void TestConfiguration(void){
+	analog_scan_config_t config = Config(16, 0, NULL);
+	AnalogScanInit(&config);
+	// One pattern with the channels in conversion order, the frequency is per conversion
+	assert(host_adc_config.pattern_num == N_INPUTS);
+	for(uint8_t k = 0; k < N_INPUTS; k++){
+		assert(host_adc_pattern[k].channel == inputs[k]);
+	}
+	assert(host_adc_config.sample_freq_hz == SCAN_FREC * N_INPUTS);
+	// Whole scans per frame: 32 by default, as many as fit in 128 results otherwise
+	assert(host_adc_handle_config.conv_frame_size == 32 * N_INPUTS * SOC_ADC_DIGI_RESULT_BYTES);
+	config.block_scans = 100;
+	AnalogScanInit(&config);
+	assert((host_adc_handles == 1) && (host_adc_handle_config.conv_frame_size == 42 * N_INPUTS * SOC_ADC_DIGI_RESULT_BYTES));
+	assert(AnalogScanRead(values, NULL, MAX_SCANS) == 0);
+	AnalogScanStart();
+	assert(host_adc_running);
+	AnalogScanStop();
+	assert(!host_adc_running);
+	printf("TestConfiguration passed\n");
+}
+
+static void TestDeinterleave(void){
+	int param = 0;
+	analog_scan_config_t config = Config(MAX_SCANS, 0, &param);
+	AnalogScanInit(&config);
+	AnalogScanStart();
+	callbacks = 0;
+	// Frames of 2 results: scans are split across frames, some frames complete none
+	uint32_t results[20 * N_INPUTS];
+	uint32_t n = Scans(results, 0, 20);
+	uint32_t sent = 0, read = 0;
+	while(sent < n){
+		uint32_t frame = (n - sent < 2) ? n - sent : 2;
+		uint32_t scans_before = sent / N_INPUTS;
+		bool scan_done = HostAdcFrame(&results[sent], frame);
+		sent += frame;
+		// Done (and one callback) only for frames that complete a scan
+		assert(scan_done == (sent / N_INPUTS != scans_before));
+		read += ReadScans(read, 1);
+	}
+	read += ReadScans(read, MAX_SCANS);
+	assert((read == 20) && (callbacks == param) && (callbacks == 20));
+	assert(AnalogScanRead(values, timestamps, MAX_SCANS) == 0);
+	AnalogScanStop();
+	printf("TestDeinterleave passed: 20 scans of %d channels in frames of 2 results, %d callbacks\n", (int)N_INPUTS, callbacks);
+}
+
+static void TestResync(void){
+	analog_scan_config_t config = Config(MAX_SCANS, 0, NULL);
+	AnalogScanInit(&config);
+	AnalogScanStart();
+	uint32_t frame[64];
+	uint32_t n = 0;
+	// Started in the middle of a scan: the results before the first channel are skipped
+	frame[n++] = HostAdcResult(inputs[1], 4095);
+	frame[n++] = HostAdcResult(inputs[2], 4095);
+	n += Scans(&frame[n], 0, 2);
+	// The last channel of scan 2 is lost: the partial scan is dropped, scan 3 is stored whole
+	frame[n++] = HostAdcResult(inputs[0], 4095);
+	frame[n++] = HostAdcResult(inputs[1], 4095);
+	n += Scans(&frame[n], 2, 1);
+	// A result of a channel out of the group restarts the scan too
+	frame[n++] = HostAdcResult(inputs[0], 4095);
+	frame[n++] = HostAdcResult(CH1, 4095);
+	frame[n++] = HostAdcResult(inputs[2], 4095);
+	n += Scans(&frame[n], 3, 2);
+	HostAdcFrame(frame, n);
+	assert(ReadScans(0, MAX_SCANS) == 5);
+	assert(AnalogScanOverruns() == 0);
+	AnalogScanStop();
+	printf("TestResync passed\n");
+}
+
+static void TestTimestamps(void){
+	analog_scan_config_t config = Config(MAX_SCANS, 0, NULL);
+	AnalogScanInit(&config);
+	AnalogScanStart();
+	// The frame ends now: its scans are back-dated one scan period (1000 us) apart, each one
+	// at the time of its last conversion
+	uint32_t frame[64];
+	uint32_t n = Scans(frame, 0, 4);
+	host_time_us = 1000000;
+	HostAdcFrame(frame, n);
+	assert(ReadScans(0, MAX_SCANS) == 4);
+	for(uint8_t s = 0; s < 4; s++){
+		assert(timestamps[s] == 1000000 - (3 - s) * 1000);
+	}
+	// A scan split across two frames has the time of the frame its last channel comes in,
+	// less the conversions after it (333 us each)
+	n = Scans(frame, 4, 2);
+	host_time_us = 1001000;
+	HostAdcFrame(frame, 2);
+	host_time_us = 1002000;
+	HostAdcFrame(&frame[2], n - 2);
+	assert(ReadScans(4, MAX_SCANS) == 2);
+	assert(timestamps[0] == 1002000 - 3 * 1000000 / (SCAN_FREC * N_INPUTS));
+	assert(timestamps[1] == 1002000);
+	AnalogScanStop();
+	host_time_us = 0;
+	printf("TestTimestamps passed\n");
+}
+
+static void TestOverruns(void){
+	const uint16_t ring_size = 5;
+	analog_scan_config_t config = Config(ring_size, 0, NULL);
+	AnalogScanInit(&config);
+	AnalogScanStart();
+	uint32_t frame[64];
+	// Late reader: 12 scans in rings of 5, the oldest 7 are overwritten
+	HostAdcFrame(frame, Scans(frame, 0, 12));
+	assert(AnalogScanOverruns() == 12 - ring_size);
+	assert(ReadScans(12 - ring_size, MAX_SCANS) == ring_size);
+	// Around the rings many times: 3 scans written and read each time, the ring indexes wrap
+	uint32_t scan = 12;
+	for(uint8_t k = 0; k < 20; k++){
+		HostAdcFrame(frame, Scans(frame, scan, 3));
+		assert(ReadScans(scan, 2) == 2);
+		assert(ReadScans(scan + 2, MAX_SCANS) == 1);
+		scan += 3;
+	}
+	assert(AnalogScanOverruns() == 12 - ring_size);
+	// Full rings, one more scan: one overrun, reads keep the order
+	HostAdcFrame(frame, Scans(frame, scan, ring_size + 1));
+	assert(AnalogScanOverruns() == 12 - ring_size + 1);
+	assert(ReadScans(scan + 1, MAX_SCANS) == ring_size);
+	// A restart discards unread scans and clears the overruns
+	HostAdcFrame(frame, Scans(frame, 0, 3));
+	AnalogScanStop();
+	AnalogScanStart();
+	assert((AnalogScanRead(values, timestamps, MAX_SCANS) == 0) && (AnalogScanOverruns() == 0));
+	HostAdcFrame(frame, Scans(frame, 100, 2));
+	assert(ReadScans(100, MAX_SCANS) == 2);
+	AnalogScanStop();
+	printf("TestOverruns passed\n");
+}
+
+static void TestLargeRing(void){
+	// Largest ring: ring_size + 1 slots still fit in 16 bits
+	const uint16_t ring_size = UINT16_MAX - 1;
+	analog_scan_config_t config = Config(ring_size, 0, NULL);
+	AnalogScanInit(&config);
+	AnalogScanStart();
+	uint32_t frame[42 * N_INPUTS];
+	uint32_t scan = 0;
+	while(scan < ring_size + 10){
+		HostAdcFrame(frame, Scans(frame, scan, 42));
+		scan += 42;
+	}
+	assert(AnalogScanOverruns() == scan - ring_size);
+	assert(ReadScans(scan - ring_size, MAX_SCANS) == MAX_SCANS);
+	AnalogScanStop();
+	printf("TestLargeRing passed: rings of %d scans\n", ring_size);
+}
+
+static void TestModes(void){
+	uint32_t frame[64];
+	uint16_t block[ADC_CONTINUOUS_BLOCK_SIZE];
+	analog_scan_config_t scan_config = Config(MAX_SCANS, 0, NULL);
+	AnalogScanInit(&scan_config);
+	AnalogScanStart();
+	HostAdcFrame(frame, Scans(frame, 0, 2));
+	// Continuous initialization while scanning: the group is stopped and replaced
+	analog_input_config_t config = {
+		.input = CH1,
+		.mode = ADC_CONTINUOUS,
+		.sample_frec = 20000,
+	};
+	AnalogInputInit(&config);
+	assert((host_adc_handles == 1) && !host_adc_running);
+	assert((host_adc_config.pattern_num == 1) && (host_adc_pattern[0].channel == CH1));
+	assert((AnalogScanRead(values, timestamps, MAX_SCANS) == 0) && (AnalogScanOverruns() == 0));
+	AnalogScanStart();
+	assert(!host_adc_running);
+	AnalogStartContinuous(CH1);
+	assert(host_adc_running);
+	for(uint16_t i = 0; i < ADC_CONTINUOUS_BLOCK_SIZE; i++){
+		frame[0] = HostAdcResult(CH1, i);
+		HostAdcFrame(frame, 1);
+	}
+	assert(AnalogInputReadContinuous(CH1, block) && (block[ADC_CONTINUOUS_BLOCK_SIZE - 1] == ADC_CONTINUOUS_BLOCK_SIZE - 1));
+	// Scan initialization while the channel runs: continuous mode is stopped and replaced
+	AnalogScanInit(&scan_config);
+	assert((host_adc_handles == 1) && !host_adc_running && (host_adc_config.pattern_num == N_INPUTS));
+	assert(!AnalogInputReadContinuous(CH1, block) && (AnalogInputContinuousOverruns(CH1) == 0));
+	AnalogStartContinuous(CH1);
+	assert(!host_adc_running);
+	AnalogScanStart();
+	HostAdcFrame(frame, Scans(frame, 10, 4));
+	assert(ReadScans(10, MAX_SCANS) == 4);
+	AnalogStopContinuous(CH1);
+	assert(host_adc_running);
+	AnalogScanStop();
+	assert(!host_adc_running);
+	printf("TestModes passed\n");
+}
+
+/*==================[external functions definition]==========================*/
+int main(void){
+	TestConfiguration();
+	TestDeinterleave();
+	TestResync();
+	TestTimestamps();
+	TestOverruns();
+	TestLargeRing();
+	TestModes();
+	return 0;
+}
+
+/*==================[end of file]============================================*/
@@ -0,0 +1,78 @@
+#ifndef _dsp_x86_H_
+#define _dsp_x86_H_
+
+// Float vector helpers for the host (x86) kernels, the ones with the _x86 extension.
+// The vector width is selected at build time from the compiler flags:
+// - AVX2 (-mavx2 or -march=native): 8 floats per vector
+// - SSE2 (always available on x86_64): 4 floats per vector
+// These kernels are enabled when CONFIG_DSP_OPTIMIZED is set in the host build sdkconfig.h.
+// They use the same operations, in the same order, as the ANSI kernels wherever the
+// algorithm allows it (mul, add, fir and fft2r give the same results). The dot product
+// keeps one partial sum per lane and the biquad solves its recursion by blocks of
+// samples, so their results differ from the ANSI ones by rounding only.
+// Compiling with -mfma lets the compiler fuse multiplications and additions, which also
+// changes the rounding.
+
+#if defined(__x86_64__) || defined(__i386__)
+
+#if defined(__AVX2__)
+
+#include <immintrin.h>
+
+#define DSP_X86_LANES 8
+
+typedef __m256 dsp_x86_f32_t;
+
+#define dsp_x86_load(p)         _mm256_loadu_ps(p)
+#define dsp_x86_store(p, v)     _mm256_storeu_ps(p, v)
+#define dsp_x86_set1(x)         _mm256_set1_ps(x)
+#define dsp_x86_zero()          _mm256_setzero_ps()
+#define dsp_x86_add(a, b)       _mm256_add_ps(a, b)
+#define dsp_x86_sub(a, b)       _mm256_sub_ps(a, b)
+#define dsp_x86_mul(a, b)       _mm256_mul_ps(a, b)
+// Swap real and imaginary parts: re0, im0, re1, im1... -> im0, re0, im1, re1...
+#define dsp_x86_swap_cplx(v)    _mm256_permute_ps(v, 0xB1)
+// Same pair of values repeated: a, b, a, b...
+#define dsp_x86_set_pair(a, b)  _mm256_setr_ps(a, b, a, b, a, b, a, b)
+// Value of one lane (constant) copied to all the lanes
+#define dsp_x86_splat(v, lane)  _mm256_permutevar8x32_ps(v, _mm256_set1_epi32(lane))
+
+static inline float dsp_x86_hsum(dsp_x86_f32_t v)
+{
+    __m128 s = _mm_add_ps(_mm256_castps256_ps128(v), _mm256_extractf128_ps(v, 1));
+    s = _mm_add_ps(s, _mm_movehl_ps(s, s));
+    s = _mm_add_ss(s, _mm_shuffle_ps(s, s, 0x55));
+    return _mm_cvtss_f32(s);
+}
+
+#elif defined(__SSE2__)
+
+#include <emmintrin.h>
+
+#define DSP_X86_LANES 4
+
+typedef __m128 dsp_x86_f32_t;
+
+#define dsp_x86_load(p)         _mm_loadu_ps(p)
+#define dsp_x86_store(p, v)     _mm_storeu_ps(p, v)
+#define dsp_x86_set1(x)         _mm_set1_ps(x)
+#define dsp_x86_zero()          _mm_setzero_ps()
+#define dsp_x86_add(a, b)       _mm_add_ps(a, b)
+#define dsp_x86_sub(a, b)       _mm_sub_ps(a, b)
+#define dsp_x86_mul(a, b)       _mm_mul_ps(a, b)
+#define dsp_x86_swap_cplx(v)    _mm_shuffle_ps(v, v, 0xB1)
+#define dsp_x86_set_pair(a, b)  _mm_setr_ps(a, b, a, b)
+#define dsp_x86_splat(v, lane)  _mm_shuffle_ps(v, v, _MM_SHUFFLE(lane, lane, lane, lane))
+
+static inline float dsp_x86_hsum(dsp_x86_f32_t v)
+{
+    __m128 s = _mm_add_ps(v, _mm_movehl_ps(v, v));
+    s = _mm_add_ss(s, _mm_shuffle_ps(s, s, 0x55));
+    return _mm_cvtss_f32(s);
+}
+
+#endif // __AVX2__
+
+#endif // __x86_64__ || __i386__
+
+#endif // _dsp_x86_H_
@@ -0,0 +1,38 @@
+// Copyright 2018-2019 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dsps_dotprod.h"
+
+#if (dsps_dotprod_f32_x86_enabled == 1)
+#include "dsp_x86.h"
+
+esp_err_t dsps_dotprod_f32_x86(const float *src1, const float *src2, float *dest, int len)
+{
+    // Two accumulators hide the addition latency
+    dsp_x86_f32_t acc0 = dsp_x86_zero();
+    dsp_x86_f32_t acc1 = dsp_x86_zero();
+    int i = 0;
+    for (; i <= len - 2 * DSP_X86_LANES ; i += 2 * DSP_X86_LANES) {
+        acc0 = dsp_x86_add(acc0, dsp_x86_mul(dsp_x86_load(&src1[i]), dsp_x86_load(&src2[i])));
+        acc1 = dsp_x86_add(acc1, dsp_x86_mul(dsp_x86_load(&src1[i + DSP_X86_LANES]), dsp_x86_load(&src2[i + DSP_X86_LANES])));
+    }
+    float acc = dsp_x86_hsum(dsp_x86_add(acc0, acc1));
+    for (; i < len ; i++) {
+        acc += src1[i] * src2[i];
+    }
+    *dest = acc;
+    return ESP_OK;
+}
+
+#endif // dsps_dotprod_f32_x86_enabled
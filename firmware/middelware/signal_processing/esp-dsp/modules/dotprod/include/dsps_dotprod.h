@@ -53,6 +53,7 @@ esp_err_t dsps_dotprod_s16_ae32(const int16_t *src1, const int16_t *src2, int16_
  * Dot product calculation for two floating point arrays: *dest += (src1[i] * src2[i]); i= [0..N)
  * The extension (_ansi) use ANSI C and could be compiled and run on any platform.
  * The extension (_ae32) is optimized for ESP32 chip.
+ * The extension (_x86) uses SSE2/AVX2 on host (x86) builds.
  *
  * @param[in] src1  source array 1
  * @param[in] src2  source array 2
@@ -65,6 +66,7 @@ esp_err_t dsps_dotprod_s16_ae32(const int16_t *src1, const int16_t *src2, int16_
 esp_err_t dsps_dotprod_f32_ansi(const float *src1, const float *src2, float *dest, int len);
 esp_err_t dsps_dotprod_f32_ae32(const float *src1, const float *src2, float *dest, int len);
 esp_err_t dsps_dotprod_f32_aes3(const float *src1, const float *src2, float *dest, int len);
+esp_err_t dsps_dotprod_f32_x86(const float *src1, const float *src2, float *dest, int len);
 /**@}*/
 
 /**@{*/
@@ -106,6 +108,9 @@ esp_err_t dsps_dotprode_f32_ae32(const float *src1, const float *src2, float *de
 #elif (dotprod_f32_ae32_enabled == 1)
 #define dsps_dotprod_f32 dsps_dotprod_f32_ae32
 #define dsps_dotprode_f32 dsps_dotprode_f32_ae32
+#elif (dsps_dotprod_f32_x86_enabled == 1)
+#define dsps_dotprod_f32 dsps_dotprod_f32_x86
+#define dsps_dotprode_f32 dsps_dotprode_f32_ansi
 #else
 #define dsps_dotprod_f32 dsps_dotprod_f32_ansi
 #define dsps_dotprode_f32 dsps_dotprode_f32_ansi
@@ -28,5 +28,8 @@
 #define dsps_dotprod_f32_aes3_enabled 1
 #endif
 
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__SSE2__)
+#define dsps_dotprod_f32_x86_enabled 1
+#endif // __SSE2__
 
 #endif // _dsps_dotprod_platform_H_
@@ -0,0 +1,95 @@
+// Copyright 2018-2019 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <string.h>
+#include <math.h>
+#include <float.h>
+#include "unity.h"
+#include "dsp_platform.h"
+#include "esp_log.h"
+#include <malloc.h>
+
+#include "dsps_dotprod.h"
+#include "dsp_tests.h"
+
+#if (dsps_dotprod_f32_x86_enabled == 1)
+
+static const char *TAG = "dsps_dotprod_f32_x86";
+
+TEST_CASE("dsps_dotprod_f32_x86 functionality", "[dsps]")
+{
+    int max_N = 1024;
+    float *x = (float *)malloc(max_N * sizeof(float));
+    float *y = (float *)malloc(max_N * sizeof(float));
+    float z[3] = {1235, 0, 1236};
+
+    for (int i = 0 ; i < max_N ; i++) {
+        x[i] = (float)rand() / RAND_MAX - 0.5f;
+        y[i] = (float)rand() / RAND_MAX - 0.5f;
+    }
+    // All the lenghts, to check the vector loop and the remaining samples
+    for (int len = 0 ; len <= max_N ; len++) {
+        float ref;
+        float abs_sum = 0;
+        for (int i = 0 ; i < len ; i++) {
+            abs_sum += fabsf(x[i] * y[i]);
+        }
+        dsps_dotprod_f32_ansi(x, y, &ref, len);
+        esp_err_t status = dsps_dotprod_f32_x86(x, y, &z[1], len);
+        TEST_ASSERT_EQUAL(status, ESP_OK);
+        TEST_ASSERT_EQUAL(1235, z[0]);
+        TEST_ASSERT_EQUAL(1236, z[2]);
+        // Partial sums per lane: only the rounding differs
+        TEST_ASSERT_FLOAT_WITHIN((len + 1) * FLT_EPSILON * abs_sum, ref, z[1]);
+    }
+
+    free(x);
+    free(y);
+}
+
+TEST_CASE("dsps_dotprod_f32_x86 benchmark", "[dsps]")
+{
+    int len = 1024;
+    int repeat_count = 1024;
+    float *x = (float *)malloc(len * sizeof(float));
+    float *y = (float *)malloc(len * sizeof(float));
+    float z;
+
+    for (int i = 0 ; i < len ; i++) {
+        x[i] = i;
+        y[i] = 1;
+    }
+
+    unsigned int start_b = xthal_get_ccount();
+    for (int i = 0 ; i < repeat_count ; i++) {
+        dsps_dotprod_f32_ansi(x, y, &z, len);
+    }
+    unsigned int end_b = xthal_get_ccount();
+    float cycles_ansi = (float)(end_b - start_b) / repeat_count;
+
+    start_b = xthal_get_ccount();
+    for (int i = 0 ; i < repeat_count ; i++) {
+        dsps_dotprod_f32_x86(x, y, &z, len);
+    }
+    end_b = xthal_get_ccount();
+    float cycles_x86 = (float)(end_b - start_b) / repeat_count;
+
+    ESP_LOGI(TAG, "%i samples: ansi %f cycles, x86 %f cycles (x%.1f)", len, cycles_ansi, cycles_x86, cycles_ansi / cycles_x86);
+    TEST_ASSERT_EXEC_IN_RANGE(1, cycles_ansi, cycles_x86);
+
+    free(x);
+    free(y);
+}
+
+#endif // dsps_dotprod_f32_x86_enabled
@@ -99,6 +99,30 @@ esp_err_t dsps_fft2r_init_fc32(float *fft_table_buff, int table_size)
     return ESP_OK;
 }
 
+esp_err_t dsps_fft2r_init_fc32_const(const float *fft_table, int table_size)
+{
+    if (dsps_fft2r_initialized != 0) {
+        return ESP_OK;
+    }
+    if (fft_table == NULL) {
+        return ESP_ERR_DSP_INVALID_PARAM;
+    }
+    if (!dsp_is_power_of_two(table_size)) {
+        return ESP_ERR_DSP_INVALID_LENGTH;
+    }
+    if (table_size > CONFIG_DSP_MAX_FFT_SIZE) {
+        return ESP_ERR_DSP_PARAM_OUTOFRANGE;
+    }
+    if (dsps_fft2r_mem_allocated) {
+        return ESP_ERR_DSP_REINITIALIZED;
+    }
+    // The transforms only read the table
+    dsps_fft_w_table_fc32 = (float *)fft_table;
+    dsps_fft_w_table_size = table_size;
+    dsps_fft2r_initialized = 1;
+    return ESP_OK;
+}
+
 void dsps_fft2r_deinit_fc32()
 {
     if (dsps_fft2r_mem_allocated) {
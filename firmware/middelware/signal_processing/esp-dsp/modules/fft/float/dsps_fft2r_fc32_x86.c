@@ -0,0 +1,119 @@
+// Copyright 2018-2019 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dsps_fft2r.h"
+#include "dsp_common.h"
+
+#if (dsps_fft2r_fc32_x86_enabled == 1)
+#include "dsp_x86.h"
+
+// All the butterflies use the same operations as the ANSI version, in the same order:
+// re_temp = c * re + s * im, im_temp = c * im + (-s) * re
+
+// Stages with N2 >= DSP_X86_LANES / 2: DSP_X86_LANES / 2 butterflies with the same twiddle at once
+static inline void fft2r_stage_x86(float *data, int N2, int ie, const float *w)
+{
+    int ia = 0;
+    for (int j = 0; j < ie; j++) {
+        dsp_x86_f32_t c = dsp_x86_set1(w[2 * j]);
+        dsp_x86_f32_t s = dsp_x86_set_pair(w[2 * j + 1], -w[2 * j + 1]);
+        for (int i = 0; i < N2; i += DSP_X86_LANES / 2) {
+            float *pa = &data[2 * (ia + i)];
+            float *pm = &data[2 * (ia + i + N2)];
+            dsp_x86_f32_t vm = dsp_x86_load(pm);
+            dsp_x86_f32_t vt = dsp_x86_add(dsp_x86_mul(c, vm), dsp_x86_mul(s, dsp_x86_swap_cplx(vm)));
+            dsp_x86_f32_t va = dsp_x86_load(pa);
+            dsp_x86_store(pm, dsp_x86_sub(va, vt));
+            dsp_x86_store(pa, dsp_x86_add(va, vt));
+        }
+        ia += 2 * N2;
+    }
+}
+
+#if (DSP_X86_LANES > 4)
+// N2 = 2 stage: one group (two butterflies) per 128 bit vector
+static inline void fft2r_stage2_x86(float *data, int ie, const float *w)
+{
+    for (int j = 0; j < ie; j++) {
+        __m128 c = _mm_set1_ps(w[2 * j]);
+        __m128 s = _mm_setr_ps(w[2 * j + 1], -w[2 * j + 1], w[2 * j + 1], -w[2 * j + 1]);
+        float *pa = &data[8 * j];
+        __m128 vm = _mm_loadu_ps(pa + 4);
+        __m128 vt = _mm_add_ps(_mm_mul_ps(c, vm), _mm_mul_ps(s, _mm_shuffle_ps(vm, vm, 0xB1)));
+        __m128 va = _mm_loadu_ps(pa);
+        _mm_storeu_ps(pa + 4, _mm_sub_ps(va, vt));
+        _mm_storeu_ps(pa, _mm_add_ps(va, vt));
+    }
+}
+#endif // DSP_X86_LANES
+
+// N2 = 1 stage (last one): two groups (one butterfly each, a different twiddle) per 128 bit vector
+static inline void fft2r_stage1_x86(float *data, int ie, const float *w)
+{
+    const __m128 sign = _mm_setr_ps(1, -1, 1, -1);
+    int j = 0;
+    for (; j <= ie - 2; j += 2) {
+        float *p = &data[4 * j];
+        __m128 v0 = _mm_loadu_ps(p);            // a0, m0
+        __m128 v1 = _mm_loadu_ps(p + 4);        // a1, m1
+        __m128 vw = _mm_loadu_ps(&w[2 * j]);    // c0, s0, c1, s1
+        __m128 c = _mm_shuffle_ps(vw, vw, _MM_SHUFFLE(2, 2, 0, 0));
+        __m128 s = _mm_mul_ps(_mm_shuffle_ps(vw, vw, _MM_SHUFFLE(3, 3, 1, 1)), sign);
+        __m128 va = _mm_movelh_ps(v0, v1);
+        __m128 vm = _mm_movehl_ps(v1, v0);
+        __m128 vt = _mm_add_ps(_mm_mul_ps(c, vm), _mm_mul_ps(s, _mm_shuffle_ps(vm, vm, 0xB1)));
+        __m128 ra = _mm_add_ps(va, vt);
+        __m128 rm = _mm_sub_ps(va, vt);
+        _mm_storeu_ps(p, _mm_movelh_ps(ra, rm));
+        _mm_storeu_ps(p + 4, _mm_movehl_ps(rm, ra));
+    }
+    for (; j < ie; j++) {
+        float c = w[2 * j];
+        float s = w[2 * j + 1];
+        float *p = &data[4 * j];
+        float re_temp = c * p[2] + s * p[3];
+        float im_temp = c * p[3] - s * p[2];
+        p[2] = p[0] - re_temp;
+        p[3] = p[1] - im_temp;
+        p[0] = p[0] + re_temp;
+        p[1] = p[1] + im_temp;
+    }
+}
+
+esp_err_t dsps_fft2r_fc32_x86_(float *data, int N, float *w)
+{
+    if (!dsp_is_power_of_two(N)) {
+        return ESP_ERR_DSP_INVALID_LENGTH;
+    }
+    if (!dsps_fft2r_initialized) {
+        return ESP_ERR_DSP_UNINITIALIZED;
+    }
+
+    int ie = 1;
+    for (int N2 = N / 2; N2 > 0; N2 >>= 1) {
+        if (N2 >= DSP_X86_LANES / 2) {
+            fft2r_stage_x86(data, N2, ie, w);
+#if (DSP_X86_LANES > 4)
+        } else if (N2 == 2) {
+            fft2r_stage2_x86(data, ie, w);
+#endif // DSP_X86_LANES
+        } else {
+            fft2r_stage1_x86(data, ie, w);
+        }
+        ie <<= 1;
+    }
+    return ESP_OK;
+}
+
+#endif // dsps_fft2r_fc32_x86_enabled
@@ -62,6 +62,30 @@ esp_err_t dsps_fft2r_init_fc32(float *fft_table_buff, int table_size);
 esp_err_t dsps_fft2r_init_sc16(int16_t *fft_table_buff, int table_size);
 /**@}*/
 
+/**@{*/
+/**
+ * @brief      init fft with a constant table
+ *
+ * Initialization of Complex FFT with a precomputed coefficients table, in the same layout that
+ * dsps_fft2r_init_fc32() / dsps_fft2r_init_sc16() generate (sin/cos pairs in bit reversed order).
+ * The table is only read, so it can be placed in flash: nothing is allocated or computed.
+ * A table of table_size words serves every transform of up to table_size complex elements.
+ * The bit reverse tables are used from flash (they are not copied to RAM).
+ *
+ * @param[in] fft_table: pointer to the constant sin/cos table
+ * @param[in] table_size: size of the table in words (power of two)
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - ESP_ERR_DSP_INVALID_PARAM if fft_table is NULL
+ *      - ESP_ERR_DSP_INVALID_LENGTH if table_size is not a power of two
+ *      - ESP_ERR_DSP_PARAM_OUTOFRANGE if table_size > CONFIG_DSP_MAX_FFT_SIZE
+ *      - ESP_ERR_DSP_REINITIALIZED if buffer already allocated internally by other function
+ */
+esp_err_t dsps_fft2r_init_fc32_const(const float *fft_table, int table_size);
+esp_err_t dsps_fft2r_init_sc16_const(const int16_t *fft_table, int table_size);
+/**@}*/
+
 /**@{*/
 /**
  * @brief      deinit fft tables
@@ -81,6 +105,7 @@ void dsps_fft2r_deinit_sc16(void);
  * Complex FFT of radix 2
  * The extension (_ansi) use ANSI C and could be compiled and run on any platform.
  * The extension (_ae32) is optimized for ESP32 chip.
+ * The extension (_x86) uses SSE2/AVX2 on host (x86) builds.
  *
  * @param[inout] data: input/output complex array. An elements located: Re[0], Im[0], ... Re[N-1], Im[N-1]
  *               result of FFT will be stored to this array.
@@ -94,6 +119,7 @@ void dsps_fft2r_deinit_sc16(void);
 esp_err_t dsps_fft2r_fc32_ansi_(float *data, int N, float *w);
 esp_err_t dsps_fft2r_fc32_ae32_(float *data, int N, float *w);
 esp_err_t dsps_fft2r_fc32_aes3_(float *data, int N, float *w);
+esp_err_t dsps_fft2r_fc32_x86_(float *data, int N, float *w);
 esp_err_t dsps_fft2r_sc16_ansi_(int16_t *data, int N, int16_t *w);
 esp_err_t dsps_fft2r_sc16_ae32_(int16_t *data, int N, int16_t *w);
 esp_err_t dsps_fft2r_sc16_aes3_(int16_t *data, int N, int16_t *w);
@@ -102,6 +128,7 @@ esp_err_t dsps_fft2r_sc16_aes3_(int16_t *data, int N, int16_t *w);
 // direct access to the table pointer
 #define dsps_fft2r_fc32_ae32(data, N) dsps_fft2r_fc32_ae32_(data, N, dsps_fft_w_table_fc32)
 #define dsps_fft2r_fc32_aes3(data, N) dsps_fft2r_fc32_aes3_(data, N, dsps_fft_w_table_fc32)
+#define dsps_fft2r_fc32_x86(data, N) dsps_fft2r_fc32_x86_(data, N, dsps_fft_w_table_fc32)
 #define dsps_fft2r_sc16_ae32(data, N) dsps_fft2r_sc16_ae32_(data, N, dsps_fft_w_table_sc16)
 #define dsps_fft2r_sc16_aes3(data, N) dsps_fft2r_sc16_aes3_(data, N, dsps_fft_w_table_sc16)
 #define dsps_fft2r_fc32_ansi(data, N) dsps_fft2r_fc32_ansi_(data, N, dsps_fft_w_table_fc32)
@@ -210,6 +237,8 @@ esp_err_t dsps_gen_bitrev2r_table(int N, int step, char *name_ext);
 #define dsps_fft2r_fc32 dsps_fft2r_fc32_aes3
 #elif (dsps_fft2r_fc32_ae32_enabled == 1)
 #define dsps_fft2r_fc32 dsps_fft2r_fc32_ae32
+#elif (dsps_fft2r_fc32_x86_enabled == 1)
+#define dsps_fft2r_fc32 dsps_fft2r_fc32_x86
 #else
 #define dsps_fft2r_fc32 dsps_fft2r_fc32_ansi
 #endif
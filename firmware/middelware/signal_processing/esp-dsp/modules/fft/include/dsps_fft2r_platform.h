@@ -32,5 +32,8 @@
 #define dsps_fft2r_sc16_aes3_enabled 1
 #endif
 
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__SSE2__)
+#define dsps_fft2r_fc32_x86_enabled 1
+#endif // __SSE2__
 
 #endif // _dsps_fft2r_platform_H_
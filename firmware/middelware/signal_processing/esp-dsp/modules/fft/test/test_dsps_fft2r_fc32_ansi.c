@@ -81,6 +81,49 @@ TEST_CASE("dsps_fft2r_fc32_ansi functionality", "[dsps]")
     dsps_fft2r_deinit_fc32();
 }
 
+TEST_CASE("dsps_fft2r_fc32_ansi constant table", "[dsps]")
+{
+    int table_size = 1024;
+    int N = 512;
+    float *table = (float *)malloc(table_size * sizeof(float));
+    TEST_ASSERT_NOT_NULL(table);
+    float *data = (float *)malloc(2 * N * sizeof(float));
+    TEST_ASSERT_NOT_NULL(data);
+    float *check_data = (float *)malloc(2 * N * sizeof(float));
+    TEST_ASSERT_NOT_NULL(check_data);
+
+    // Same layout as the internally generated table
+    TEST_ESP_OK(dsps_gen_w_r2_fc32(table, table_size));
+    TEST_ESP_OK(dsps_bit_rev_fc32_ansi(table, table_size >> 1));
+    TEST_ASSERT_EQUAL(ESP_ERR_DSP_INVALID_PARAM, dsps_fft2r_init_fc32_const(NULL, table_size));
+    TEST_ASSERT_EQUAL(ESP_ERR_DSP_INVALID_LENGTH, dsps_fft2r_init_fc32_const(table, table_size - 1));
+    TEST_ASSERT_EQUAL(ESP_ERR_DSP_PARAM_OUTOFRANGE, dsps_fft2r_init_fc32_const(table, 2 * CONFIG_DSP_MAX_FFT_SIZE));
+
+    for (int i = 0 ; i < N ; i++) {
+        data[i * 2 + 0] = sinf(M_PI / N * 17 * 2 * i) + 0.25f * cosf(M_PI / N * 101 * 2 * i);
+        data[i * 2 + 1] = 0.5f * sinf(M_PI / N * 5 * 2 * i);
+        check_data[i * 2 + 0] = data[i * 2 + 0];
+        check_data[i * 2 + 1] = data[i * 2 + 1];
+    }
+    TEST_ESP_OK(dsps_fft2r_init_fc32(NULL, table_size));
+    dsps_fft2r_fc32_ansi(check_data, N);
+    dsps_fft2r_deinit_fc32();
+
+    TEST_ESP_OK(dsps_fft2r_init_fc32_const(table, table_size));
+    // The constant table is used as is
+    TEST_ASSERT_EQUAL_PTR(table, dsps_fft_w_table_fc32);
+    dsps_fft2r_fc32_ansi(data, N);
+    for (int i = 0 ; i < N * 2 ; i++) {
+        TEST_ASSERT_EQUAL_FLOAT(check_data[i], data[i]);
+    }
+    // Not allocated: deinit must not release it
+    dsps_fft2r_deinit_fc32();
+    TEST_ASSERT_EQUAL(0, dsps_fft2r_initialized);
+    free(table);
+    free(data);
+    free(check_data);
+}
+
 TEST_CASE("dsps_fft2r_fc32_ansi benchmark", "[dsps]")
 {
     esp_err_t ret = dsps_fft2r_init_fc32(NULL, CONFIG_DSP_MAX_FFT_SIZE);
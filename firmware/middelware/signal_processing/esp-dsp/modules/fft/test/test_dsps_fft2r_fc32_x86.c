@@ -0,0 +1,88 @@
+// Copyright 2018-2019 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <string.h>
+#include <math.h>
+#include "unity.h"
+#include "dsp_platform.h"
+#include "esp_log.h"
+#include <malloc.h>
+
+#include "dsps_fft2r.h"
+#include "dsp_tests.h"
+
+#if (dsps_fft2r_fc32_x86_enabled == 1)
+
+static const char *TAG = "dsps_fft2r_fc32_x86";
+
+TEST_CASE("dsps_fft2r_fc32_x86 functionality", "[dsps]")
+{
+    int max_N = 4096;
+    float *data = (float *)malloc(2 * max_N * sizeof(float));
+    float *check_data = (float *)malloc(2 * max_N * sizeof(float));
+
+    TEST_ESP_OK(dsps_fft2r_init_fc32(NULL, max_N));
+    for (int N = 2 ; N <= max_N ; N *= 2) {
+        for (int i = 0 ; i < 2 * N ; i++) {
+            data[i] = (float)rand() / RAND_MAX - 0.5f;
+            check_data[i] = data[i];
+        }
+        dsps_fft2r_fc32_ansi(check_data, N);
+        TEST_ESP_OK(dsps_fft2r_fc32_x86(data, N));
+        // Same operations in the same order: only a compiler fusing multiplications and additions
+        // (FMA) could change the result
+        for (int i = 0 ; i < 2 * N ; i++) {
+            TEST_ASSERT_FLOAT_WITHIN(1e-6 * N, check_data[i], data[i]);
+        }
+    }
+    TEST_ASSERT_EQUAL(ESP_ERR_DSP_INVALID_LENGTH, dsps_fft2r_fc32_x86(data, 100));
+    dsps_fft2r_deinit_fc32();
+    TEST_ASSERT_EQUAL(ESP_ERR_DSP_UNINITIALIZED, dsps_fft2r_fc32_x86(data, 64));
+
+    free(data);
+    free(check_data);
+}
+
+TEST_CASE("dsps_fft2r_fc32_x86 benchmark", "[dsps]")
+{
+    int N = 1024;
+    int repeat_count = 256;
+    float *data = (float *)malloc(2 * N * sizeof(float));
+    for (int i = 0 ; i < 2 * N ; i++) {
+        data[i] = 0;
+    }
+    TEST_ESP_OK(dsps_fft2r_init_fc32(NULL, N));
+
+    unsigned int start_b = xthal_get_ccount();
+    for (int i = 0 ; i < repeat_count ; i++) {
+        dsps_fft2r_fc32_ansi(data, N);
+    }
+    unsigned int end_b = xthal_get_ccount();
+    float cycles_ansi = (float)(end_b - start_b) / repeat_count;
+
+    start_b = xthal_get_ccount();
+    for (int i = 0 ; i < repeat_count ; i++) {
+        dsps_fft2r_fc32_x86(data, N);
+    }
+    end_b = xthal_get_ccount();
+    float cycles_x86 = (float)(end_b - start_b) / repeat_count;
+
+    ESP_LOGI(TAG, "%i points: ansi %f cycles, x86 %f cycles (x%.1f)", N, cycles_ansi, cycles_x86, cycles_ansi / cycles_x86);
+    TEST_ASSERT_EXEC_IN_RANGE(1, cycles_ansi, cycles_x86);
+
+    dsps_fft2r_deinit_fc32();
+    free(data);
+}
+
+#endif // dsps_fft2r_fc32_x86_enabled
@@ -96,6 +96,49 @@ TEST_CASE("dsps_fft2r_sc16_ansi functionality", "[dsps]")
     dsps_fft2r_deinit_sc16();
 }
 
+TEST_CASE("dsps_fft2r_sc16_ansi constant table", "[dsps]")
+{
+    int table_size = 1024;
+    int N = 512;
+    int16_t *table = (int16_t *)malloc(table_size * sizeof(int16_t));
+    TEST_ASSERT_NOT_NULL(table);
+    int16_t *input = (int16_t *)malloc(2 * N * sizeof(int16_t));
+    TEST_ASSERT_NOT_NULL(input);
+    int16_t *check_input = (int16_t *)malloc(2 * N * sizeof(int16_t));
+    TEST_ASSERT_NOT_NULL(check_input);
+
+    // Same layout as the internally generated table
+    TEST_ESP_OK(dsps_gen_w_r2_sc16(table, table_size));
+    TEST_ESP_OK(dsps_bit_rev_sc16_ansi(table, table_size >> 1));
+    TEST_ASSERT_EQUAL(ESP_ERR_DSP_INVALID_PARAM, dsps_fft2r_init_sc16_const(NULL, table_size));
+    TEST_ASSERT_EQUAL(ESP_ERR_DSP_INVALID_LENGTH, dsps_fft2r_init_sc16_const(table, table_size - 1));
+    TEST_ASSERT_EQUAL(ESP_ERR_DSP_PARAM_OUTOFRANGE, dsps_fft2r_init_sc16_const(table, 2 * CONFIG_DSP_MAX_FFT_SIZE));
+
+    for (int i = 0 ; i < N ; i++) {
+        input[i * 2 + 0] = 16000 * sinf(M_PI / N * 17 * 2 * i) + 4000 * cosf(M_PI / N * 101 * 2 * i);
+        input[i * 2 + 1] = 8000 * sinf(M_PI / N * 5 * 2 * i);
+        check_input[i * 2 + 0] = input[i * 2 + 0];
+        check_input[i * 2 + 1] = input[i * 2 + 1];
+    }
+    TEST_ESP_OK(dsps_fft2r_init_sc16(NULL, table_size));
+    dsps_fft2r_sc16_ansi(check_input, N);
+    dsps_fft2r_deinit_sc16();
+
+    TEST_ESP_OK(dsps_fft2r_init_sc16_const(table, table_size));
+    // The constant table is used as is
+    TEST_ASSERT_EQUAL_PTR(table, dsps_fft_w_table_sc16);
+    dsps_fft2r_sc16_ansi(input, N);
+    for (int i = 0 ; i < N * 2 ; i++) {
+        TEST_ASSERT_EQUAL(check_input[i], input[i]);
+    }
+    // Not allocated: deinit must not release it
+    dsps_fft2r_deinit_sc16();
+    TEST_ASSERT_EQUAL(0, dsps_fft2r_sc16_initialized);
+    free(table);
+    free(input);
+    free(check_input);
+}
+
 TEST_CASE("dsps_fft2r_sc16_ansi benchmark", "[dsps]")
 {
     esp_err_t ret = dsps_fft2r_init_sc16(NULL, CONFIG_DSP_MAX_FFT_SIZE);
@@ -0,0 +1,89 @@
+// Copyright 2018-2019 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dsps_fir.h"
+
+#if (dsps_fir_f32_x86_enabled == 1)
+#include "dsp_x86.h"
+
+#define FIR_X86_CHUNK   (8 * DSP_X86_LANES)     // Outputs computed from each copy of the delay line
+
+esp_err_t dsps_fir_f32_x86(fir_f32_t *fir, const float *input, float *output, int len)
+{
+    // The last N - 1 samples (oldest first) followed by the new ones, so the samples of
+    // DSP_X86_LANES consecutive outputs are contiguous: each vector holds DSP_X86_LANES outputs,
+    // accumulated in the same order as the ANSI version.
+    int N = fir->N;
+    float x[N - 1 + FIR_X86_CHUNK];
+    for (int start = 0 ; start < len ; start += FIR_X86_CHUNK) {
+        int count = len - start;
+        if (count > FIR_X86_CHUNK) {
+            count = FIR_X86_CHUNK;
+        }
+        int k = 0;
+        for (int n = fir->pos + 1; n < N ; n++) {
+            x[k++] = fir->delay[n];
+        }
+        for (int n = 0; n < fir->pos ; n++) {
+            x[k++] = fir->delay[n];
+        }
+        for (int i = 0 ; i < count ; i++) {
+            x[k++] = input[start + i];
+            fir->delay[fir->pos] = input[start + i];
+            fir->pos++;
+            if (fir->pos >= N) {
+                fir->pos = 0;
+            }
+        }
+
+        float *y = &output[start];
+        int i = 0;
+        // Four independent vectors hide the addition latency
+        for (; i <= count - 4 * DSP_X86_LANES ; i += 4 * DSP_X86_LANES) {
+            dsp_x86_f32_t acc0 = dsp_x86_zero();
+            dsp_x86_f32_t acc1 = dsp_x86_zero();
+            dsp_x86_f32_t acc2 = dsp_x86_zero();
+            dsp_x86_f32_t acc3 = dsp_x86_zero();
+            for (int n = 0 ; n < N ; n++) {
+                dsp_x86_f32_t c = dsp_x86_set1(fir->coeffs[n]);
+                const float *p = &x[i + n];
+                acc0 = dsp_x86_add(acc0, dsp_x86_mul(c, dsp_x86_load(p)));
+                acc1 = dsp_x86_add(acc1, dsp_x86_mul(c, dsp_x86_load(p + DSP_X86_LANES)));
+                acc2 = dsp_x86_add(acc2, dsp_x86_mul(c, dsp_x86_load(p + 2 * DSP_X86_LANES)));
+                acc3 = dsp_x86_add(acc3, dsp_x86_mul(c, dsp_x86_load(p + 3 * DSP_X86_LANES)));
+            }
+            dsp_x86_store(&y[i], acc0);
+            dsp_x86_store(&y[i + DSP_X86_LANES], acc1);
+            dsp_x86_store(&y[i + 2 * DSP_X86_LANES], acc2);
+            dsp_x86_store(&y[i + 3 * DSP_X86_LANES], acc3);
+        }
+        for (; i <= count - DSP_X86_LANES ; i += DSP_X86_LANES) {
+            dsp_x86_f32_t acc = dsp_x86_zero();
+            for (int n = 0 ; n < N ; n++) {
+                acc = dsp_x86_add(acc, dsp_x86_mul(dsp_x86_set1(fir->coeffs[n]), dsp_x86_load(&x[i + n])));
+            }
+            dsp_x86_store(&y[i], acc);
+        }
+        for (; i < count ; i++) {
+            float acc = 0;
+            for (int n = 0 ; n < N ; n++) {
+                acc += fir->coeffs[n] * x[i + n];
+            }
+            y[i] = acc;
+        }
+    }
+    return ESP_OK;
+}
+
+#endif // dsps_fir_f32_x86_enabled
@@ -123,6 +123,7 @@ esp_err_t dsps_fird_init_s16(fir_s16_t *fir, int16_t *coeffs, int16_t *delay, in
  * Function implements FIR filter
  * The extension (_ansi) uses ANSI C and could be compiled and run on any platform.
  * The extension (_ae32) is optimized for ESP32 chip.
+ * The extension (_x86) uses SSE2/AVX2 on host (x86) builds.
  *
  * @param fir: pointer to fir filter structure, that must be initialized before
  * @param[in] input: input array
@@ -136,6 +137,7 @@ esp_err_t dsps_fird_init_s16(fir_s16_t *fir, int16_t *coeffs, int16_t *delay, in
 esp_err_t dsps_fir_f32_ansi(fir_f32_t *fir, const float *input, float *output, int len);
 esp_err_t dsps_fir_f32_ae32(fir_f32_t *fir, const float *input, float *output, int len);
 esp_err_t dsps_fir_f32_aes3(fir_f32_t *fir, const float *input, float *output, int len);
+esp_err_t dsps_fir_f32_x86(fir_f32_t *fir, const float *input, float *output, int len);
 /**@}*/
 
 /**@{*/
@@ -242,6 +244,8 @@ esp_err_t dsps_16_array_rev(int16_t *arr, int16_t len);
 #define dsps_fir_f32 dsps_fir_f32_ae32
 #elif (dsps_fir_f32_aes3_enabled == 1)
 #define dsps_fir_f32 dsps_fir_f32_aes3
+#elif (dsps_fir_f32_x86_enabled == 1)
+#define dsps_fir_f32 dsps_fir_f32_x86
 #else
 #define dsps_fir_f32 dsps_fir_f32_ansi
 #endif
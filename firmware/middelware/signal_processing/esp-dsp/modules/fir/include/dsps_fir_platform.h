@@ -28,4 +28,8 @@
 #endif //
 #endif // __XTENSA__
 
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__SSE2__)
+#define dsps_fir_f32_x86_enabled 1
+#endif // __SSE2__
+
 #endif // _dsps_fir_platform_H_
@@ -0,0 +1,101 @@
+// Copyright 2018-2019 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <string.h>
+#include <math.h>
+#include <float.h>
+#include "unity.h"
+#include "dsp_platform.h"
+#include "esp_log.h"
+
+#include "dsps_fir.h"
+#include "dsp_tests.h"
+
+#if (dsps_fir_f32_x86_enabled == 1)
+
+static const char *TAG = "dsps_fir_f32_x86";
+
+static float x[1024];
+static float y[1024];
+static float y_ref[1024];
+static float coeffs[100];
+static float delay[100];
+static float delay_ref[100];
+
+TEST_CASE("dsps_fir_f32_x86 functionality", "[dsps]")
+{
+    int len = sizeof(x) / sizeof(float);
+    // Shorter and longer than the vectors, and not multiple of them
+    int fir_lens[] = {3, 16, 37, 100};
+    int blocks[] = {1, 7, 13, 100, 3, 900};
+
+    for (int i = 0 ; i < len ; i++) {
+        x[i] = (float)rand() / RAND_MAX - 0.5f;
+    }
+    for (int f = 0 ; f < sizeof(fir_lens) / sizeof(int) ; f++) {
+        int fir_len = fir_lens[f];
+        float coeffs_abs = 0;
+        for (int i = 0 ; i < fir_len ; i++) {
+            coeffs[i] = (float)rand() / RAND_MAX - 0.5f;
+            coeffs_abs += fabsf(coeffs[i]);
+        }
+        fir_f32_t fir;
+        fir_f32_t fir_ref;
+        dsps_fir_init_f32(&fir, coeffs, delay, fir_len);
+        dsps_fir_init_f32(&fir_ref, coeffs, delay_ref, fir_len);
+        int pos = 0;
+        for (int b = 0 ; b < sizeof(blocks) / sizeof(int) ; b++) {
+            dsps_fir_f32_ansi(&fir_ref, &x[pos], &y_ref[pos], blocks[b]);
+            TEST_ESP_OK(dsps_fir_f32_x86(&fir, &x[pos], &y[pos], blocks[b]));
+            pos += blocks[b];
+        }
+        TEST_ASSERT_EQUAL(fir_ref.pos, fir.pos);
+        // Same operations in the same order: only a compiler fusing multiplications and additions
+        // (FMA) could change the result (|x| <= 0.5)
+        for (int i = 0 ; i < len ; i++) {
+            TEST_ASSERT_FLOAT_WITHIN(fir_len * FLT_EPSILON * coeffs_abs, y_ref[i], y[i]);
+        }
+    }
+}
+
+TEST_CASE("dsps_fir_f32_x86 benchmark", "[dsps]")
+{
+    int len = sizeof(x) / sizeof(float);
+    int repeat_count = 16;
+    int fir_len = 32;
+    fir_f32_t fir;
+    for (int i = 0 ; i < fir_len ; i++) {
+        coeffs[i] = i;
+    }
+    dsps_fir_init_f32(&fir, coeffs, delay, fir_len);
+
+    unsigned int start_b = xthal_get_ccount();
+    for (int i = 0 ; i < repeat_count ; i++) {
+        dsps_fir_f32_ansi(&fir, x, y, len);
+    }
+    unsigned int end_b = xthal_get_ccount();
+    float cycles_ansi = (float)(end_b - start_b) / (len * repeat_count);
+
+    start_b = xthal_get_ccount();
+    for (int i = 0 ; i < repeat_count ; i++) {
+        dsps_fir_f32_x86(&fir, x, y, len);
+    }
+    end_b = xthal_get_ccount();
+    float cycles_x86 = (float)(end_b - start_b) / (len * repeat_count);
+
+    ESP_LOGI(TAG, "%i coefficients: ansi %f cycles per sample, x86 %f cycles per sample (x%.1f)", fir_len, cycles_ansi, cycles_x86, cycles_ansi / cycles_x86);
+    TEST_ASSERT_EXEC_IN_RANGE(1, cycles_ansi, cycles_x86);
+}
+
+#endif // dsps_fir_f32_x86_enabled
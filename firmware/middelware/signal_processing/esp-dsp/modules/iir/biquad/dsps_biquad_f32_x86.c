@@ -0,0 +1,100 @@
+// Copyright 2018-2019 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dsps_biquad.h"
+
+#if (dsps_biquad_f32_x86_enabled == 1)
+#include "dsp_x86.h"
+
+#define BIQUAD_X86_BLOCKS   8   // Blocks of DSP_X86_LANES samples solved before computing their outputs
+
+esp_err_t dsps_biquad_f32_x86(const float *input, float *output, int len, float *coef, float *w)
+{
+    // The recursion d[i] = input[i] - a1 * d[i - 1] - a2 * d[i - 2] is solved for DSP_X86_LANES
+    // samples at once: each d of the block is a weighted sum of the block inputs (impulse response h)
+    // plus the contribution of the two previous d (the state). Only that last part depends on the
+    // previous block. The output uses the same expression as the ANSI version.
+    double h[DSP_X86_LANES + 1];
+    h[0] = 1;
+    h[1] = -coef[3];
+    for (int k = 2 ; k <= DSP_X86_LANES ; k++) {
+        h[k] = -coef[3] * h[k - 1] - coef[4] * h[k - 2];
+    }
+    float col[DSP_X86_LANES][DSP_X86_LANES];
+    float g1[DSP_X86_LANES];    // d[i - 1] and d[i - 2] contributions (see below)
+    float g2[DSP_X86_LANES];
+    for (int k = 0 ; k < DSP_X86_LANES ; k++) {
+        for (int j = 0 ; j < DSP_X86_LANES ; j++) {
+            col[j][k] = (k >= j) ? h[k - j] : 0;
+        }
+        g1[k] = h[k + 1] - coef[4] * h[k];
+        g2[k] = -coef[4] * h[k];
+    }
+    dsp_x86_f32_t vg1 = dsp_x86_load(g1);
+    dsp_x86_f32_t vg2 = dsp_x86_load(g2);
+    dsp_x86_f32_t b0 = dsp_x86_set1(coef[0]);
+    dsp_x86_f32_t b1 = dsp_x86_set1(coef[1]);
+    dsp_x86_f32_t b2 = dsp_x86_set1(coef[2]);
+    // d[i - 1] and d[i - 2] in all the lanes
+    dsp_x86_f32_t d1 = dsp_x86_set1(w[0]);
+    dsp_x86_f32_t d2 = dsp_x86_set1(w[1]);
+    // d[i - 2], d[i - 1], followed by the d of BIQUAD_X86_BLOCKS blocks
+    float d[BIQUAD_X86_BLOCKS * DSP_X86_LANES + 2];
+    d[0] = w[1];
+    d[1] = w[0];
+
+    int i = 0;
+    while (i <= len - DSP_X86_LANES) {
+        int blocks = (len - i) / DSP_X86_LANES;
+        if (blocks > BIQUAD_X86_BLOCKS) {
+            blocks = BIQUAD_X86_BLOCKS;
+        }
+        // First the recursion, then the outputs: the d just stored are not read back right away
+        for (int b = 0 ; b < blocks ; b++) {
+            const float *x = &input[i + b * DSP_X86_LANES];
+            dsp_x86_f32_t acc0 = dsp_x86_mul(dsp_x86_set1(x[0]), dsp_x86_load(col[0]));
+            dsp_x86_f32_t acc1 = dsp_x86_mul(dsp_x86_set1(x[1]), dsp_x86_load(col[1]));
+            for (int j = 2 ; j < DSP_X86_LANES ; j += 2) {
+                acc0 = dsp_x86_add(acc0, dsp_x86_mul(dsp_x86_set1(x[j]), dsp_x86_load(col[j])));
+                acc1 = dsp_x86_add(acc1, dsp_x86_mul(dsp_x86_set1(x[j + 1]), dsp_x86_load(col[j + 1])));
+            }
+            // d[i - 2] as d[i - 1] plus the (small) difference, that keeps the rounding error
+            // of filters with poles close to 1 (low cutoff frequency) as low as in the ANSI version
+            dsp_x86_f32_t state = dsp_x86_add(dsp_x86_mul(d1, vg1), dsp_x86_mul(dsp_x86_sub(d2, d1), vg2));
+            dsp_x86_f32_t vd = dsp_x86_add(dsp_x86_add(acc0, acc1), state);
+            dsp_x86_store(&d[2 + b * DSP_X86_LANES], vd);
+            d1 = dsp_x86_splat(vd, DSP_X86_LANES - 1);
+            d2 = dsp_x86_splat(vd, DSP_X86_LANES - 2);
+        }
+        for (int b = 0 ; b < blocks ; b++) {
+            float *pd = &d[b * DSP_X86_LANES];
+            dsp_x86_f32_t y = dsp_x86_add(dsp_x86_mul(b0, dsp_x86_load(&pd[2])), dsp_x86_mul(b1, dsp_x86_load(&pd[1])));
+            dsp_x86_store(&output[i + b * DSP_X86_LANES], dsp_x86_add(y, dsp_x86_mul(b2, dsp_x86_load(&pd[0]))));
+        }
+        i += blocks * DSP_X86_LANES;
+        d[0] = d[blocks * DSP_X86_LANES];
+        d[1] = d[blocks * DSP_X86_LANES + 1];
+    }
+    w[0] = d[1];
+    w[1] = d[0];
+    for (; i < len ; i++) {
+        float d0 = input[i] - coef[3] * w[0] - coef[4] * w[1];
+        output[i] = coef[0] * d0 +  coef[1] * w[0] + coef[2] * w[1];
+        w[1] = w[0];
+        w[0] = d0;
+    }
+    return ESP_OK;
+}
+
+#endif // dsps_biquad_f32_x86_enabled
@@ -0,0 +1,127 @@
+// Copyright 2018-2024 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dsps_biquad.h"
+
+
+esp_err_t dsps_biquad_sos_f32_ansi(const float *input, float *output, int len, float *coef, float *w, int n_sos)
+{
+    if (n_sos == 1) {
+        return dsps_biquad_f32_ansi(input, output, len, coef, w);
+    }
+    float st[2 * DSPS_BIQUAD_SOS_MAX_FUSED];
+    const float *in = input;
+    for (int g = 0 ; g < n_sos ; g += DSPS_BIQUAD_SOS_MAX_FUSED) {
+        int n = n_sos - g;
+        if (n > DSPS_BIQUAD_SOS_MAX_FUSED) {
+            n = DSPS_BIQUAD_SOS_MAX_FUSED;
+        }
+        float *c = &coef[g * 5];
+        float *d = &w[g * 2];
+        for (int s = 0 ; s < 2 * n ; s++) {
+            st[s] = d[s];
+        }
+        for (int i = 0 ; i < len ; i++) {
+            float x = in[i];
+            for (int s = 0 ; s < n ; s++) {
+                float d0 = x - c[s * 5 + 3] * st[2 * s] - c[s * 5 + 4] * st[2 * s + 1];
+                x = c[s * 5 + 0] * d0 + c[s * 5 + 1] * st[2 * s] + c[s * 5 + 2] * st[2 * s + 1];
+                st[2 * s + 1] = st[2 * s];
+                st[2 * s] = d0;
+            }
+            output[i] = x;
+        }
+        for (int s = 0 ; s < 2 * n ; s++) {
+            d[s] = st[s];
+        }
+        in = output;
+    }
+    return ESP_OK;
+}
+
+// Filters n_ch (up to DSPS_BIQUAD_SOS_MAX_CHANNELS) channels of an interleaved buffer with
+// step channels per frame. Each section's coefficients are loaded once per frame and applied to
+// all the channels, whose states are independent recurrences computed together. Called with a
+// constant n_ch, so the states of a frame stay in registers.
+static inline void dsps_biquad_sos_mc_group(const float *input, float *output, int len, int step, int n_ch,
+                                            float *coef, float *w, int n_sos)
+{
+    float st[2 * DSPS_BIQUAD_SOS_MAX_FUSED * DSPS_BIQUAD_SOS_MAX_CHANNELS];
+    float x[DSPS_BIQUAD_SOS_MAX_CHANNELS];
+    const float *in = input;
+    for (int g = 0 ; g < n_sos ; g += DSPS_BIQUAD_SOS_MAX_FUSED) {
+        int n = n_sos - g;
+        if (n > DSPS_BIQUAD_SOS_MAX_FUSED) {
+            n = DSPS_BIQUAD_SOS_MAX_FUSED;
+        }
+        float *c = &coef[g * 5];
+        for (int s = 0 ; s < 2 * n ; s++) {
+            for (int ch = 0 ; ch < n_ch ; ch++) {
+                st[s * DSPS_BIQUAD_SOS_MAX_CHANNELS + ch] = w[ch * 2 * n_sos + g * 2 + s];
+            }
+        }
+        for (int i = 0 ; i < len * step ; i += step) {
+            for (int ch = 0 ; ch < n_ch ; ch++) {
+                x[ch] = in[i + ch];
+            }
+            for (int s = 0 ; s < n ; s++) {
+                float b0 = c[s * 5 + 0];
+                float b1 = c[s * 5 + 1];
+                float b2 = c[s * 5 + 2];
+                float a1 = c[s * 5 + 3];
+                float a2 = c[s * 5 + 4];
+                float *w0 = &st[2 * s * DSPS_BIQUAD_SOS_MAX_CHANNELS];
+                float *w1 = &st[(2 * s + 1) * DSPS_BIQUAD_SOS_MAX_CHANNELS];
+                for (int ch = 0 ; ch < n_ch ; ch++) {
+                    float d0 = x[ch] - a1 * w0[ch] - a2 * w1[ch];
+                    x[ch] = b0 * d0 + b1 * w0[ch] + b2 * w1[ch];
+                    w1[ch] = w0[ch];
+                    w0[ch] = d0;
+                }
+            }
+            for (int ch = 0 ; ch < n_ch ; ch++) {
+                output[i + ch] = x[ch];
+            }
+        }
+        for (int s = 0 ; s < 2 * n ; s++) {
+            for (int ch = 0 ; ch < n_ch ; ch++) {
+                w[ch * 2 * n_sos + g * 2 + s] = st[s * DSPS_BIQUAD_SOS_MAX_CHANNELS + ch];
+            }
+        }
+        in = output;
+    }
+}
+
+esp_err_t dsps_biquad_sos_mc_f32_ansi(const float *input, float *output, int len, int n_ch, float *coef, float *w, int n_sos)
+{
+    if (n_ch == 1) {
+        return dsps_biquad_sos_f32_ansi(input, output, len, coef, w, n_sos);
+    }
+    for (int ch = 0 ; ch < n_ch ; ch += DSPS_BIQUAD_SOS_MAX_CHANNELS) {
+        int m = n_ch - ch;
+        if (m > DSPS_BIQUAD_SOS_MAX_CHANNELS) {
+            m = DSPS_BIQUAD_SOS_MAX_CHANNELS;
+        }
+        if (m == 4) {
+            dsps_biquad_sos_mc_group(&input[ch], &output[ch], len, n_ch, 4, coef, &w[ch * 2 * n_sos], n_sos);
+        } else if (m == 3) {
+            dsps_biquad_sos_mc_group(&input[ch], &output[ch], len, n_ch, 3, coef, &w[ch * 2 * n_sos], n_sos);
+        } else if (m == 2) {
+            dsps_biquad_sos_mc_group(&input[ch], &output[ch], len, n_ch, 2, coef, &w[ch * 2 * n_sos], n_sos);
+        } else {
+            dsps_biquad_sos_mc_group(&input[ch], &output[ch], len, n_ch, 1, coef, &w[ch * 2 * n_sos], n_sos);
+        }
+    }
+    return ESP_OK;
+}
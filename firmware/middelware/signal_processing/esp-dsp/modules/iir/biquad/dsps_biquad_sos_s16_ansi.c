@@ -0,0 +1,56 @@
+// Copyright 2018-2024 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dsps_biquad.h"
+
+// Internal signals are saturated to +-2^30, so the five products of a section
+// (|coef| < 2^31) can be accumulated in 64 bits without overflow.
+#define BIQUAD_S16_SAT_MAX ((1 << 30) - 1)
+#define BIQUAD_S16_SAT_MIN (-(1 << 30))
+
+esp_err_t dsps_biquad_sos_s16_ansi(const int16_t *input, int16_t *output, int len, const int32_t *coef, int32_t *w, int n_sos)
+{
+    for (int i = 0 ; i < len ; i++) {
+        int32_t x = (int32_t)input[i] << DSPS_BIQUAD_S16_DATA_SHIFT;
+        for (int s = 0 ; s < n_sos ; s++) {
+            const int32_t *c = &coef[s * 5];
+            int32_t *st = &w[s * DSPS_BIQUAD_S16_STATE_SIZE];
+            // Direct form I: st = x1, x2, y1, y2, quantization error of previous output
+            int64_t acc = st[4];
+            acc += (int64_t)c[0] * x + (int64_t)c[1] * st[0] + (int64_t)c[2] * st[1];
+            acc -= (int64_t)c[3] * st[2] + (int64_t)c[4] * st[3];
+            int64_t y = acc >> DSPS_BIQUAD_S16_COEF_SHIFT;
+            // Error feedback: truncated bits are added to the next output
+            st[4] = (int32_t)(acc - (y << DSPS_BIQUAD_S16_COEF_SHIFT));
+            if (y > BIQUAD_S16_SAT_MAX) {
+                y = BIQUAD_S16_SAT_MAX;
+            } else if (y < BIQUAD_S16_SAT_MIN) {
+                y = BIQUAD_S16_SAT_MIN;
+            }
+            st[1] = st[0];
+            st[0] = x;
+            st[3] = st[2];
+            st[2] = (int32_t)y;
+            x = (int32_t)y;
+        }
+        x = (x + (1 << (DSPS_BIQUAD_S16_DATA_SHIFT - 1))) >> DSPS_BIQUAD_S16_DATA_SHIFT;
+        if (x > INT16_MAX) {
+            x = INT16_MAX;
+        } else if (x < INT16_MIN) {
+            x = INT16_MIN;
+        }
+        output[i] = (int16_t)x;
+    }
+    return ESP_OK;
+}
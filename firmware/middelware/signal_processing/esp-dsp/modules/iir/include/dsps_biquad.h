@@ -16,6 +16,7 @@
 #ifndef _dsps_biquad_H_
 #define _dsps_biquad_H_
 
+#include <stdint.h>
 #include "dsp_err.h"
 
 #include "dsps_biquad_platform.h"
@@ -32,6 +33,7 @@ extern "C"
  * IIR filter 2nd order direct form II (bi quad)
  * The extension (_ansi) use ANSI C and could be compiled and run on any platform.
  * The extension (_ae32) is optimized for ESP32 chip.
+ * The extension (_x86) uses SSE2/AVX2 on host (x86) builds.
  *
  * @param[in] input: input array
  * @param output: output array
@@ -46,6 +48,99 @@ extern "C"
 esp_err_t dsps_biquad_f32_ansi(const float *input, float *output, int len, float *coef, float *w);
 esp_err_t dsps_biquad_f32_ae32(const float *input, float *output, int len, float *coef, float *w);
 esp_err_t dsps_biquad_f32_aes3(const float *input, float *output, int len, float *coef, float *w);
+esp_err_t dsps_biquad_f32_x86(const float *input, float *output, int len, float *coef, float *w);
+/**@}*/
+
+/**
+ * Maximum number of sections processed in one pass by dsps_biquad_sos_f32.
+ * Longer cascades are processed in several passes.
+ */
+#define DSPS_BIQUAD_SOS_MAX_FUSED 8
+
+/**@{*/
+/**
+ * @brief   IIR filter cascade
+ *
+ * Cascade of n_sos 2nd order direct form II (bi quad) sections.
+ * All the sections are applied to a sample before moving to the next one,
+ * so the input is read and the output is written only once.
+ * The result is the same as calling dsps_biquad_f32 once per section.
+ * The extension (_ansi) use ANSI C and could be compiled and run on any platform.
+ *
+ * @param[in] input: input array
+ * @param output: output array (could be the same as input)
+ * @param len: length of input and output vectors
+ * @param coef: array of coefficients. b0,b1,b2,a1,a2 for each section. Length of 5*n_sos
+ *              expected that a0 = 1. b0..b2 - numerator, a0..a2 - denominator
+ * @param w: delay lines w0,w1 for each section. Length of 2*n_sos.
+ * @param n_sos: number of sections
+ * @return
+ *      - ESP_OK on success
+ *      - One of the error codes from DSP library
+ */
+esp_err_t dsps_biquad_sos_f32_ansi(const float *input, float *output, int len, float *coef, float *w, int n_sos);
+/**@}*/
+
+/**
+ * Number of channels dsps_biquad_sos_mc_f32 filters in one pass over an interleaved buffer.
+ * More channels are processed in several passes.
+ */
+#define DSPS_BIQUAD_SOS_MAX_CHANNELS 4
+
+/**@{*/
+/**
+ * @brief   Multi-channel IIR filter cascade
+ *
+ * Same as dsps_biquad_sos_f32 applied to each channel of an interleaved buffer
+ * (input[i * n_ch + ch] is sample i of channel ch), with the same coefficients for all channels.
+ * The coefficients of a section are loaded once per frame of samples and applied to all the
+ * channels, whose independent states are updated together.
+ * The extension (_ansi) use ANSI C and could be compiled and run on any platform.
+ *
+ * @param[in] input: interleaved input array
+ * @param output: interleaved output array (could be the same as input)
+ * @param len: number of samples per channel
+ * @param n_ch: number of interleaved channels
+ * @param coef: array of coefficients. b0,b1,b2,a1,a2 for each section. Length of 5*n_sos
+ *              expected that a0 = 1. b0..b2 - numerator, a0..a2 - denominator
+ * @param w: delay lines w0,w1 for each section of each channel, channel major. Length of 2*n_sos*n_ch.
+ * @param n_sos: number of sections
+ * @return
+ *      - ESP_OK on success
+ *      - One of the error codes from DSP library
+ */
+esp_err_t dsps_biquad_sos_mc_f32_ansi(const float *input, float *output, int len, int n_ch, float *coef, float *w, int n_sos);
+/**@}*/
+
+/**
+ * Fixed point cascade formats:
+ * coefficients in Q30 (range -2..2), Q15 samples are processed internally as Q27,
+ * which leaves 3 guard bits (18 dB) before internal signals saturate.
+ */
+#define DSPS_BIQUAD_S16_COEF_SHIFT 30
+#define DSPS_BIQUAD_S16_DATA_SHIFT 12
+#define DSPS_BIQUAD_S16_STATE_SIZE 5
+
+/**@{*/
+/**
+ * @brief   Fixed point IIR filter cascade
+ *
+ * Cascade of n_sos 2nd order direct form I (bi quad) sections with 64 bit accumulation
+ * and first order error feedback, so the quantization noise stays low also for
+ * cut-off frequencies close to 0. Internal signals and output are saturated.
+ * The extension (_ansi) use ANSI C and could be compiled and run on any platform.
+ *
+ * @param[in] input: input array (Q15)
+ * @param output: output array (Q15, could be the same as input)
+ * @param len: length of input and output vectors
+ * @param coef: array of coefficients in Q30. b0,b1,b2,a1,a2 for each section. Length of 5*n_sos
+ * @param w: state of each section (x1, x2, y1, y2, error). Length of DSPS_BIQUAD_S16_STATE_SIZE*n_sos.
+ * @param n_sos: number of sections
+ * @return
+ *      - ESP_OK on success
+ *      - One of the error codes from DSP library
+ */
+esp_err_t dsps_biquad_sos_s16_ansi(const int16_t *input, int16_t *output, int len, const int32_t *coef, int32_t *w, int n_sos);
 /**@}*/
 
 
@@ -59,6 +154,8 @@ esp_err_t dsps_biquad_f32_aes3(const float *input, float *output, int len, float
 #define dsps_biquad_f32 dsps_biquad_f32_ae32
 #elif (dsps_biquad_f32_aes3_enabled == 1)
 #define dsps_biquad_f32 dsps_biquad_f32_aes3
+#elif (dsps_biquad_f32_x86_enabled == 1)
+#define dsps_biquad_f32 dsps_biquad_f32_x86
 #else
 #define dsps_biquad_f32 dsps_biquad_f32_ansi
 #endif
@@ -69,5 +166,9 @@ esp_err_t dsps_biquad_f32_aes3(const float *input, float *output, int len, float
 
 #endif // CONFIG_DSP_OPTIMIZED
 
+#define dsps_biquad_sos_f32 dsps_biquad_sos_f32_ansi
+#define dsps_biquad_sos_mc_f32 dsps_biquad_sos_mc_f32_ansi
+#define dsps_biquad_sos_s16 dsps_biquad_sos_s16_ansi
+
 
 #endif // _dsps_biquad_H_
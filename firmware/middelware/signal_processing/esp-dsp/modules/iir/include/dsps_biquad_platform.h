@@ -21,5 +21,8 @@
 
 #endif // __XTENSA__
 
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__SSE2__)
+#define dsps_biquad_f32_x86_enabled 1
+#endif // __SSE2__
 
 #endif // _dsps_biquad_platform_H_
@@ -0,0 +1,101 @@
+// Copyright 2018-2019 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <string.h>
+#include <math.h>
+#include "unity.h"
+#include "dsp_platform.h"
+#include "esp_log.h"
+
+#include "dsps_biquad_gen.h"
+#include "dsps_biquad.h"
+#include "dsp_tests.h"
+
+#if (dsps_biquad_f32_x86_enabled == 1)
+
+static const char *TAG = "dsps_biquad_f32_x86";
+
+static float x[1024];
+static float y[1024];
+static float y_ref[1024];
+
+TEST_CASE("dsps_biquad_f32_x86 functionality", "[dsps]")
+{
+    int len = sizeof(x) / sizeof(float);
+    // Block lenghts that leave remaining samples, so the state is carried between both loops
+    int blocks[] = {1, 7, 13, 100, 3, 900};
+    float coeffs[4][5];
+    dsps_biquad_gen_lpf_f32(coeffs[0], 0.1, 0.7);
+    dsps_biquad_gen_lpf_f32(coeffs[1], 0.005, 4);   // Poles close to the unit circle
+    dsps_biquad_gen_hpf_f32(coeffs[2], 0.3, 1);
+    dsps_biquad_gen_notch_f32(coeffs[3], 0.05, -20, 2);
+
+    for (int i = 0 ; i < len ; i++) {
+        x[i] = (float)rand() / RAND_MAX - 0.5f + sinf(0.02f * i);
+    }
+    for (int f = 0 ; f < 4 ; f++) {
+        float w[2] = {0};
+        float w_ref[2] = {0};
+        float y_max = 0;
+        int pos = 0;
+        for (int b = 0 ; b < sizeof(blocks) / sizeof(int) ; b++) {
+            dsps_biquad_f32_ansi(&x[pos], &y_ref[pos], blocks[b], coeffs[f], w_ref);
+            TEST_ESP_OK(dsps_biquad_f32_x86(&x[pos], &y[pos], blocks[b], coeffs[f], w));
+            pos += blocks[b];
+        }
+        for (int i = 0 ; i < len ; i++) {
+            y_max = fmaxf(y_max, fabsf(y_ref[i]));
+        }
+        // Solving the recursion by blocks changes the rounding only: for the low cutoff filter, both
+        // versions differ from a double precision one by about 3e-5 * y_max
+        for (int i = 0 ; i < len ; i++) {
+            TEST_ASSERT_FLOAT_WITHIN(1e-4 * y_max, y_ref[i], y[i]);
+        }
+        // In place
+        memcpy(y, x, sizeof(y));
+        w[0] = w[1] = 0;
+        dsps_biquad_f32_x86(y, y, len, coeffs[f], w);
+        for (int i = 0 ; i < len ; i++) {
+            TEST_ASSERT_FLOAT_WITHIN(1e-4 * y_max, y_ref[i], y[i]);
+        }
+    }
+}
+
+TEST_CASE("dsps_biquad_f32_x86 benchmark", "[dsps]")
+{
+    int len = sizeof(x) / sizeof(float);
+    int repeat_count = 1024;
+    float coeffs[5];
+    float w[2] = {0};
+    dsps_biquad_gen_lpf_f32(coeffs, 0.1, 0.7);
+
+    unsigned int start_b = xthal_get_ccount();
+    for (int i = 0 ; i < repeat_count ; i++) {
+        dsps_biquad_f32_ansi(x, y, len, coeffs, w);
+    }
+    unsigned int end_b = xthal_get_ccount();
+    float cycles_ansi = (float)(end_b - start_b) / repeat_count;
+
+    start_b = xthal_get_ccount();
+    for (int i = 0 ; i < repeat_count ; i++) {
+        dsps_biquad_f32_x86(x, y, len, coeffs, w);
+    }
+    end_b = xthal_get_ccount();
+    float cycles_x86 = (float)(end_b - start_b) / repeat_count;
+
+    ESP_LOGI(TAG, "%i samples: ansi %f cycles, x86 %f cycles (x%.1f)", len, cycles_ansi, cycles_x86, cycles_ansi / cycles_x86);
+    TEST_ASSERT_EXEC_IN_RANGE(1, cycles_ansi, cycles_x86);
+}
+
+#endif // dsps_biquad_f32_x86_enabled
@@ -0,0 +1,167 @@
+// Copyright 2018-2024 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <string.h>
+#include "unity.h"
+#include "dsp_platform.h"
+#include "esp_log.h"
+
+#include "dsp_common.h"
+#include "dsps_d_gen.h"
+#include "dsps_tone_gen.h"
+#include "dsps_biquad_gen.h"
+#include "dsps_biquad.h"
+
+static const char *TAG = "dsps_biquad_sos_f32_ansi";
+static const int sos_len = 1024;
+#define SOS_TEST_MAX 12
+
+TEST_CASE("dsps_biquad_sos_f32_ansi functionality", "[dsps]")
+{
+    float *x = calloc(sos_len, sizeof(float));
+    float *y = calloc(sos_len, sizeof(float));
+    float *z = calloc(sos_len, sizeof(float));
+    TEST_ASSERT_NOT_NULL(x);
+    TEST_ASSERT_NOT_NULL(y);
+    TEST_ASSERT_NOT_NULL(z);
+
+    float coeffs[SOS_TEST_MAX * 5];
+    float w1[SOS_TEST_MAX * 2];
+    float w2[SOS_TEST_MAX * 2];
+    // Low pass, band pass and notch sections, more sections than processed in one pass
+    for (int n_sos = 1 ; n_sos <= SOS_TEST_MAX ; n_sos++) {
+        for (int s = 0 ; s < n_sos ; s++) {
+            switch (s % 3) {
+            case 0:
+                dsps_biquad_gen_lpf_f32(&coeffs[s * 5], 0.1, 0.5 + s * 0.1);
+                break;
+            case 1:
+                dsps_biquad_gen_bpf0db_f32(&coeffs[s * 5], 0.05, 0.7);
+                break;
+            default:
+                dsps_biquad_gen_notch_f32(&coeffs[s * 5], 0.1, -120, 5);
+                break;
+            }
+        }
+        memset(w1, 0, sizeof(w1));
+        memset(w2, 0, sizeof(w2));
+        // Two blocks to check the state is kept between calls
+        for (int block = 0 ; block < 2 ; block++) {
+            dsps_d_gen_f32(x, sos_len, block * 7);
+            dsps_biquad_sos_f32_ansi(x, y, sos_len, coeffs, w1, n_sos);
+            dsps_biquad_f32_ansi(x, z, sos_len, coeffs, w2);
+            for (int s = 1 ; s < n_sos ; s++) {
+                dsps_biquad_f32_ansi(z, z, sos_len, &coeffs[s * 5], &w2[s * 2]);
+            }
+            for (int i = 0 ; i < sos_len ; i++) {
+                if (y[i] != z[i]) {
+                    ESP_LOGE(TAG, "n_sos=%i [%i]calc = %f, expected=%f", n_sos, i, y[i], z[i]);
+                    TEST_ASSERT_EQUAL( y[i], z[i]);
+                }
+            }
+        }
+        for (int i = 0 ; i < n_sos * 2 ; i++) {
+            TEST_ASSERT_EQUAL( w1[i], w2[i]);
+        }
+    }
+    free(x);
+    free(y);
+    free(z);
+}
+
+TEST_CASE("dsps_biquad_sos_mc_f32_ansi functionality", "[dsps]")
+{
+    const int max_ch = 6;
+    float *x = calloc(sos_len * max_ch, sizeof(float));
+    float *y = calloc(sos_len * max_ch, sizeof(float));
+    float *z = calloc(sos_len, sizeof(float));
+    TEST_ASSERT_NOT_NULL(x);
+    TEST_ASSERT_NOT_NULL(y);
+    TEST_ASSERT_NOT_NULL(z);
+
+    float coeffs[SOS_TEST_MAX * 5];
+    float w1[SOS_TEST_MAX * 2 * max_ch];
+    float w2[SOS_TEST_MAX * 2];
+    for (int s = 0 ; s < SOS_TEST_MAX ; s++) {
+        dsps_biquad_gen_lpf_f32(&coeffs[s * 5], 0.1, 0.5 + s * 0.1);
+    }
+    dsps_tone_gen_f32(x, sos_len * max_ch, 1, 0.05, 0);
+    // Each channel of the interleaved buffer filtered in place must match the contiguous cascade,
+    // for channel counts below, equal to and above the channels of one pass
+    for (int n_ch = 1 ; n_ch <= max_ch ; n_ch++) {
+        for (int n_sos = 1 ; n_sos <= SOS_TEST_MAX ; n_sos++) {
+            memcpy(y, x, sos_len * n_ch * sizeof(float));
+            memset(w1, 0, sizeof(w1));
+            dsps_biquad_sos_mc_f32_ansi(y, y, sos_len, n_ch, coeffs, w1, n_sos);
+            for (int ch = 0 ; ch < n_ch ; ch++) {
+                memset(w2, 0, sizeof(w2));
+                for (int i = 0 ; i < sos_len ; i++) {
+                    z[i] = x[i * n_ch + ch];
+                }
+                dsps_biquad_sos_f32_ansi(z, z, sos_len, coeffs, w2, n_sos);
+                for (int i = 0 ; i < sos_len ; i++) {
+                    if (y[i * n_ch + ch] != z[i]) {
+                        ESP_LOGE(TAG, "n_ch=%i n_sos=%i ch=%i [%i]calc = %f, expected=%f", n_ch, n_sos, ch, i, y[i * n_ch + ch], z[i]);
+                        TEST_ASSERT_EQUAL( y[i * n_ch + ch], z[i]);
+                    }
+                }
+                for (int i = 0 ; i < n_sos * 2 ; i++) {
+                    TEST_ASSERT_EQUAL( w1[ch * n_sos * 2 + i], w2[i]);
+                }
+            }
+        }
+    }
+    free(x);
+    free(y);
+    free(z);
+}
+
+TEST_CASE("dsps_biquad_sos_f32_ansi benchmark", "[dsps]")
+{
+    float *x = calloc(sos_len, sizeof(float));
+    float *y = calloc(sos_len, sizeof(float));
+    TEST_ASSERT_NOT_NULL(x);
+    TEST_ASSERT_NOT_NULL(y);
+
+    float coeffs[4 * 5];
+    float w[4 * 2] = {0};
+    int repeat_count = 64;
+    dsps_tone_gen_f32(x, sos_len, 1, 0.05, 0);
+    for (int s = 0 ; s < 4 ; s++) {
+        dsps_biquad_gen_lpf_f32(&coeffs[s * 5], 0.1, 0.5 + s * 0.5);
+    }
+
+    for (int n_sos = 1 ; n_sos <= 4 ; n_sos++) {
+        unsigned int start_b = dsp_get_cpu_cycle_count();
+        for (int i = 0 ; i < repeat_count ; i++) {
+            dsps_biquad_sos_f32_ansi(x, y, sos_len, coeffs, w, n_sos);
+        }
+        unsigned int end_b = dsp_get_cpu_cycle_count();
+        float cycles = (float)(end_b - start_b) / (sos_len * repeat_count);
+
+        start_b = dsp_get_cpu_cycle_count();
+        for (int i = 0 ; i < repeat_count ; i++) {
+            dsps_biquad_f32_ansi(x, y, sos_len, coeffs, w);
+            for (int s = 1 ; s < n_sos ; s++) {
+                dsps_biquad_f32_ansi(y, y, sos_len, &coeffs[s * 5], &w[s * 2]);
+            }
+        }
+        end_b = dsp_get_cpu_cycle_count();
+        float cycles_cascade = (float)(end_b - start_b) / (sos_len * repeat_count);
+
+        ESP_LOGI(TAG, "%i sections: dsps_biquad_sos_f32_ansi - %f per sample, dsps_biquad_f32_ansi cascade - %f per sample", n_sos, cycles, cycles_cascade);
+    }
+    free(x);
+    free(y);
+}
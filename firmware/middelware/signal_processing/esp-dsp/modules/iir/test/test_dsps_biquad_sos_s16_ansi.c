@@ -0,0 +1,188 @@
+// Copyright 2018-2024 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <string.h>
+#include <math.h>
+#include "unity.h"
+#include "dsp_platform.h"
+#include "esp_log.h"
+
+#include "dsp_common.h"
+#include "dsps_tone_gen.h"
+#include "dsps_biquad_gen.h"
+#include "dsps_biquad.h"
+
+static const char *TAG = "dsps_biquad_sos_s16_ansi";
+static const int s16_len = 4096;
+
+// 4th order Butterworth sections
+static const float bw4_q[2] = {1 / 0.765, 1 / 1.848};
+// 8th order Butterworth sections
+static const float bw8_q[4] = {1 / 0.390, 1 / 1.111, 1 / 1.663, 1 / 1.962};
+
+static void coef_to_q30(const float *coef, int32_t *coef_q30, int len)
+{
+    for (int i = 0 ; i < len ; i++) {
+        coef_q30[i] = (int32_t)lroundf(coef[i] * (float)(1 << DSPS_BIQUAD_S16_COEF_SHIFT));
+    }
+}
+
+TEST_CASE("dsps_biquad_sos_s16_ansi noise floor", "[dsps]")
+{
+    int16_t *x = calloc(s16_len, sizeof(int16_t));
+    int16_t *y = calloc(s16_len, sizeof(int16_t));
+    float *xf = calloc(s16_len, sizeof(float));
+    float *yf = calloc(s16_len, sizeof(float));
+    TEST_ASSERT_NOT_NULL(x);
+    TEST_ASSERT_NOT_NULL(y);
+    TEST_ASSERT_NOT_NULL(xf);
+    TEST_ASSERT_NOT_NULL(yf);
+
+    const float ratios[] = {0.001, 0.003, 0.01, 0.03, 0.1, 0.2, 0.3, 0.45};
+    for (int r = 0 ; r < sizeof(ratios) / sizeof(float) ; r++) {
+        float coef[2 * 5];
+        int32_t coef_q30[2 * 5];
+        float wf[2 * 2] = {0};
+        int32_t w[2 * DSPS_BIQUAD_S16_STATE_SIZE] = {0};
+        for (int s = 0 ; s < 2 ; s++) {
+            dsps_biquad_gen_lpf_f32(&coef[s * 5], ratios[r], bw4_q[s]);
+        }
+        coef_to_q30(coef, coef_q30, 2 * 5);
+        // Pass band tone plus a DC step, half of full scale
+        dsps_tone_gen_f32(xf, s16_len, 0.25, ratios[r] / 2, 0);
+        for (int i = 0 ; i < s16_len ; i++) {
+            x[i] = (int16_t)lroundf((xf[i] + 0.25) * INT16_MAX);
+            xf[i] = x[i] / 32768.0f;
+        }
+        dsps_biquad_sos_s16_ansi(x, y, s16_len, coef_q30, w, 2);
+        dsps_biquad_sos_f32_ansi(xf, yf, s16_len, coef, wf, 2);
+        float err = 0;
+        float pow = 0;
+        for (int i = 0 ; i < s16_len ; i++) {
+            float e = y[i] / 32768.0f - yf[i];
+            err += e * e;
+            pow += yf[i] * yf[i];
+        }
+        float noise_db = 10 * log10f(err / s16_len + 1e-20);
+        float snr_db = 10 * log10f(pow / (err + 1e-20));
+        ESP_LOGI(TAG, "fc/fs = %5.3f: noise floor %6.1f dBFS, SNR %5.1f dB", ratios[r], noise_db, snr_db);
+        // Q15 rounding of the output alone gives -101 dBFS, poles close to
+        // the unit circle (fc/fs = 0.001) lose a few dB to the Q30 coefficients
+        TEST_ASSERT_LESS_THAN(-85, noise_db);
+    }
+    free(x);
+    free(y);
+    free(xf);
+    free(yf);
+}
+
+TEST_CASE("dsps_biquad_sos_s16_ansi overflow", "[dsps]")
+{
+    int16_t *x = calloc(s16_len, sizeof(int16_t));
+    int16_t *y = calloc(s16_len, sizeof(int16_t));
+    float *xf = calloc(s16_len, sizeof(float));
+    float *yf = calloc(s16_len, sizeof(float));
+    TEST_ASSERT_NOT_NULL(x);
+    TEST_ASSERT_NOT_NULL(y);
+    TEST_ASSERT_NOT_NULL(xf);
+    TEST_ASSERT_NOT_NULL(yf);
+
+    const float ratios[] = {0.001, 0.01, 0.1, 0.3, 0.45};
+    for (int r = 0 ; r < sizeof(ratios) / sizeof(float) ; r++) {
+        float coef[4 * 5];
+        int32_t coef_q30[4 * 5];
+        float wf[4 * 2] = {0};
+        int32_t w[4 * DSPS_BIQUAD_S16_STATE_SIZE] = {0};
+        for (int s = 0 ; s < 4 ; s++) {
+            dsps_biquad_gen_lpf_f32(&coef[s * 5], ratios[r], bw8_q[s]);
+        }
+        coef_to_q30(coef, coef_q30, 4 * 5);
+        // Full scale square wave: the filter overshoot exceeds the Q15 range
+        int period = (int)(4 / ratios[r]);
+        for (int i = 0 ; i < s16_len ; i++) {
+            x[i] = ((i / (period / 2 + 1)) % 2) ? INT16_MIN : INT16_MAX;
+            xf[i] = x[i] / 32768.0f;
+        }
+        dsps_biquad_sos_s16_ansi(x, y, s16_len, coef_q30, w, 4);
+        dsps_biquad_sos_f32_ansi(xf, yf, s16_len, coef, wf, 4);
+        int saturated = 0;
+        float max_err = 0;
+        for (int i = 0 ; i < s16_len ; i++) {
+            // Saturate the reference as the output must be
+            float ref = yf[i];
+            if (ref >= 1) {
+                ref = INT16_MAX / 32768.0f;
+                saturated++;
+            } else if (ref < -1) {
+                ref = -1;
+                saturated++;
+            }
+            float e = fabsf(y[i] / 32768.0f - ref);
+            if (e > max_err) {
+                max_err = e;
+            }
+        }
+        ESP_LOGI(TAG, "fc/fs = %5.3f: %4i saturated samples, max error %f", ratios[r], saturated, max_err);
+        // No wrap around: the output follows the saturated reference
+        TEST_ASSERT_LESS_THAN(0.001, max_err);
+    }
+    free(x);
+    free(y);
+    free(xf);
+    free(yf);
+}
+
+TEST_CASE("dsps_biquad_sos_s16_ansi benchmark", "[dsps]")
+{
+    int16_t *x = calloc(s16_len, sizeof(int16_t));
+    int16_t *y = calloc(s16_len, sizeof(int16_t));
+    float *xf = calloc(s16_len, sizeof(float));
+    float *yf = calloc(s16_len, sizeof(float));
+    TEST_ASSERT_NOT_NULL(x);
+    TEST_ASSERT_NOT_NULL(y);
+    TEST_ASSERT_NOT_NULL(xf);
+    TEST_ASSERT_NOT_NULL(yf);
+
+    float coef[4 * 5];
+    int32_t coef_q30[4 * 5];
+    float wf[4 * 2] = {0};
+    int32_t w[4 * DSPS_BIQUAD_S16_STATE_SIZE] = {0};
+    for (int s = 0 ; s < 4 ; s++) {
+        dsps_biquad_gen_lpf_f32(&coef[s * 5], 0.1, bw8_q[s]);
+    }
+    coef_to_q30(coef, coef_q30, 4 * 5);
+    dsps_tone_gen_f32(xf, s16_len, 0.5, 0.05, 0);
+    for (int i = 0 ; i < s16_len ; i++) {
+        x[i] = (int16_t)(xf[i] * INT16_MAX);
+    }
+
+    unsigned int start_b = dsp_get_cpu_cycle_count();
+    dsps_biquad_sos_s16_ansi(x, y, s16_len, coef_q30, w, 4);
+    unsigned int end_b = dsp_get_cpu_cycle_count();
+    float cycles = (float)(end_b - start_b) / s16_len;
+
+    start_b = dsp_get_cpu_cycle_count();
+    dsps_biquad_f32_ansi(xf, yf, s16_len, coef, wf);
+    for (int s = 1 ; s < 4 ; s++) {
+        dsps_biquad_f32_ansi(yf, yf, s16_len, &coef[s * 5], &wf[s * 2]);
+    }
+    end_b = dsp_get_cpu_cycle_count();
+    float cycles_f32 = (float)(end_b - start_b) / s16_len;
+
+    ESP_LOGI(TAG, "8th order: dsps_biquad_sos_s16_ansi - %f per sample, dsps_biquad_f32_ansi - %f per sample", cycles, cycles_f32);
+    free(x);
+    free(y);
+    free(xf);
+    free(yf);
+}
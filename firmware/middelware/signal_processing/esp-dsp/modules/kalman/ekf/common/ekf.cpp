@@ -14,6 +14,11 @@
 
 #include "ekf.h"
 #include <float.h>
+#include "esp_log.h"
+
+// Scratch arena size (floats). With x = 13, w = 18 the dense Process() peaks at 1660 floats,
+// UpdateRef() at 1400; beyond it matrices are allocated from the heap.
+#define EKF_SCRATCH_LENGTH(x, w) (8 * (x) * (x) + 4 * (x) * (w))
 
 ekf::ekf(int x, int w) : NUMX(x),
     NUMW(w),
@@ -22,7 +27,8 @@ ekf::ekf(int x, int w) : NUMX(x),
     F(*new dspm::Mat(x, x)),
     G(*new dspm::Mat(x, w)),
     P(*new dspm::Mat(x, x)),
-    Q(*new dspm::Mat(w, w))
+    Q(*new dspm::Mat(w, w)),
+    scratch(new float[EKF_SCRATCH_LENGTH(x, w)], EKF_SCRATCH_LENGTH(x, w))
 {
 
     this->P *= 0;
@@ -47,13 +53,16 @@ ekf::~ekf()
 
     delete this->HP;
     delete this->Km;
+    delete[] this->scratch.buffer;
 }
 
 void ekf::Process(float *u, float dt)
 {
+    this->scratch.bind();
     this->LinearizeFG(this->X, (float *)u);
     this->RungeKutta(this->X, u, dt);
     this->CovariancePrediction(dt);
+    this->scratch.unbind();
 }
 
 void ekf::RungeKutta(dspm::Mat &x, float *U, float dt)
@@ -187,15 +196,20 @@ void ekf::Update(dspm::Mat &H, float *measured, float *expected, float *R)
 
 void ekf::UpdateRef(dspm::Mat &H, float *measured, float *expected, float *R)
 {
-    dspm::Mat h_t = H.t();
-    dspm::Mat S = H * P * h_t; // +diag(R);
+    this->scratch.bind();
+    dspm::Mat h_p = H * P;
+    dspm::Mat S = h_p * H.t(); // +diag(R);
     for (size_t i = 0; i < H.rows; i++) {
         S(i, i) += R[i];
     }
 
-    dspm::Mat S_ = S.pinv(); // 1 / S
-
-    dspm::Mat K = (P * h_t) * S_;
+    // K = P*H'/S, solved as K' = S\(H*P) since S and P are symmetric
+    if (!S.choleskyDecompose()) {
+        ESP_LOGW("ekf", "UpdateRef: innovation covariance is not positive definite");
+        this->scratch.unbind();
+        return;
+    }
+    dspm::Mat K = S.choleskySolve(h_p).t();
     this->P = (dspm::Mat::eye(this->NUMX) - K * H) * P;
 
     dspm::Mat Y(measured, H.rows, 1);
@@ -203,6 +217,7 @@ void ekf::UpdateRef(dspm::Mat &H, float *measured, float *expected, float *R)
 
     dspm::Mat Err = Y - Z;
     this->X += (K * Err);
+    this->scratch.unbind();
 }
 
 dspm::Mat ekf::quat2rotm(float q[4])
@@ -159,6 +159,12 @@ public:
     */
     float *Km;
 
+    /**
+     * Scratch arena for the temporary matrices of Process() and the measurement updates.
+     * Set scratch.length to 0 to allocate them from the heap.
+    */
+    dspm::Mat::Arena scratch;
+
 public:
     // Additional universal helper methods
     /**
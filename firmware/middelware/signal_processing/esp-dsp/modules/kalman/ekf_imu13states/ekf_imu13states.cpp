@@ -14,11 +14,15 @@
 
 #include "ekf_imu13states.h"
 
+#define NUM_STATES 13
+#define NUM_NOISE  18
+
 ekf_imu13states::ekf_imu13states() : ekf(13, 18),
     mag0(3, 1),
     accel0(3, 1)
 {
     this->NUMU = 3;
+    this->IndexFG();
 }
 
 ekf_imu13states::~ekf_imu13states()
@@ -100,6 +104,84 @@ void ekf_imu13states::LinearizeFG(dspm::Mat &x, float *u)
     G.Copy(dspm::Mat::eye(3), 10, 15); // random noise offset constant
 }
 
+void ekf_imu13states::IndexFG()
+{
+    // Probe state and input with no zero terms: unit quaternion (1, 2, 3, 4) / sqrt(30), gyro biases
+    // different from the rates
+    float x_data[NUM_STATES] = {0};
+    float u[3] = {0.3, 0.5, 0.7};
+    for (int i = 0; i < 4; i++) {
+        x_data[i] = (i + 1) / std::sqrt(30.0f);
+    }
+    x_data[4] = 0.01;
+    x_data[5] = 0.02;
+    x_data[6] = 0.03;
+    dspm::Mat x(x_data, NUM_STATES, 1);
+    this->LinearizeFG(x, u);
+
+    for (int i = 0; i < NUM_STATES; i++) {
+        this->phi_count[i] = 0;
+        for (int a = 0; a < NUM_STATES; a++) {
+            if ((this->F(i, a) != 0) || (i == a)) {
+                this->phi_index[i][this->phi_count[i]++] = a;
+            }
+        }
+        this->g_count[i] = 0;
+        for (int a = 0; a < NUM_NOISE; a++) {
+            if (this->G(i, a) != 0) {
+                this->g_index[i][this->g_count[i]++] = a;
+            }
+        }
+    }
+    this->F *= 0;
+    this->G *= 0;
+}
+
+void ekf_imu13states::CovariancePrediction(float dt)
+{
+    // M = Phi*P, GQ = dt^2*G*Q, from the scratch arena bound by Process()
+    dspm::Mat M(NUM_STATES, NUM_STATES);
+    dspm::Mat GQ(NUM_STATES, NUM_NOISE);
+    for (int i = 0; i < NUM_STATES; i++) {
+        float *m_row = &M.data[i * M.stride];
+        for (int k = 0; k < this->phi_count[i]; k++) {
+            int a = this->phi_index[i][k];
+            float phi = this->F(i, a) * dt + ((i == a) ? 1 : 0);
+            const float *p_row = &this->P.data[a * this->P.stride];
+            for (int j = 0; j < NUM_STATES; j++) {
+                m_row[j] += phi * p_row[j];
+            }
+        }
+        float *gq_row = &GQ.data[i * GQ.stride];
+        for (int k = 0; k < this->g_count[i]; k++) {
+            int a = this->g_index[i][k];
+            float g = dt * dt * this->G(i, a);
+            const float *q_row = &this->Q.data[a * this->Q.stride];
+            for (int j = 0; j < NUM_NOISE; j++) {
+                gq_row[j] += g * q_row[j];
+            }
+        }
+    }
+
+    // P = M*Phi' + GQ*G', upper triangle
+    for (int i = 0; i < NUM_STATES; i++) {
+        const float *m_row = &M.data[i * M.stride];
+        const float *gq_row = &GQ.data[i * GQ.stride];
+        for (int j = i; j < NUM_STATES; j++) {
+            float sum = 0;
+            for (int k = 0; k < this->phi_count[j]; k++) {
+                int a = this->phi_index[j][k];
+                sum += m_row[a] * (this->F(j, a) * dt + ((j == a) ? 1 : 0));
+            }
+            for (int k = 0; k < this->g_count[j]; k++) {
+                int a = this->g_index[j][k];
+                sum += gq_row[a] * this->G(j, a);
+            }
+            this->P(i, j) = this->P(j, i) = sum;
+        }
+    }
+}
+
 void ekf_imu13states::Test()
 {
     dspm::Mat test_x(7, 1);
@@ -186,8 +268,9 @@ void ekf_imu13states::TestFull(bool enable_att)
 
 void ekf_imu13states::UpdateRefMeasurement(float *accel_data, float *magn_data, float R[6])
 {
+    this->scratch.bind();
     dspm::Mat quat(this->X.data, 4, 1);
-    dspm::Mat H = 0 * dspm::Mat(6, this->NUMX);
+    dspm::MatFixed<6, 13> H;
     dspm::Mat Re = this->quat2rotm(quat.data).t();
 
     // dAccel/dq
@@ -214,12 +297,14 @@ void ekf_imu13states::UpdateRefMeasurement(float *accel_data, float *magn_data,
 
     this->Update(H, measured_data, expected_data, R);
     quat /= quat.norm();
+    this->scratch.unbind();
 }
 
 void ekf_imu13states::UpdateRefMeasurementMagn(float *accel_data, float *magn_data, float R[6])
 {
+    this->scratch.bind();
     dspm::Mat quat(this->X.data, 4, 1);
-    dspm::Mat H = 0 * dspm::Mat(6, this->NUMX);
+    dspm::MatFixed<6, 13> H;
     dspm::Mat Re = this->quat2rotm(quat.data).t();
 
     // We include these two line to update magnetometer initial state
@@ -250,12 +335,14 @@ void ekf_imu13states::UpdateRefMeasurementMagn(float *accel_data, float *magn_da
 
     this->Update(H, measured_data, expected_data, R);
     quat /= quat.norm();
+    this->scratch.unbind();
 }
 
 void ekf_imu13states::UpdateRefMeasurement(float *accel_data, float *magn_data, float *attitude, float R[10])
 {
+    this->scratch.bind();
     dspm::Mat quat(this->X.data, 4, 1);
-    dspm::Mat H = 0 * dspm::Mat(10, this->NUMX);
+    dspm::MatFixed<10, 13> H;
     dspm::Mat Re = this->quat2rotm(quat.data).t();
 
     H.Copy(Re, 0, 7);
@@ -290,4 +377,5 @@ void ekf_imu13states::UpdateRefMeasurement(float *accel_data, float *magn_data,
 
     this->Update(H, measured_data, expected_data, R);
     quat /= quat.norm();
+    this->scratch.unbind();
 }
@@ -39,6 +39,15 @@ public:
     virtual dspm::Mat StateXdot(dspm::Mat &x, float *u);
     virtual void LinearizeFG(dspm::Mat &x, float *u);
 
+    /**
+     * Covariance prediction P = Phi*P*Phi' + dt^2*G*Q*G', where Phi = I + F*dt.
+     * Only the structurally non zero elements of Phi and G are used (F and G are mostly zero
+     * blocks, indexed once by the constructor) and only the upper triangle of the symmetric
+     * matrix P is calculated. The temporary products come from the scratch arena.
+     * @param[in] dt: time interval from last update
+     */
+    virtual void CovariancePrediction(float dt);
+
     /**
     *     Method for development and tests only.
     */
@@ -93,6 +102,23 @@ public:
      */
     void UpdateRefMeasurement(float *accel_data, float *magn_data, float *attitude, float R[10]);
 
+private:
+    /**
+     * Index the structurally non zero elements of Phi and G: LinearizeFG() with a state
+     * and an input that have no zero terms.
+     */
+    void IndexFG();
+
+    /**
+     * Number of structurally non zero elements of each row of Phi = I + F*dt, and their columns
+     */
+    int phi_count[13];
+    uint8_t phi_index[13][13];
+    /**
+     * Number of structurally non zero elements of each row of G, and their columns
+     */
+    int g_count[13];
+    uint8_t g_index[13][18];
 };
 
 #endif // _ekf_imu13states_H_
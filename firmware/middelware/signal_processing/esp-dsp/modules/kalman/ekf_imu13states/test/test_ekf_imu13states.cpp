@@ -58,3 +58,127 @@ TEST_CASE("ekf_imu13states functionality gyro and magn", "[dspm]")
     printf("Expected result = %i, calculated result = %i\n", 200, (int)(1000 * ekf13->X.data[5] + 0.5));
     printf("Expected result = %i, calculated result = %i\n", 300, (int)(1000 * ekf13->X.data[6] + 0.5));
 }
+
+TEST_CASE("ekf_imu13states Process benchmark", "[dspm]")
+{
+    const int repeat = 1000;
+    float u[] = {0.1, 0.2, 0.3};
+    float dt = 0.01;
+    float x_arena[13];
+    unsigned int cycles[2];
+    int allocations[2];
+
+    // First pass with the scratch arena, second pass with heap allocations
+    for (int pass = 0; pass < 2; pass++) {
+        ekf_imu13states *ekf13 = new ekf_imu13states();
+        ekf13->Init();
+        int scratch_length = ekf13->scratch.length;
+        if (pass == 1) {
+            ekf13->scratch.length = 0;
+        }
+        unsigned int start_b = xthal_get_ccount();
+        for (int n = 0; n < repeat; n++) {
+            ekf13->Process(u, dt);
+        }
+        unsigned int end_b = xthal_get_ccount();
+        cycles[pass] = (end_b - start_b) / repeat;
+        allocations[pass] = (ekf13->scratch.allocations + ekf13->scratch.heap_allocations) / repeat;
+        if (pass == 0) {
+            ESP_LOGI(TAG, "Arena: %i floats used of %i", ekf13->scratch.peak, scratch_length);
+            TEST_ASSERT_EQUAL(0, ekf13->scratch.heap_allocations);
+            memcpy(x_arena, ekf13->X.data, sizeof(x_arena));
+        } else {
+            TEST_ASSERT_EQUAL(0, ekf13->scratch.allocations);
+            for (int i = 0; i < 13; i++) {
+                TEST_ASSERT_EQUAL_FLOAT(x_arena[i], ekf13->X.data[i]);
+            }
+        }
+        ekf13->scratch.length = scratch_length;
+        delete ekf13;
+    }
+    TEST_ASSERT_EQUAL(allocations[0], allocations[1]);
+    ESP_LOGI(TAG, "Process(): %i matrix allocations, %i cycles with arena, %i cycles with heap", allocations[0], cycles[0], cycles[1]);
+}
+
+TEST_CASE("ekf_imu13states UpdateRef matches Update", "[dspm]")
+{
+    // With uncorrelated measurements (diagonal R), the joint update solved by Cholesky (UpdateRef)
+    // and the sequential scalar update (Update) give the same result
+    ekf_imu13states *ekf_seq = new ekf_imu13states();
+    ekf_imu13states *ekf_ref = new ekf_imu13states();
+    ekf_seq->Init();
+    float u[] = {0.1, 0.2, 0.3};
+    for (int n = 0; n < 50; n++) {
+        ekf_seq->Process(u, 0.01);
+    }
+    ekf_ref->X = ekf_seq->X;
+    ekf_ref->P = ekf_seq->P;
+
+    dspm::MatFixed<6, 13> H;
+    float measured[6];
+    float expected[6];
+    float R[6];
+    srand(1);
+    for (int i = 0; i < 6 * 13; i++) {
+        H.data[i] = 2.0f * rand() / RAND_MAX - 1;
+    }
+    for (int i = 0; i < 6; i++) {
+        measured[i] = 0.1f * i;
+        expected[i] = 0;
+        R[i] = 0.01;
+    }
+    ekf_seq->Update(H, measured, expected, R);
+    ekf_ref->UpdateRef(H, measured, expected, R);
+
+    for (int i = 0; i < 13; i++) {
+        TEST_ASSERT_FLOAT_WITHIN(1e-4, ekf_seq->X.data[i], ekf_ref->X.data[i]);
+        for (int j = 0; j < 13; j++) {
+            TEST_ASSERT_FLOAT_WITHIN(1e-4, ekf_seq->P(i, j), ekf_ref->P(i, j));
+        }
+    }
+    delete ekf_seq;
+    delete ekf_ref;
+}
+
+// Reference filter with the dense covariance prediction of the base class
+class ekf_imu13states_dense: public ekf_imu13states {
+public:
+    virtual void CovariancePrediction(float dt)
+    {
+        ekf::CovariancePrediction(dt);
+    }
+};
+
+TEST_CASE("ekf_imu13states sparse covariance prediction", "[dspm]")
+{
+    const int steps = 500;
+    ekf_imu13states *ekf_filter[2] = {new ekf_imu13states(), new ekf_imu13states_dense()};
+    unsigned int cycles[2];
+    float dt = 0.01;
+    float R[6] = {0.01, 0.01, 0.01, 0.01, 0.01, 0.01};
+
+    for (int f = 0; f < 2; f++) {
+        ekf_filter[f]->Init();
+        unsigned int start_b = xthal_get_ccount();
+        for (int n = 0; n < steps; n++) {
+            // Slow rotation around all axes, gyro with constant bias
+            float angle = 0.5f * n * dt;
+            float u[] = {0.1f + 0.5f * cosf(angle), 0.2f, 0.3f - 0.5f * sinf(angle)};
+            float accel[] = {sinf(angle), 0, cosf(angle)};
+            float magn[] = {cosf(angle), sinf(angle), 0};
+            ekf_filter[f]->Process(u, dt);
+            ekf_filter[f]->UpdateRefMeasurement(accel, magn, R);
+        }
+        cycles[f] = (xthal_get_ccount() - start_b) / steps;
+    }
+
+    for (int i = 0; i < 13; i++) {
+        TEST_ASSERT_FLOAT_WITHIN(1e-4, ekf_filter[1]->X.data[i], ekf_filter[0]->X.data[i]);
+        for (int j = 0; j < 13; j++) {
+            TEST_ASSERT_FLOAT_WITHIN(1e-5, ekf_filter[1]->P(i, j), ekf_filter[0]->P(i, j));
+        }
+    }
+    ESP_LOGI(TAG, "Process() + UpdateRefMeasurement(): %i cycles sparse, %i cycles dense", cycles[0], cycles[1]);
+    delete ekf_filter[0];
+    delete ekf_filter[1];
+}
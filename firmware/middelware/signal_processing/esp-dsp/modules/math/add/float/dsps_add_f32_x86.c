@@ -0,0 +1,44 @@
+// Copyright 2018-2019 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dsps_add.h"
+
+#if (dsps_add_f32_x86_enabled == 1)
+#include "dsp_x86.h"
+
+esp_err_t dsps_add_f32_x86(const float *input1, const float *input2, float *output, int len, int step1, int step2, int step_out)
+{
+    if (NULL == input1) {
+        return ESP_ERR_DSP_PARAM_OUTOFRANGE;
+    }
+    if (NULL == input2) {
+        return ESP_ERR_DSP_PARAM_OUTOFRANGE;
+    }
+    if (NULL == output) {
+        return ESP_ERR_DSP_PARAM_OUTOFRANGE;
+    }
+
+    int i = 0;
+    if ((step1 == 1) && (step2 == 1) && (step_out == 1)) {
+        for (; i <= len - DSP_X86_LANES ; i += DSP_X86_LANES) {
+            dsp_x86_store(&output[i], dsp_x86_add(dsp_x86_load(&input1[i]), dsp_x86_load(&input2[i])));
+        }
+    }
+    for (; i < len ; i++) {
+        output[i * step_out] = input1[i * step1] + input2[i * step2];
+    }
+    return ESP_OK;
+}
+
+#endif // dsps_add_f32_x86_enabled
@@ -32,6 +32,7 @@ extern "C"
  * The function add one input array to another
  * out[i*step_out] = input1[i*step1] + input2[i*step2]; i=[0..len)
  * The implementation use ANSI C and could be compiled and run on any platform
+ * The extension (_x86) uses SSE2/AVX2 on host (x86) builds.
  *
  * @param[in] input1: input array 1
  * @param[in] input2: input array 2
@@ -47,6 +48,7 @@ extern "C"
  */
 esp_err_t dsps_add_f32_ansi(const float *input1, const float *input2, float *output, int len, int step1, int step2, int step_out);
 esp_err_t dsps_add_f32_ae32(const float *input1, const float *input2, float *output, int len, int step1, int step2, int step_out);
+esp_err_t dsps_add_f32_x86(const float *input1, const float *input2, float *output, int len, int step1, int step2, int step_out);
 
 esp_err_t dsps_add_s16_ansi(const int16_t *input1, const int16_t *input2, int16_t *output, int len, int step1, int step2, int step_out, int shift);
 esp_err_t dsps_add_s16_ae32(const int16_t *input1, const int16_t *input2, int16_t *output, int len, int step1, int step2, int step_out, int shift);
@@ -65,6 +67,8 @@ esp_err_t dsps_add_s8_aes3(const int8_t *input1, const int8_t *input2, int8_t *o
 
 #if (dsps_add_f32_ae32_enabled == 1)
 #define dsps_add_f32 dsps_add_f32_ae32
+#elif (dsps_add_f32_x86_enabled == 1)
+#define dsps_add_f32 dsps_add_f32_x86
 #else
 #define dsps_add_f32 dsps_add_f32_ansi
 #endif
@@ -28,5 +28,8 @@
 
 #endif // __XTENSA__
 
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__SSE2__)
+#define dsps_add_f32_x86_enabled 1
+#endif // __SSE2__
 
 #endif // _dsps_add_platform_H_
@@ -31,6 +31,7 @@ extern "C"
  * The function multiply one input array to another and store result to other array
  * out[i*step_out] = input1[i*step1] * input2[i*step2]; i=[0..len)
  * The implementation use ANSI C and could be compiled and run on any platform
+ * The extension (_x86) uses SSE2/AVX2 on host (x86) builds.
  *
  * @param[in] input1: input array 1
  * @param[in] input2: input array 2
@@ -46,6 +47,7 @@ extern "C"
  */
 esp_err_t dsps_mul_f32_ansi(const float *input1, const float *input2, float *output, int len, int step1, int step2, int step_out);
 esp_err_t dsps_mul_f32_ae32(const float *input1, const float *input2, float *output, int len, int step1, int step2, int step_out);
+esp_err_t dsps_mul_f32_x86(const float *input1, const float *input2, float *output, int len, int step1, int step2, int step_out);
 /**@}*/
 
 
@@ -87,6 +89,8 @@ esp_err_t dsps_mul_s8_aes3(const int8_t *input1, const int8_t *input2, int8_t *o
 
 #if (dsps_mul_f32_ae32_enabled == 1)
 #define dsps_mul_f32 dsps_mul_f32_ae32
+#elif (dsps_mul_f32_x86_enabled == 1)
+#define dsps_mul_f32 dsps_mul_f32_x86
 #else
 #define dsps_mul_f32 dsps_mul_f32_ansi
 #endif
@@ -27,4 +27,8 @@
 
 #endif // __XTENSA__
 
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__SSE2__)
+#define dsps_mul_f32_x86_enabled 1
+#endif // __SSE2__
+
 #endif // _dsps_mul_platform_H_
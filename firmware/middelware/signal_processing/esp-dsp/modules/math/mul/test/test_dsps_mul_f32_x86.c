@@ -0,0 +1,96 @@
+// Copyright 2018-2019 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <string.h>
+#include "unity.h"
+#include "dsp_platform.h"
+#include "esp_log.h"
+#include <malloc.h>
+
+#include "dsps_mul.h"
+#include "dsp_tests.h"
+
+#if (dsps_mul_f32_x86_enabled == 1)
+
+static const char *TAG = "dsps_mul_f32_x86";
+
+TEST_CASE("dsps_mul_f32_x86 functionality", "[dsps]")
+{
+    int n = 67;
+    float x[2 * n];
+    float y[2 * n];
+    float z[2 * n + 1];
+    float z_ref[2 * n + 1];
+
+    for (int i = 0 ; i < 2 * n ; i++) {
+        x[i] = (float)rand() / RAND_MAX - 0.5f;
+        y[i] = (float)rand() / RAND_MAX - 0.5f;
+    }
+    // Contiguous arrays (vector loop) of all the lenghts, then with steps (scalar loop)
+    for (int len = 0 ; len <= n ; len++) {
+        z[len] = z_ref[len] = 1000;
+        dsps_mul_f32_ansi(x, y, z_ref, len, 1, 1, 1);
+        TEST_ASSERT_EQUAL(ESP_OK, dsps_mul_f32_x86(x, y, z, len, 1, 1, 1));
+        TEST_ASSERT_EQUAL(0, memcmp(z, z_ref, (len + 1) * sizeof(float)));
+    }
+    dsps_mul_f32_ansi(x, y, z_ref, n, 2, 1, 2);
+    dsps_mul_f32_x86(x, y, z, n, 2, 1, 2);
+    for (int i = 0 ; i < n ; i++) {
+        TEST_ASSERT_EQUAL_FLOAT(x[2 * i] * y[i], z[2 * i]);
+        TEST_ASSERT_EQUAL(0, memcmp(&z[2 * i], &z_ref[2 * i], sizeof(float)));
+    }
+    // In place
+    memcpy(z, x, n * sizeof(float));
+    dsps_mul_f32_x86(z, y, z, n, 1, 1, 1);
+    for (int i = 0 ; i < n ; i++) {
+        TEST_ASSERT_EQUAL_FLOAT(x[i] * y[i], z[i]);
+    }
+}
+
+TEST_CASE("dsps_mul_f32_x86 benchmark", "[dsps]")
+{
+    int len = 1024;
+    int repeat_count = 1024;
+    float *x = (float *)malloc(len * sizeof(float));
+    float *y = (float *)malloc(len * sizeof(float));
+    float *z = (float *)malloc(len * sizeof(float));
+
+    for (int i = 0 ; i < len ; i++) {
+        x[i] = i;
+        y[i] = 1;
+    }
+
+    unsigned int start_b = xthal_get_ccount();
+    for (int i = 0 ; i < repeat_count ; i++) {
+        dsps_mul_f32_ansi(x, y, z, len, 1, 1, 1);
+    }
+    unsigned int end_b = xthal_get_ccount();
+    float cycles_ansi = (float)(end_b - start_b) / repeat_count;
+
+    start_b = xthal_get_ccount();
+    for (int i = 0 ; i < repeat_count ; i++) {
+        dsps_mul_f32_x86(x, y, z, len, 1, 1, 1);
+    }
+    end_b = xthal_get_ccount();
+    float cycles_x86 = (float)(end_b - start_b) / repeat_count;
+
+    ESP_LOGI(TAG, "%i samples: ansi %f cycles, x86 %f cycles (x%.1f)", len, cycles_ansi, cycles_x86, cycles_ansi / cycles_x86);
+    TEST_ASSERT_EXEC_IN_RANGE(1, cycles_ansi, cycles_x86);
+
+    free(x);
+    free(y);
+    free(z);
+}
+
+#endif // dsps_mul_f32_x86_enabled
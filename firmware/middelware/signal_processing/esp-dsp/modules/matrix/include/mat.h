@@ -15,6 +15,8 @@
 #ifndef _dspm_mat_h_
 #define _dspm_mat_h_
 #include <iostream>
+#include <string.h>
+#include "esp_log.h"
 
 /**
  * @brief   DSP matrix namespace
@@ -40,6 +42,60 @@ public:
     bool ext_buff;          /*!< Flag indicates that matrix use external buffer*/
     bool sub_matrix;        /*!< Flag indicates that matrix is a subset of another matrix*/
 
+    /**
+     * @brief Scratch arena for matrix buffers
+     *
+     * While an arena is bound, every buffer Mat allocates (constructors, copies, operator results)
+     * is taken from the arena instead of the heap, with one extra float to tag its size. The arena
+     * works as a stack: memory of released buffers is reused once everything above it is released,
+     * so each loop iteration reuses the same memory. When the arena is full, allocation falls back
+     * to the heap.
+     *
+     * Binding is per task (__thread): matrices allocated by other tasks keep using the heap or
+     * their own bound arena, so objects that own an arena (e.g. ekf) can run in separate tasks.
+     * An arena must only be bound by one task at a time.
+     * Matrices allocated from an arena must be destroyed before it is bound again or deleted.
+     */
+    class Arena {
+    public:
+        /**
+         * Constructor, the arena is not bound.
+         * @param[in] buffer: memory for the matrix buffers (can be NULL)
+         * @param[in] length: size of buffer (floats)
+         */
+        Arena(float *buffer, int length);
+        ~Arena();
+
+        /**
+         * @brief Bind the arena: next matrix buffers are taken from it
+         *
+         * Nested calls are counted; the outermost one rewinds the arena, so no matrix
+         * allocated from a previous binding may still be alive.
+         */
+        void bind();
+
+        /**
+         * @brief Unbind the arena, restoring the previously bound one
+         */
+        void unbind();
+
+        float *buffer;          /*!< Memory for the matrix buffers*/
+        int length;             /*!< Size of buffer (floats)*/
+        int used;               /*!< Floats in use*/
+        int peak;               /*!< Highest amount of floats used*/
+        int allocations;        /*!< Buffers taken from the arena*/
+        int heap_allocations;   /*!< Buffers taken from the heap while bound (arena full)*/
+    private:
+        int depth;              /*!< Nested bind() calls*/
+        Arena *previous;        /*!< Arena bound before this one*/
+
+        float *allocate(int size);
+        void release(float *data, int size);
+        friend class Mat;
+    };
+    static __thread Arena *arena;   /*!< Arena bound by the calling task (NULL for heap allocation)*/
+    Arena *arena_owner = NULL;  /*!< Arena that holds the matrix buffer*/
+
     /**
      * @brief Rectangular area
      *
@@ -433,6 +489,84 @@ public:
      *      - matrix [N]x[1] with roots
      */
     static Mat bandSolve(Mat A, Mat b, int k);
+
+    /**
+     * @brief   LU decomposition
+     *
+     * In place LU decomposition with partial pivoting, P*A = L*U. The matrix is replaced by
+     * U (upper triangle) and L (lower triangle, unit diagonal not stored).
+     *
+     * @param[out] pivot: row interchanges, [N] values (row k was swapped with row pivot[k])
+     *
+     * @return
+     *      - true on success
+     *      - false if the matrix is not square or is singular
+     */
+    bool luDecompose(int *pivot);
+
+    /**
+     * @brief   Solve with LU decomposition
+     *
+     * Solve A*x = b for a matrix decomposed by luDecompose().
+     *
+     * @param[in] pivot: row interchanges from luDecompose()
+     * @param[in] b: matrix [N]x[K] with result values
+     *
+     * @return
+     *      - matrix [N]x[K] with roots
+     */
+    Mat luSolve(const int *pivot, const Mat &b) const;
+
+    /**
+     * @brief   Cholesky decomposition
+     *
+     * In place Cholesky decomposition of a symmetric positive definite matrix, A = L*L'.
+     * Only the lower triangle is read; the matrix is replaced by L (upper triangle set to 0).
+     *
+     * @return
+     *      - true on success
+     *      - false if the matrix is not square or not positive definite
+     */
+    bool choleskyDecompose();
+
+    /**
+     * @brief   Solve with Cholesky decomposition
+     *
+     * Solve A*x = b for a matrix decomposed by choleskyDecompose().
+     *
+     * @param[in] b: matrix [N]x[K] with result values
+     *
+     * @return
+     *      - matrix [N]x[K] with roots
+     */
+    Mat choleskySolve(const Mat &b) const;
+
+    /**
+     * @brief   Forward substitution
+     *
+     * Solve L*x = b for a lower triangular matrix L (upper triangle is not read).
+     *
+     * @param[in] L: lower triangular matrix [N]x[N]
+     * @param[in] b: matrix [N]x[K] with result values
+     * @param[in] unit_diagonal: diagonal of L is 1 and not read
+     *
+     * @return
+     *      - matrix [N]x[K] with roots
+     */
+    static Mat solveLower(const Mat &L, const Mat &b, bool unit_diagonal = false);
+
+    /**
+     * @brief   Back substitution
+     *
+     * Solve U*x = b for an upper triangular matrix U (lower triangle is not read).
+     *
+     * @param[in] U: upper triangular matrix [N]x[N]
+     * @param[in] b: matrix [N]x[K] with result values
+     *
+     * @return
+     *      - matrix [N]x[K] with roots
+     */
+    static Mat solveUpper(const Mat &U, const Mat &b);
     /**
      * @brief   Solve the matrix
      *
@@ -490,10 +624,11 @@ public:
     Mat rowReduceFromGaussian();
 
     /**
-     * Find the inverse matrix
+     * Find the inverse matrix (LU decomposition)
      *
      * @return
      *      - inverse matrix
+     *      - matrix of zeros if the matrix is singular
      */
     Mat inverse();
 
@@ -518,6 +653,9 @@ private:
     Mat adjoint();
 
     void allocate(); // Allocate buffer
+    void release();  // Release buffer
+    static void substituteLower(const Mat &L, Mat &x, bool unit_diagonal);
+    static void substituteUpper(const Mat &U, Mat &x, bool transposed);
     Mat expHelper(const Mat &m, int num);
 };
 /**
@@ -667,5 +805,74 @@ Mat operator/(const Mat &A, const Mat &B);
 */
 bool operator==(const Mat &A, const Mat &B);
 
+/**
+ * @brief   Fixed size matrix
+ *
+ * Matrix with R x C elements stored inside the object (no heap or arena allocation).
+ * Assigning a matrix of different size is an error and leaves the matrix unchanged.
+ */
+template <int R, int C>
+class MatFixed : public Mat {
+public:
+    /**
+     * Constructor, matrix filled with 0.
+     */
+    MatFixed() : Mat(storage, R, C)
+    {
+        memset(this->storage, 0, sizeof(this->storage));
+    }
+
+    /**
+     * Constructor, copy of a R x C matrix.
+     * @param[in] src: source matrix
+     */
+    MatFixed(const Mat &src) : MatFixed()
+    {
+        *this = src;
+    }
+
+    /**
+     * Copy constructor.
+     * @param[in] src: source matrix
+     */
+    MatFixed(const MatFixed &src) : MatFixed()
+    {
+        *this = src;
+    }
+
+    /**
+     * Copy operator
+     * @param[in] src: source matrix, R x C
+     *
+     * @return
+     *      - matrix copy
+     */
+    MatFixed &operator=(const Mat &src)
+    {
+        if ((src.rows != R) || (src.cols != C)) {
+            ESP_LOGE("Mat", "operator = Error for fixed matrices: operands matrices dimensions %dx%d and %dx%d do not match", R, C, src.rows, src.cols);
+            return *this;
+        }
+        Mat::operator=(src);
+        return *this;
+    }
+
+    /**
+     * Copy operator
+     * @param[in] src: source matrix
+     *
+     * @return
+     *      - matrix copy
+     */
+    MatFixed &operator=(const MatFixed &src)
+    {
+        Mat::operator=(src);
+        return *this;
+    }
+
+private:
+    float storage[R * C];   /*!< Matrix data*/
+};
+
 }
 #endif //_dspm_mat_h_
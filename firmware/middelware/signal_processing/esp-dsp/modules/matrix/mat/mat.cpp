@@ -32,6 +32,72 @@ using std::endl;
 namespace dspm {
 
 float Mat::abs_tol = 1e-10;
+__thread Mat::Arena *Mat::arena = NULL;
+
+Mat::Arena::Arena(float *buffer, int length)
+{
+    this->buffer = buffer;
+    this->length = (buffer == NULL) ? 0 : length;
+    this->used = 0;
+    this->peak = 0;
+    this->allocations = 0;
+    this->heap_allocations = 0;
+    this->depth = 0;
+    this->previous = NULL;
+}
+
+Mat::Arena::~Arena()
+{
+    if (this->depth > 0) {
+        this->depth = 1;
+        unbind();
+    }
+}
+
+void Mat::Arena::bind()
+{
+    if (this->depth++ > 0) {
+        return;
+    }
+    this->used = 0;
+    this->previous = Mat::arena;
+    Mat::arena = this;
+}
+
+void Mat::Arena::unbind()
+{
+    if ((this->depth == 0) || (--this->depth > 0)) {
+        return;
+    }
+    Mat::arena = this->previous;
+    this->previous = NULL;
+}
+
+// Every buffer is followed by a tag with its size, negative once the buffer is released.
+// Released buffers on top of the arena are popped, so matrices can be freed in any order.
+float *Mat::Arena::allocate(int size)
+{
+    if (this->used + size + 1 > this->length) {
+        this->heap_allocations++;
+        return NULL;
+    }
+    float *data = this->buffer + this->used;
+    data[size] = size;
+    this->used += size + 1;
+    if (this->used > this->peak) {
+        this->peak = this->used;
+    }
+    this->allocations++;
+    return data;
+}
+
+void Mat::Arena::release(float *data, int size)
+{
+    data[size] = -(size + 1);
+    while ((this->used > 0) && (this->buffer[this->used - 1] < 0)) {
+        this->used += (int)this->buffer[this->used - 1];
+    }
+}
 
 Mat::Rect::Rect(int x, int y, int width, int height)
 {
@@ -109,9 +175,7 @@ Mat::Mat()
 Mat::~Mat()
 {
     ESP_LOGD("Mat", "~Mat(%i, %i), ext_buff=%i, data = %p", this->rows, this->cols, this->ext_buff, this->data);
-    if (false == this->ext_buff) {
-        delete[] data;
-    }
+    release();
 }
 
 Mat::Mat(const Mat &m)
@@ -179,9 +243,7 @@ void Mat::Copy(const Mat &src, int row_pos, int col_pos)
 
 void Mat::CopyHead(const Mat &src)
 {
-    if (!this->ext_buff) {
-        delete[] this->data;
-    }
+    release();
     this->rows = src.rows;
     this->cols = src.cols;
     this->length = src.length;
@@ -239,10 +301,7 @@ Mat &Mat::operator=(const Mat &m)
             ESP_LOGE("Mat", "operator = Error for sub-matrices: operands matrices dimensions %dx%d and %dx%d do not match", this->rows, this->cols, m.rows, m.cols);
             return *this;
         }
-        if (!this->ext_buff) {
-            delete[] this->data;
-        }
-        this->ext_buff = false;
+        release();
         this->rows = m.rows;
         this->cols = m.cols;
         this->stride = this->cols;
@@ -799,33 +858,193 @@ Mat Mat::adjoint()
 Mat Mat::inverse()
 {
     Mat result(this->rows, this->cols);
-    // Find determinant of matrix
-    float det = this->det(this->rows);
-    if (det == 0) {
-        //std::cout << "Singular matrix, can't find its inverse";
-        return result;
+    Mat lu(this->rows, this->cols);
+    lu = *this;
+    int *pivot = new int[this->rows];
+    if (lu.luDecompose(pivot)) {
+        result = lu.luSolve(pivot, Mat::eye(this->rows));
     }
+    delete[] pivot;
+    return result;
+}
 
-    // Find adjoint
-    Mat adj = this->adjoint();
+bool Mat::luDecompose(int *pivot)
+{
+    if (this->rows != this->cols) {
+        ESP_LOGW("Mat", "luDecompose Error: matrix %dx%d is not square", this->rows, this->cols);
+        return false;
+    }
+    int n = this->rows;
+    for (int k = 0; k < n; k++) {
+        // Partial pivoting: largest element of the column
+        int p = k;
+        float max = fabsf((*this)(k, k));
+        for (int i = k + 1; i < n; i++) {
+            if (fabsf((*this)(i, k)) > max) {
+                max = fabsf((*this)(i, k));
+                p = i;
+            }
+        }
+        pivot[k] = p;
+        if (max <= abs_tol) {
+            return false;
+        }
+        if (p != k) {
+            this->swapRows(p, k);
+        }
+        float *row_k = &this->data[k * this->stride];
+        float inv_kk = 1 / row_k[k];
+        for (int i = k + 1; i < n; i++) {
+            float *row_i = &this->data[i * this->stride];
+            float l_ik = row_i[k] * inv_kk;
+            row_i[k] = l_ik;
+            for (int j = k + 1; j < n; j++) {
+                row_i[j] -= l_ik * row_k[j];
+            }
+        }
+    }
+    return true;
+}
 
-    // Find Inverse using formula "inverse(A) = adj(A)/det(A)"
-    for (int i = 0; i < this->rows; i++)
-        for (int j = 0; j < this->cols; j++) {
-            result(i, j) = adj(i, j) / float(det);
+Mat Mat::luSolve(const int *pivot, const Mat &b) const
+{
+    Mat x(b.rows, b.cols);
+    x = b;
+    for (int k = 0; k < this->rows; k++) {
+        if (pivot[k] != k) {
+            x.swapRows(k, pivot[k]);
         }
+    }
+    substituteLower(*this, x, true);
+    substituteUpper(*this, x, false);
+    return x;
+}
 
-    return result;
+bool Mat::choleskyDecompose()
+{
+    if (this->rows != this->cols) {
+        ESP_LOGW("Mat", "choleskyDecompose Error: matrix %dx%d is not square", this->rows, this->cols);
+        return false;
+    }
+    int n = this->rows;
+    for (int j = 0; j < n; j++) {
+        float *row_j = &this->data[j * this->stride];
+        float sum = row_j[j];
+        for (int k = 0; k < j; k++) {
+            sum -= row_j[k] * row_j[k];
+        }
+        if (sum <= 0) {
+            return false;
+        }
+        float l_jj = sqrtf(sum);
+        float inv_jj = 1 / l_jj;
+        row_j[j] = l_jj;
+        for (int i = j + 1; i < n; i++) {
+            float *row_i = &this->data[i * this->stride];
+            sum = row_i[j];
+            for (int k = 0; k < j; k++) {
+                sum -= row_i[k] * row_j[k];
+            }
+            row_i[j] = sum * inv_jj;
+            row_j[i] = 0;
+        }
+    }
+    return true;
+}
+
+Mat Mat::choleskySolve(const Mat &b) const
+{
+    Mat x(b.rows, b.cols);
+    x = b;
+    substituteLower(*this, x, false);
+    substituteUpper(*this, x, true);
+    return x;
+}
+
+Mat Mat::solveLower(const Mat &L, const Mat &b, bool unit_diagonal)
+{
+    Mat x(b.rows, b.cols);
+    x = b;
+    substituteLower(L, x, unit_diagonal);
+    return x;
+}
+
+Mat Mat::solveUpper(const Mat &U, const Mat &b)
+{
+    Mat x(b.rows, b.cols);
+    x = b;
+    substituteUpper(U, x, false);
+    return x;
+}
+
+void Mat::substituteLower(const Mat &L, Mat &x, bool unit_diagonal)
+{
+    for (int i = 0; i < x.rows; i++) {
+        float *x_i = &x.data[i * x.stride];
+        for (int k = 0; k < i; k++) {
+            float l_ik = L(i, k);
+            const float *x_k = &x.data[k * x.stride];
+            for (int c = 0; c < x.cols; c++) {
+                x_i[c] -= l_ik * x_k[c];
+            }
+        }
+        if (!unit_diagonal) {
+            float inv_ii = 1 / L(i, i);
+            for (int c = 0; c < x.cols; c++) {
+                x_i[c] *= inv_ii;
+            }
+        }
+    }
+}
+
+// transposed: U is given as its transpose (lower triangle), as left by choleskyDecompose()
+void Mat::substituteUpper(const Mat &U, Mat &x, bool transposed)
+{
+    for (int i = x.rows - 1; i >= 0; i--) {
+        float *x_i = &x.data[i * x.stride];
+        for (int k = i + 1; k < x.rows; k++) {
+            float u_ik = transposed ? U(k, i) : U(i, k);
+            const float *x_k = &x.data[k * x.stride];
+            for (int c = 0; c < x.cols; c++) {
+                x_i[c] -= u_ik * x_k[c];
+            }
+        }
+        float inv_ii = 1 / U(i, i);
+        for (int c = 0; c < x.cols; c++) {
+            x_i[c] *= inv_ii;
+        }
+    }
 }
 
 void Mat::allocate()
 {
     this->ext_buff = false;
+    this->arena_owner = NULL;
     this->length = this->rows * this->cols;
+    if (Mat::arena != NULL) {
+        this->data = Mat::arena->allocate(this->length);
+        if (this->data != NULL) {
+            // Arena buffers are not deleted, ext_buff keeps the heap paths away from them
+            this->ext_buff = true;
+            this->arena_owner = Mat::arena;
+            ESP_LOGD("Mat", "allocate(%i) = %p (arena)", this->length, this->data);
+            return;
+        }
+    }
     data = new float[this->length];
     ESP_LOGD("Mat", "allocate(%i) = %p", this->length, this->data);
 }
 
+void Mat::release()
+{
+    if (this->arena_owner != NULL) {
+        this->arena_owner->release(this->data, this->length);
+        this->arena_owner = NULL;
+    } else if (false == this->ext_buff) {
+        delete[] this->data;
+    }
+}
+
 Mat Mat::expHelper(const Mat &m, int num)
 {
     if (num == 0) {
@@ -839,34 +1058,32 @@ Mat Mat::expHelper(const Mat &m, int num)
     }
 }
 
+// Operators return a single named matrix (also on error), so the compiler returns it without a copy
 Mat operator+(const Mat &m1, const Mat &m2)
 {
-    if ((m1.rows != m2.rows) || (m1.cols != m2.cols)) {
+    bool error = (m1.rows != m2.rows) || (m1.cols != m2.cols);
+    Mat temp(error ? 1 : m1.rows, error ? 1 : m1.cols);
+    if (error) {
         ESP_LOGW("Mat", "operator + Error: matrices do not have equal dimensions");
-        Mat err_ret;
-        return err_ret;
+        return temp;
     }
-
     if (m1.sub_matrix || m2.sub_matrix) {
-        Mat temp(m1.rows, m2.cols);
         dspm_add_f32(m1.data, m2.data, temp.data, m1.rows, m1.cols, m1.padding, m2.padding, temp.padding, 1, 1, 1);
-        return temp;
     } else {
-        Mat temp(m1);
-        return (temp += m2);
+        dsps_add_f32(m1.data, m2.data, temp.data, m1.length, 1, 1, 1);
     }
+    return temp;
 }
 
 Mat operator+(const Mat &m, float C)
 {
+    Mat temp(m.rows, m.cols);
     if (m.sub_matrix) {
-        Mat temp(m.rows, m.cols);
         dspm_addc_f32(m.data, temp.data, C, m.rows, m.cols, m.padding, temp.padding, 1, 1);
-        return temp;
     } else {
-        Mat temp(m);
-        return (temp += C);
+        dsps_addc_f32_ansi(m.data, temp.data, m.length, C, 1, 1);
     }
+    return temp;
 }
 
 bool operator==(const Mat &m1, const Mat &m2)
@@ -889,42 +1106,33 @@ bool operator==(const Mat &m1, const Mat &m2)
 
 Mat operator-(const Mat &m1, const Mat &m2)
 {
-    if ((m1.rows != m2.rows) || (m1.cols != m2.cols)) {
+    bool error = (m1.rows != m2.rows) || (m1.cols != m2.cols);
+    Mat temp(error ? 1 : m1.rows, error ? 1 : m1.cols);
+    if (error) {
         ESP_LOGW("Mat", "operator - Error: matrices do not have equal dimensions");
-        Mat err_ret;
-        return err_ret;
+        return temp;
     }
-
     if (m1.sub_matrix || m2.sub_matrix) {
-        Mat temp(m1.rows, m1.cols);
         dspm_sub_f32(m1.data, m2.data, temp.data, m1.rows, m1.cols, m1.padding, m2.padding, temp.padding, 1, 1, 1);
-        return temp;
     } else {
-        Mat temp(m1);
-        return (temp -= m2);
+        dsps_sub_f32(m1.data, m2.data, temp.data, m1.length, 1, 1, 1);
     }
+    return temp;
 }
 
 Mat operator-(const Mat &m, float C)
 {
-    if (m.sub_matrix) {
-        Mat temp(m.rows, m.cols);
-        dspm_addc_f32(m.data, temp.data, -C, m.rows, m.cols, m.padding, temp.padding, 1, 1);
-        return temp;
-    } else {
-        Mat temp(m);
-        return (temp -= C);
-    }
+    return (m + (-C));
 }
 
 Mat operator*(const Mat &m1, const Mat &m2)
 {
-    if (m1.cols != m2.rows) {
+    bool error = m1.cols != m2.rows;
+    Mat temp(error ? 1 : m1.rows, error ? 1 : m2.cols);
+    if (error) {
         ESP_LOGW("Mat", "operator * Error: matrices do not have correct dimensions");
-        Mat err_ret;
-        return err_ret;
+        return temp;
     }
-    Mat temp(m1.rows, m2.cols);
 
     if (m1.sub_matrix || m2.sub_matrix) {
         dspm_mult_ex_f32(m1.data, m2.data, temp.data, m1.rows, m1.cols, m2.cols, m1.padding, m2.padding, temp.padding);
@@ -938,14 +1146,13 @@ Mat operator*(const Mat &m1, const Mat &m2)
 
 Mat operator*(const Mat &m, float num)
 {
+    Mat temp(m.rows, m.cols);
     if (m.sub_matrix) {
-        Mat temp(m.rows, m.cols);
         dspm_mulc_f32(m.data, temp.data, num, m.rows, m.cols, m.padding, temp.padding, 1, 1);
-        return temp;
     } else {
-        Mat temp(m);
-        return (temp *= num);
+        dsps_mulc_f32_ansi(m.data, temp.data, m.length, num, 1, 1);
     }
+    return temp;
 }
 
 Mat operator*(float num, const Mat &m)
@@ -955,25 +1162,17 @@ Mat operator*(float num, const Mat &m)
 
 Mat operator/(const Mat &m, float num)
 {
-    if (m.sub_matrix) {
-        Mat temp(m.rows, m.cols);
-        dspm_mulc_f32(m.data, temp.data, 1 / num, m.rows, m.cols, m.padding, temp.padding, 1, 1);
-        return temp;
-    } else {
-        Mat temp(m);
-        return (temp /= num);
-    }
+    return (m * (1 / num));
 }
 
 Mat operator/(const Mat &A, const Mat &B)
 {
-    if ((A.rows != B.rows) || (A.cols != B.cols)) {
+    bool error = (A.rows != B.rows) || (A.cols != B.cols);
+    Mat temp(error ? 1 : A.rows, error ? 1 : A.cols);
+    if (error) {
         ESP_LOGW("Mat", "Operator + Error: matrices do not have equal dimensions");
-        Mat err_ret;
-        return err_ret;
+        return temp;
     }
-
-    Mat temp(A.rows, A.cols);
     for (int row = 0; row < A.rows; row++) {
         for (int col = 0; col < A.cols; col++) {
             temp(row, col) = A(row, col) / B(row, col);
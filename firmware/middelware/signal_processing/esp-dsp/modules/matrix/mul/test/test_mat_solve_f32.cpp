@@ -0,0 +1,140 @@
+// Copyright 2018-2023 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <string.h>
+#include <stdlib.h>
+#include "unity.h"
+#include "dsp_platform.h"
+#include "esp_log.h"
+#include "dsp_common.h"
+#include "mat.h"
+
+static const char *TAG = "dspm_Mat_solve";
+
+// Random matrix with values in [-1, 1]
+static dspm::Mat random_mat(int rows, int cols)
+{
+    dspm::Mat result(rows, cols);
+    for (int i = 0; i < rows * cols; i++) {
+        result.data[i] = 2.0f * rand() / RAND_MAX - 1;
+    }
+    return result;
+}
+
+static float max_abs_diff(const dspm::Mat &A, const dspm::Mat &B)
+{
+    float result = 0;
+    for (int r = 0; r < A.rows; r++) {
+        for (int c = 0; c < A.cols; c++) {
+            result = std::max(result, std::abs(A(r, c) - B(r, c)));
+        }
+    }
+    return result;
+}
+
+TEST_CASE("Mat class LU and Cholesky solve", "[dspm]")
+{
+    const int k = 2;
+    srand(1);
+    for (int n = 3; n <= 13; n++) {
+        // Well conditioned general matrix and symmetric positive definite matrix
+        dspm::Mat A = random_mat(n, n) + dspm::Mat::eye(n) * (float)n;
+        dspm::Mat S = A * A.t() + dspm::Mat::eye(n);
+        dspm::Mat x = random_mat(n, k);
+        dspm::Mat b = A * x;
+        dspm::Mat c = S * x;
+
+        int pivot[13];
+        dspm::Mat lu = A;
+        TEST_ASSERT_TRUE(lu.luDecompose(pivot));
+        dspm::Mat x_lu = lu.luSolve(pivot, b);
+        TEST_ASSERT_LESS_THAN(1e-5f, max_abs_diff(x_lu, x));
+
+        dspm::Mat chol = S;
+        TEST_ASSERT_TRUE(chol.choleskyDecompose());
+        TEST_ASSERT_LESS_THAN(1e-5f * n, max_abs_diff(chol * chol.t(), S) / S(0, 0));
+        dspm::Mat x_chol = chol.choleskySolve(c);
+        TEST_ASSERT_LESS_THAN(1e-5f, max_abs_diff(x_chol, x));
+
+        // Triangular solves on the factors
+        dspm::Mat y = dspm::Mat::solveLower(chol, c);
+        TEST_ASSERT_LESS_THAN(1e-5f, max_abs_diff(dspm::Mat::solveUpper(chol.t(), y), x));
+
+        dspm::Mat I = A.inverse() * A;
+        TEST_ASSERT_LESS_THAN(1e-5f, max_abs_diff(I, dspm::Mat::eye(n)));
+    }
+}
+
+TEST_CASE("Mat class LU and Cholesky failures", "[dspm]")
+{
+    float singular_data[] = {1, 2, 3,
+                             2, 4, 6,
+                             1, 0, 1
+                            };
+    float indefinite_data[] = {1, 2, 0,
+                               2, 1, 0,
+                               0, 0, 1
+                              };
+    int pivot[3];
+    dspm::Mat singular(singular_data, 3, 3);
+    TEST_ASSERT_FALSE(singular.luDecompose(pivot));
+    dspm::Mat indefinite(indefinite_data, 3, 3);
+    TEST_ASSERT_FALSE(indefinite.choleskyDecompose());
+    dspm::Mat rect(3, 4);
+    TEST_ASSERT_FALSE(rect.luDecompose(pivot));
+    TEST_ASSERT_FALSE(rect.choleskyDecompose());
+}
+
+TEST_CASE("Mat class LU and Cholesky benchmark", "[dspm]")
+{
+    const int repeat = 16;
+    srand(1);
+    for (int n = 3; n <= 13; n++) {
+        dspm::Mat A = random_mat(n, n) + dspm::Mat::eye(n) * (float)n;
+        dspm::Mat S = A * A.t() + dspm::Mat::eye(n);
+        dspm::Mat b = random_mat(n, 1);
+        dspm::Mat work(n, n);
+        dspm::Mat x(n, 1);
+        int pivot[13];
+
+        unsigned int start = dsp_get_cpu_cycle_count();
+        for (int i = 0; i < repeat; i++) {
+            work = A;
+            work.luDecompose(pivot);
+            x = work.luSolve(pivot, b);
+        }
+        unsigned int lu_cycles = (dsp_get_cpu_cycle_count() - start) / repeat;
+
+        start = dsp_get_cpu_cycle_count();
+        for (int i = 0; i < repeat; i++) {
+            work = S;
+            work.choleskyDecompose();
+            x = work.choleskySolve(b);
+        }
+        unsigned int chol_cycles = (dsp_get_cpu_cycle_count() - start) / repeat;
+
+        start = dsp_get_cpu_cycle_count();
+        for (int i = 0; i < repeat; i++) {
+            x = A.inverse() * b;
+        }
+        unsigned int inv_cycles = (dsp_get_cpu_cycle_count() - start) / repeat;
+
+        start = dsp_get_cpu_cycle_count();
+        for (int i = 0; i < repeat; i++) {
+            x = A.pinv() * b;
+        }
+        unsigned int pinv_cycles = (dsp_get_cpu_cycle_count() - start) / repeat;
+        ESP_LOGI(TAG, "%2ix%-2i solve cycles: LU %6i, Cholesky %6i, inverse() %6i, pinv() %6i", n, n, lu_cycles, chol_cycles, inv_cycles, pinv_cycles);
+    }
+}
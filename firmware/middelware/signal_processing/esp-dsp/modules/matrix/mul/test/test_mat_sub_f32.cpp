@@ -821,7 +821,8 @@ static void test_mat_subset_inverse(void)
     std::cout << "inverse: " << std::endl;
     std::cout << result << std::endl;
     for (int i = 0; i < 3 * 3; i++) {
-        if (std::abs(result.data[i] - m_result[i]) > 1e-8) {
+        // LU in float arithmetic (condition number ~1000): relative tolerance
+        if (std::abs(result.data[i] - m_result[i]) > 1e-5 * (1 + std::abs(m_result[i]))) {
             printf("Error at[%i] = %f, expected= %f, calculated = %f \n", i, std::abs(result.data[i] - m_result[i]), m_result[i], result.data[i]);
             TEST_ASSERT_MESSAGE (false, "Error in inverse() operation!\n");
         }
@@ -0,0 +1,129 @@
+#ifndef ATTITUDE_H_
+#define ATTITUDE_H_
+/** \addtogroup Drivers_Programable Drivers Programable
+ ** @{ */
+/** \addtogroup Middelware Middelware
+ ** @{ */
+/** \addtogroup Attitude Attitude
+ */
+
+/** \brief Mahony attitude (AHRS without magnetometer) estimator, fixed point arithmetic only
+ *
+ * Fed with the raw output of MPU6050_getMotion6() (or FIFO bursts of accelerometer + gyroscope packets):
+ * - Gyroscope rates are integrated into a Q30 quaternion (body to earth).
+ * - The accelerometer gravity direction corrects roll and pitch through a proportional term and an integral
+ *   term, the integral term is the gyroscope bias estimation.
+ * - Yaw is not observable from gravity: it follows the gyroscope integration (only the bias of the axes
+ *   tilted away from vertical can be learned).
+ *
+ * The quaternion is aligned to the first accelerometer sample, so roll and pitch are right from the start.
+ *
+ * @author Peñalva Albano
+ *
+ * @section changelog
+ *
+ * |   Date	    | Description                                    						|
+ * |:----------:|:----------------------------------------------------------------------|
+ * | 17/10/2026 | Document creation		                         						|
+ *
+ **/
+
+/*==================[inclusions]=============================================*/
+#include <stdint.h>
+#include <stdbool.h>
+/*==================[macros]=================================================*/
+#define ATTITUDE_KP         1.0     /*!< Default proportional gain (rad/s) */
+#define ATTITUDE_KI         0.05    /*!< Default integral (gyroscope bias) gain (rad/s^2) */
+#define ATTITUDE_PACKET     12      /*!< FIFO packet size: accelerometer and gyroscope, 3 x 2 bytes each */
+
+/*==================[typedef]================================================*/
+/**
+ * @brief Raw inertial sample, in MPU6050_getMotion6() order
+ */
+typedef struct {
+    int16_t ax;                 /*!< Accelerometer X (raw, any full scale) */
+    int16_t ay;                 /*!< Accelerometer Y (raw, any full scale) */
+    int16_t az;                 /*!< Accelerometer Z (raw, any full scale) */
+    int16_t gx;                 /*!< Gyroscope X (raw) */
+    int16_t gy;                 /*!< Gyroscope Y (raw) */
+    int16_t gz;                 /*!< Gyroscope Z (raw) */
+} attitude_sample_t;
+
+/**
+ * @brief Attitude estimator object
+ */
+typedef struct {
+    int32_t q[4];               /*!< Attitude quaternion (Q30, w x y z), body to earth */
+    int32_t gyro_scale;         /*!< Raw gyroscope to half angle per sample (Q45 rad) */
+    int32_t kp;                 /*!< Proportional gain, half angle per sample (Q30) */
+    int32_t ki;                 /*!< Integral gain, half angle per sample^2 (Q46) */
+    int64_t integral[3];        /*!< Gyroscope bias correction, half angle per sample (Q46) */
+    bool aligned;               /*!< Quaternion aligned to the accelerometer */
+} attitude_t;
+/*==================[external data declaration]==============================*/
+
+/*==================[external functions declaration]=========================*/
+/**
+ * @brief Initialize an attitude estimator object
+ *
+ * @param attitude      Attitude estimator object
+ * @param sample_frec   Sample frequency (Hz)
+ * @param gyro_range    Gyroscope full scale (250, 500, 1000 or 2000 °/s)
+ * @param kp            Proportional gain (rad/s, ATTITUDE_KP)
+ * @param ki            Integral gain (rad/s^2, ATTITUDE_KI, 0 disables the bias estimation)
+ * @return true         Estimator initialized
+ * @return false        Invalid parameters
+ */
+bool AttitudeInit(attitude_t * attitude, uint16_t sample_frec, uint16_t gyro_range, float kp, float ki);
+
+/**
+ * @brief Update the attitude with a block of samples
+ *
+ * @param attitude      Attitude estimator object
+ * @param samples       Raw samples (consecutive, at sample_frec)
+ * @param n_samples     Number of samples
+ */
+void AttitudeUpdate(attitude_t * attitude, const attitude_sample_t * samples, uint16_t n_samples);
+
+/**
+ * @brief Unpack a MPU6050 FIFO burst
+ *
+ * The FIFO must hold accelerometer and gyroscope data only (temperature disabled), packets are big endian
+ * in register order (ax ay az gx gy gz). Incomplete trailing packets are ignored.
+ *
+ * @param fifo          Bytes read with MPU6050_getFIFOBytes()
+ * @param fifo_lenght   Number of bytes
+ * @param samples       Samples array (fifo_lenght / ATTITUDE_PACKET samples)
+ * @return              Number of samples unpacked
+ */
+uint16_t AttitudeUnpackFIFO(const uint8_t * fifo, uint16_t fifo_lenght, attitude_sample_t * samples);
+
+/**
+ * @brief Attitude as Euler angles (aerospace sequence: yaw, then pitch, then roll)
+ *
+ * @param attitude      Attitude estimator object
+ * @param euler         Roll, pitch and yaw (0.01 °)
+ */
+void AttitudeGetEuler(attitude_t * attitude, int16_t euler[3]);
+
+/**
+ * @brief Estimated gyroscope bias
+ *
+ * @param attitude      Attitude estimator object
+ * @param bias          Bias of the X, Y and Z gyroscope axes (raw units, to be subtracted from the samples)
+ */
+void AttitudeGetGyroBias(attitude_t * attitude, int16_t bias[3]);
+
+/**
+ * @brief Restart the estimator (identity attitude, no bias, aligned again to the next sample)
+ *
+ * @param attitude      Attitude estimator object
+ */
+void AttitudeReset(attitude_t * attitude);
+
+/** @} doxygen end group definition */
+/** @} doxygen end group definition */
+/** @} doxygen end group definition */
+#endif /* ATTITUDE_H_ */
+
+/*==================[end of file]============================================*/
@@ -0,0 +1,180 @@
+#ifndef BIN_TRACKER_H_
+#define BIN_TRACKER_H_
+/** \addtogroup Drivers_Programable Drivers Programable
+ ** @{ */
+/** \addtogroup Middelware Middelware
+ ** @{ */
+/** \addtogroup Bin_Tracker Bin Tracker
+ */
+
+/** \brief Amplitude of a few spectrum bins without a full FFT
+ * 
+ * Each bin costs O(1) per sample, so tracking K bins costs O(K) per sample instead
+ * of the O(log N) per sample (for all bins) of FFTMagnitude(). Two methods are provided:
+ * - Goertzel: one block of window_lenght samples in, the amplitude of every bin out.
+ * - Sliding DFT: the bins are updated with every new sample and can be read at any time,
+ *   always covering the last window_lenght samples. The modulated form is used (the input is
+ *   demodulated by each bin phasor and accumulated), which does not drift with rounding errors.
+ * 
+ * Amplitudes use a rectangular window: a sinusoid of amplitude A at a bin frequency gives A
+ * (DC gives its mean value, sample_frec / 2 gives A * cos(phase)). Bin frequencies are rounded to the nearest multiple of
+ * sample_frec / window_lenght, the FFTFrequency() axis for the same lenght.
+ * 
+ * @author Peñalva Albano
+ *
+ * @section changelog
+ *
+ * |   Date	    | Description                                    						|
+ * |:----------:|:----------------------------------------------------------------------|
+ * | 17/10/2026 | Document creation		                         						|
+ * 
+ **/
+
+/*==================[inclusions]=============================================*/
+#include <stdint.h>
+#include <stdbool.h>
+/*==================[macros]=================================================*/
+
+/*==================[typedef]================================================*/
+/**
+ * @brief Bin tracker object
+ */
+typedef struct {
+    uint8_t n_bins;             /*!< Number of tracked bins */
+    uint16_t window_lenght;     /*!< Samples per Goertzel block / sliding DFT window */
+    uint16_t pos;               /*!< Index of the oldest sample in history */
+    float * coeff;              /*!< cos(w), sin(w) of each bin */
+    float * state;              /*!< Sliding DFT complex value of each bin */
+    float * phasor;             /*!< Sliding DFT demodulation phasor of each bin */
+    float * history;            /*!< Last window_lenght samples */
+} bin_tracker_t;
+
+/**
+ * @brief Fixed-point bin tracker object: Q15 samples and amplitudes, Q30 coefficients
+ */
+typedef struct {
+    uint8_t n_bins;             /*!< Number of tracked bins */
+    uint16_t window_lenght;     /*!< Samples per Goertzel block / sliding DFT window */
+    uint16_t pos;               /*!< Index of the oldest sample in history */
+    int32_t * coeff;            /*!< cos(w), sin(w) of each bin (Q30) */
+    int64_t * state;            /*!< Sliding DFT complex value of each bin (Q45) */
+    int32_t * phasor;           /*!< Sliding DFT demodulation phasor of each bin (Q30) */
+    int16_t * history;          /*!< Last window_lenght samples */
+} bin_tracker_q15_t;
+/*==================[external data declaration]==============================*/
+
+/*==================[external functions declaration]=========================*/
+/**
+ * @brief Initialize a bin tracker object
+ * 
+ * @param tracker           Bin tracker object
+ * @param sample_frec       Signal's sample frequency
+ * @param bin_frec          Array with the frequencies to track (of lenght = n_bins, up to sample_frec / 2)
+ * @param n_bins            Number of frequencies to track
+ * @param window_lenght     Samples per window (any lenght, not only powers of two)
+ * @return true             Tracker initialized
+ * @return false            Invalid parameters or not enough memory
+ */
+bool BinTrackerInit(bin_tracker_t * tracker, float sample_frec, float * bin_frec, uint8_t n_bins, uint16_t window_lenght);
+
+/**
+ * @brief Calculates the amplitude of the tracked bins of a block (Goertzel algorithm)
+ * 
+ * Independent of the sliding DFT state.
+ * 
+ * @param tracker           Bin tracker object
+ * @param signal            Array with signal values (of lenght = window_lenght)
+ * @param amplitude         Array to store the amplitude of each bin (of lenght = n_bins)
+ */
+void BinTrackerGoertzel(bin_tracker_t * tracker, float * signal, float * amplitude);
+
+/**
+ * @brief Update the sliding DFT of the tracked bins with new samples
+ * 
+ * @param tracker           Bin tracker object
+ * @param signal            Array with new signal values
+ * @param signal_lenght     Lenght of signal array (any lenght)
+ */
+void BinTrackerSlide(bin_tracker_t * tracker, float * signal, uint16_t signal_lenght);
+
+/**
+ * @brief Amplitude of the tracked bins over the last window_lenght samples (sliding DFT)
+ * 
+ * @param tracker           Bin tracker object
+ * @param amplitude         Array to store the amplitude of each bin (of lenght = n_bins)
+ */
+void BinTrackerAmplitude(bin_tracker_t * tracker, float * amplitude);
+
+/**
+ * @brief Clear the sliding DFT state (as if the last window_lenght samples were zeros)
+ * 
+ * @param tracker           Bin tracker object
+ */
+void BinTrackerReset(bin_tracker_t * tracker);
+
+/**
+ * @brief Release the memory used by a bin tracker object
+ * 
+ * @param tracker           Bin tracker object
+ */
+void BinTrackerDeinit(bin_tracker_t * tracker);
+
+/**
+ * @brief Initialize a fixed-point bin tracker object
+ * 
+ * @param tracker           Bin tracker object
+ * @param sample_frec       Signal's sample frequency
+ * @param bin_frec          Array with the frequencies to track (of lenght = n_bins, up to sample_frec / 2)
+ * @param n_bins            Number of frequencies to track
+ * @param window_lenght     Samples per window (any lenght, not only powers of two)
+ * @return true             Tracker initialized
+ * @return false            Invalid parameters or not enough memory
+ */
+bool BinTrackerInitQ15(bin_tracker_q15_t * tracker, float sample_frec, float * bin_frec, uint8_t n_bins, uint16_t window_lenght);
+
+/**
+ * @brief Calculates the amplitude of the tracked bins of a Q15 block using integer arithmetic only
+ * 
+ * @param tracker           Bin tracker object
+ * @param signal            Array with signal values in Q15 (of lenght = window_lenght)
+ * @param amplitude         Array to store the amplitude of each bin in Q15 (of lenght = n_bins)
+ */
+void BinTrackerGoertzelQ15(bin_tracker_q15_t * tracker, int16_t * signal, int16_t * amplitude);
+
+/**
+ * @brief Update the sliding DFT of the tracked bins with new Q15 samples
+ * 
+ * @param tracker           Bin tracker object
+ * @param signal            Array with new signal values in Q15
+ * @param signal_lenght     Lenght of signal array (any lenght)
+ */
+void BinTrackerSlideQ15(bin_tracker_q15_t * tracker, int16_t * signal, uint16_t signal_lenght);
+
+/**
+ * @brief Amplitude of the tracked bins over the last window_lenght samples in Q15 (sliding DFT)
+ * 
+ * @param tracker           Bin tracker object
+ * @param amplitude         Array to store the amplitude of each bin in Q15 (of lenght = n_bins)
+ */
+void BinTrackerAmplitudeQ15(bin_tracker_q15_t * tracker, int16_t * amplitude);
+
+/**
+ * @brief Clear the sliding DFT state of a fixed-point bin tracker object
+ * 
+ * @param tracker           Bin tracker object
+ */
+void BinTrackerResetQ15(bin_tracker_q15_t * tracker);
+
+/**
+ * @brief Release the memory used by a fixed-point bin tracker object
+ * 
+ * @param tracker           Bin tracker object
+ */
+void BinTrackerDeinitQ15(bin_tracker_q15_t * tracker);
+
+/** @} doxygen end group definition */
+/** @} doxygen end group definition */
+/** @} doxygen end group definition */
+#endif /* BIN_TRACKER_H_ */
+
+/*==================[end of file]============================================*/
@@ -0,0 +1,85 @@
+#ifndef DCT_H_
+#define DCT_H_
+/** \addtogroup Drivers_Programable Drivers Programable
+ ** @{ */
+/** \addtogroup Middelware Middelware
+ ** @{ */
+/** \addtogroup DCT Discrete Cosine Transform
+ */
+
+/** \brief Fast DCT-II / DCT-III (Lee's recursive algorithm, O(N log N))
+ *
+ * Standalone: the plan holds its own cosine factors, no FFT initialization is needed and no cosine is
+ * evaluated while transforming.
+ * - Forward (DCT-II):  X[k] = sum x[n] cos(pi (n + 1/2) k / N)
+ * - Inverse (DCT-III scaled by 2 / N, so it recovers x exactly): x[n] = (X[0] + 2 sum X[k] cos(pi (n + 1/2) k / N)) / N
+ *
+ * The forward scale matches dsps_dct_f32_ref().
+ *
+ * @author Peñalva Albano
+ *
+ * @section changelog
+ *
+ * |   Date	    | Description                                    						|
+ * |:----------:|:----------------------------------------------------------------------|
+ * | 17/10/2026 | Document creation		                         						|
+ *
+ **/
+
+/*==================[inclusions]=============================================*/
+#include <stdint.h>
+#include <stdbool.h>
+/*==================[macros]=================================================*/
+#define DCT_MAX_LENGHT      2048    /*!< Longest transform */
+
+/*==================[typedef]================================================*/
+/**
+ * @brief DCT plan: cosine factors and working buffer for a fixed lenght
+ */
+typedef struct {
+    uint16_t lenght;            /*!< Transform lenght */
+    float * factor;             /*!< 1 / (2 cos(pi (i + 1/2) / n)) for n = lenght, lenght / 2, ... 2 (lenght - 1 values) */
+    float * buffer;             /*!< Working buffer (lenght values) */
+} dct_plan_t;
+/*==================[external data declaration]==============================*/
+
+/*==================[external functions declaration]=========================*/
+/**
+ * @brief Create a DCT plan
+ *
+ * @param plan      DCT plan
+ * @param lenght    Transform lenght (power of two, from 2 to DCT_MAX_LENGHT)
+ * @return true     Plan created
+ * @return false    Invalid lenght or not enough memory
+ */
+bool DCTPlanCreate(dct_plan_t * plan, uint16_t lenght);
+
+/**
+ * @brief Forward transform (DCT-II), in place
+ *
+ * @param plan      DCT plan
+ * @param data      Signal (lenght values), replaced by its DCT
+ */
+void DCTForward(dct_plan_t * plan, float * data);
+
+/**
+ * @brief Inverse transform (scaled DCT-III), in place
+ *
+ * @param plan      DCT plan
+ * @param data      DCT (lenght values), replaced by the signal
+ */
+void DCTInverse(dct_plan_t * plan, float * data);
+
+/**
+ * @brief Release the memory used by a DCT plan
+ *
+ * @param plan      DCT plan
+ */
+void DCTPlanDestroy(dct_plan_t * plan);
+
+/** @} doxygen end group definition */
+/** @} doxygen end group definition */
+/** @} doxygen end group definition */
+#endif /* DCT_H_ */
+
+/*==================[end of file]============================================*/
@@ -0,0 +1,98 @@
+#ifndef DCT_CODEC_H_
+#define DCT_CODEC_H_
+/** \addtogroup Drivers_Programable Drivers Programable
+ ** @{ */
+/** \addtogroup Middelware Middelware
+ ** @{ */
+/** \addtogroup DCT_Codec DCT Codec
+ */
+
+/** \brief Block transform coding of 16 bit signals (ECG, accelerometer...) to store or transmit them at low bitrates
+ *
+ * Each block of block_lenght samples is:
+ * - Transformed (orthonormal DCT-II), so the signal energy concentrates in a few low frequency coefficients.
+ * - Quantized with a uniform step (in signal units): the reconstruction error is about step / sqrt(12) rms
+ *   for the coefficients kept, coefficients below step / 2 become zero.
+ * - Packed as one variable lenght integer (7 bits per byte) per non zero coefficient, holding its value
+ *   (zigzag coded sign) and the zero run before it, ended by a 0 byte. Small coefficients take one byte,
+ *   trailing zeros cost nothing and the output is byte aligned, so a generic entropy coder (or the link
+ *   compression) can shrink it further.
+ *
+ * Blocks are independent: a lost block doesn't affect the others.
+ *
+ * @author Peñalva Albano
+ *
+ * @section changelog
+ *
+ * |   Date	    | Description                                    						|
+ * |:----------:|:----------------------------------------------------------------------|
+ * | 17/10/2026 | Document creation		                         						|
+ *
+ **/
+
+/*==================[inclusions]=============================================*/
+#include <stdint.h>
+#include <stdbool.h>
+#include "dct.h"
+/*==================[macros]=================================================*/
+#define DCT_CODEC_MAX_BYTES(n)  (8 * (n) + 1)   /*!< Worst case encoded size of a block of n samples */
+
+/*==================[typedef]================================================*/
+/**
+ * @brief DCT codec object
+ */
+typedef struct {
+    dct_plan_t plan;            /*!< Transform of block_lenght points */
+    float * block;              /*!< Block being coded (block_lenght values) */
+    float quant[2];             /*!< DCT to quantized coefficient gain (DC, AC) */
+    float dequant[2];           /*!< Quantized coefficient to DCT gain (DC, AC) */
+} dct_codec_t;
+/*==================[external data declaration]==============================*/
+
+/*==================[external functions declaration]=========================*/
+/**
+ * @brief Initialize a DCT codec object (the same parameters must be used to encode and decode)
+ *
+ * @param codec         DCT codec object
+ * @param block_lenght  Samples per block (power of two, from 2 to DCT_MAX_LENGHT)
+ * @param step          Quantization step (signal units, higher is smaller and less accurate)
+ * @return true         Codec initialized
+ * @return false        Invalid parameters or not enough memory
+ */
+bool DCTCodecInit(dct_codec_t * codec, uint16_t block_lenght, float step);
+
+/**
+ * @brief Encode a block
+ *
+ * @param codec         DCT codec object
+ * @param signal        block_lenght samples
+ * @param data          Encoded block
+ * @param data_size     Size of the data buffer (DCT_CODEC_MAX_BYTES(block_lenght) always fits)
+ * @return              Encoded bytes, 0 if data_size is not enough
+ */
+uint16_t DCTCodecEncode(dct_codec_t * codec, const int16_t * signal, uint8_t * data, uint16_t data_size);
+
+/**
+ * @brief Decode a block
+ *
+ * @param codec         DCT codec object
+ * @param data          Encoded block (following blocks may come after it)
+ * @param data_lenght   Available bytes
+ * @param signal        block_lenght reconstructed samples
+ * @return              Bytes used by the block, 0 if data is corrupt or incomplete
+ */
+uint16_t DCTCodecDecode(dct_codec_t * codec, const uint8_t * data, uint16_t data_lenght, int16_t * signal);
+
+/**
+ * @brief Release the memory used by a DCT codec object
+ *
+ * @param codec         DCT codec object
+ */
+void DCTCodecDeinit(dct_codec_t * codec);
+
+/** @} doxygen end group definition */
+/** @} doxygen end group definition */
+/** @} doxygen end group definition */
+#endif /* DCT_CODEC_H_ */
+
+/*==================[end of file]============================================*/
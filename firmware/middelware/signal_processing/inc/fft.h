@@ -16,6 +16,12 @@
  * |   Date	    | Description                                    						|
  * |:----------:|:----------------------------------------------------------------------|
  * | 15/03/2024 | Document creation		                         						|
+ * | 17/10/2026 | FFT plans with cached window and real-input transform					|
+ * | 17/10/2026 | Fixed-point (Q15) spectrum for raw ADC blocks							|
+ * | 17/10/2026 | FFT magnitude of a frame stored in a ring buffer						|
+ * | 17/10/2026 | Constant FFT tables in flash, no table computed at init				|
+ * | 17/10/2026 | Power, dB and fast magnitude outputs for FFT plans					|
+ * | 17/10/2026 | Block floating point scaling in the fixed-point (Q15) spectrum			|
  * 
  **/
 
@@ -24,7 +30,50 @@
 #include <stdbool.h>
 /*==================[macros]=================================================*/
 #define MAX_SIGNAL_LENGHT   2048
+#define ADC_Q15_SHIFT       3       /*!< Shift from 12 bit ADC counts to Q15 (4096 counts = 1.0) */
 /*==================[typedef]================================================*/
+/**
+ * @brief Window applied to the signal before the transform
+ */
+typedef enum fft_window {
+    FFT_WINDOW_NONE = 0,        /*!< Rectangular window (no windowing) */
+    FFT_WINDOW_HANN,            /*!< Hann window */
+    FFT_WINDOW_BLACKMAN,        /*!< Blackman window */
+    FFT_WINDOW_BLACKMAN_HARRIS, /*!< Blackman-Harris window */
+    FFT_WINDOW_NUTTALL,         /*!< Nuttall window */
+    FFT_WINDOW_FLAT_TOP         /*!< Flat-Top window */
+} fft_window_t;
+
+/**
+ * @brief Output of the FFT plans, all in the FFTMagnitude() scale
+ * 
+ * Without a FPU every square root or logarithm is a long software routine: the power and the
+ * approximated outputs avoid them.
+ */
+typedef enum fft_output {
+    FFT_OUTPUT_MAGNITUDE = 0,   /*!< Magnitude (sqrtf()) */
+    FFT_OUTPUT_MAGNITUDE_FAST,  /*!< Magnitude, approximated square root (relative error below 0.2 %) */
+    FFT_OUTPUT_POWER,           /*!< Squared magnitude (no square root) */
+    FFT_OUTPUT_DB               /*!< Magnitude in dB (20 * log10), approximated logarithm (error below 0.001 dB) */
+} fft_output_t;
+
+/**
+ * @brief FFT plan: tables and buffers for a fixed signal lenght and window
+ * 
+ * A real signal of signal_lenght samples is transformed as a complex signal of
+ * signal_lenght / 2 samples (even samples as real part, odd samples as imaginary part)
+ * and then split into the real signal spectrum.
+ */
+typedef struct {
+    uint16_t signal_lenght;     /*!< Number of real samples per frame */
+    fft_window_t window;        /*!< Window applied before the transform */
+    fft_output_t output;        /*!< Output of FFTPlanMagnitude() and FFTPlanMagnitudeRing() */
+    float * wind;               /*!< Window coefficients (signal_lenght values) */
+    const float * twiddle;      /*!< cos/sin pairs used to split the real spectrum (signal_lenght / 4 + 1 pairs, flash) */
+    const uint16_t * bit_rev;   /*!< Bit reverse swap pairs for the signal_lenght / 2 points transform (flash) */
+    uint16_t bit_rev_size;      /*!< Number of swap pairs in bit_rev */
+    float * buffer;             /*!< Working buffer (signal_lenght / 2 complex values) */
+} fft_plan_t;
 
 /*==================[external data declaration]==============================*/
 
@@ -32,6 +81,8 @@
 /**
  * @brief Initialize the FFT calculation module
  * 
+ * Twiddles are the constant (flash) tables of fft_tables.h, nothing is computed or allocated.
+ * 
  * @return true     FFT initialized
  * @return false    Not possible to initialize FFT
  */
@@ -57,6 +108,118 @@ void FFTMagnitude(float * signal, float * fft, uint16_t signal_lenght);
  */
 void FFTFrequency(float sample_freq, uint16_t signal_lenght, float * f);
 
+/**
+ * @brief Create a FFT plan for a given signal lenght and window
+ * 
+ * @note  FFTInit() must be called before using the plan.
+ * @note  Lenght of signal must be a power of two (from 4 to MAX_SIGNAL_LENGHT)
+ * 
+ * @param plan              Plan to initialize
+ * @param signal_lenght     Lenght of signal arrays
+ * @param window            Window to apply before the transform
+ * @return true             Plan created
+ * @return false            Invalid lenght or not enough memory
+ */
+bool FFTPlanCreate(fft_plan_t * plan, uint16_t signal_lenght, fft_window_t window);
+
+/**
+ * @brief Select the output of a plan (FFT_OUTPUT_MAGNITUDE when created)
+ * 
+ * @param plan              FFT plan
+ * @param output            Output of FFTPlanMagnitude() and FFTPlanMagnitudeRing()
+ */
+void FFTPlanSetOutput(fft_plan_t * plan, fft_output_t output);
+
+/**
+ * @brief Calculates the FFT magnitude of a signal using a previously created plan
+ * 
+ * @note  Output scale is the same as FFTMagnitude(), as magnitude, power or dB (see FFTPlanSetOutput())
+ * 
+ * @param plan              FFT plan
+ * @param signal            Array with signal values (of lenght = plan->signal_lenght)
+ * @param fft               Array to store FFT magnitude values (of lenght = plan->signal_lenght / 2)
+ */
+void FFTPlanMagnitude(fft_plan_t * plan, float * signal, float * fft);
+
+/**
+ * @brief Calculates the FFT magnitude of a frame stored in a ring buffer using a previously created plan
+ * 
+ * The frame is ring[start], ..., ring[signal_lenght - 1], ring[0], ..., ring[start - 1], so
+ * overlapping frames can be transformed without first copying them into a linear array.
+ * 
+ * @param plan              FFT plan
+ * @param ring              Ring buffer (of lenght = plan->signal_lenght)
+ * @param start             Index of the oldest sample of the frame
+ * @param fft               Array to store FFT magnitude values (of lenght = plan->signal_lenght / 2)
+ */
+void FFTPlanMagnitudeRing(fft_plan_t * plan, float * ring, uint16_t start, float * fft);
+
+/**
+ * @brief Real FFT of the signal in plan->buffer, in place (the plan window is not applied)
+ * 
+ * The result is packed as signal_lenght / 2 complex values: X[0] and X[signal_lenght / 2]
+ * (both real) in the first one, then X[1] ... X[signal_lenght / 2 - 1]. Spectra in this format
+ * can be multiplied bin by bin (fast convolution and correlation) and transformed back with
+ * FFTPlanInverse().
+ * 
+ * @param plan              FFT plan (plan->buffer holds plan->signal_lenght samples)
+ */
+void FFTPlanForward(fft_plan_t * plan);
+
+/**
+ * @brief Inverse of FFTPlanForward(), in place
+ * 
+ * @note  The result is scaled by plan->signal_lenght / 2.
+ * 
+ * @param plan              FFT plan (plan->buffer holds a packed spectrum)
+ */
+void FFTPlanInverse(fft_plan_t * plan);
+
+/**
+ * @brief Release the memory used by a FFT plan
+ * 
+ * @param plan              FFT plan
+ */
+void FFTPlanDestroy(fft_plan_t * plan);
+
+/**
+ * @brief Initialize the fixed-point (Q15) FFT calculation
+ * 
+ * @return true     FFT initialized
+ * @return false    Not possible to initialize FFT
+ */
+bool FFTInitQ15(void);
+
+/**
+ * @brief Calculates the Fast Fourier Transform magnitude of a raw ADC signal using integer arithmetic only
+ * 
+ * A Hann window is applied and the input block is normalized to use the full Q15 range before
+ * the transform, whose stages are scaled only when they need headroom (block floating point)
+ * instead of by a fixed 1/2 each. The result is in Q15, where 1.0 is the ADC full scale (4096
+ * counts), with the same normalization as FFTMagnitude() (i.e. fft[k] * 4096 / 32768 equals the
+ * FFTMagnitude() result for the same signal in counts). Values that exceed 1.0 saturate.
+ * 
+ * @note  Lenght of signal array must be a power of two (from 4 to MAX_SIGNAL_LENGHT)
+ * @note  Frequency axis is the same as for FFTMagnitude(), use FFTFrequency()
+ * 
+ * @param signal            Array with raw ADC values (12 bit, of lenght = signal_lenght)
+ * @param fft               Array to store FFT magnitude values in Q15 (of lenght = signal_lenght / 2)
+ * @param signal_lenght     Lenght of signal array
+ */
+void FFTMagnitudeQ15(uint16_t * signal, int16_t * fft, uint16_t signal_lenght);
+
+/**
+ * @brief Calculates the power spectrum of a raw ADC signal using integer arithmetic only
+ * 
+ * Same as FFTMagnitudeQ15() but without the square root: the result is the squared magnitude in Q30
+ * (not saturated to 1.0).
+ * 
+ * @param signal            Array with raw ADC values (12 bit, of lenght = signal_lenght)
+ * @param power             Array to store power values in Q30 (of lenght = signal_lenght / 2)
+ * @param signal_lenght     Lenght of signal array
+ */
+void FFTPowerQ15(uint16_t * signal, uint32_t * power, uint16_t signal_lenght);
+
 /** @} doxygen end group definition */
 /** @} doxygen end group definition */
 /** @} doxygen end group definition */
@@ -0,0 +1,85 @@
+#ifndef FFT_TABLES_H_
+#define FFT_TABLES_H_
+/** \addtogroup Drivers_Programable Drivers Programable
+ ** @{ */
+/** \addtogroup Middelware Middelware
+ ** @{ */
+/** \addtogroup FFT_Tables FFT Tables
+ */
+
+/** \brief Constant FFT tables, computed by the compiler (constexpr) and stored in flash
+ *
+ * Cover every power of two transform used by the FFT module (up to MAX_SIGNAL_LENGHT real samples),
+ * so no table has to be computed or allocated at boot:
+ * - Radix 2 twiddles (fc32 and sc16) in the bit reversed order expected by dsps_fft2r_fc32() and
+ *   dsps_fft2r_sc16(). The table of the largest transform also serves every smaller one.
+ * - cos/sin pairs used to split a half lenght complex spectrum into a real signal spectrum.
+ * - Bit reverse swap pairs (byte offsets) for dsps_bit_rev_lookup_fc32().
+ *
+ * @author Peñalva Albano
+ *
+ * @section changelog
+ *
+ * |   Date	    | Description                                    						|
+ * |:----------:|:----------------------------------------------------------------------|
+ * | 17/10/2026 | Document creation		                         						|
+ *
+ **/
+
+/*==================[inclusions]=============================================*/
+#include <stdint.h>
+#include "fft.h"
+/*==================[macros]=================================================*/
+#define FFT_W_TABLE_SIZE    MAX_SIGNAL_LENGHT           /*!< Twiddle table size (values): MAX_SIGNAL_LENGHT / 2 complex points transforms and their real split (dsps_cplx2real) */
+
+/*==================[typedef]================================================*/
+
+/*==================[external data declaration]==============================*/
+
+/*==================[external functions declaration]=========================*/
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Radix 2 twiddles for dsps_fft2r_fc32() (cos, sin pairs in bit reversed order)
+ *
+ * @return      FFT_W_TABLE_SIZE values
+ */
+const float * FFTTableTwiddle(void);
+
+/**
+ * @brief Radix 2 twiddles for dsps_fft2r_sc16() (Q15 cos, sin pairs in bit reversed order)
+ *
+ * @return      FFT_W_TABLE_SIZE values
+ */
+const int16_t * FFTTableTwiddleQ15(void);
+
+/**
+ * @brief cos/sin pairs to split the spectrum of a real signal transformed as a half lenght complex signal
+ *
+ * @param signal_lenght     Real signal lenght (power of two, from 4 to MAX_SIGNAL_LENGHT)
+ * @return                  cos(2*pi*k/signal_lenght), sin(2*pi*k/signal_lenght) pairs for k = 0 to
+ *                          signal_lenght / 4, NULL for invalid lenghts
+ */
+const float * FFTTableSplit(uint16_t signal_lenght);
+
+/**
+ * @brief Bit reverse swap pairs of a complex transform
+ *
+ * @param n         Complex transform points (power of two, from 2 to MAX_SIGNAL_LENGHT / 2)
+ * @param pairs     Number of swap pairs
+ * @return          Swap pairs as byte offsets, NULL for invalid lenghts
+ */
+const uint16_t * FFTTableBitRev(uint16_t n, uint16_t * pairs);
+
+#ifdef __cplusplus
+}
+#endif
+
+/** @} doxygen end group definition */
+/** @} doxygen end group definition */
+/** @} doxygen end group definition */
+#endif /* FFT_TABLES_H_ */
+
+/*==================[end of file]============================================*/
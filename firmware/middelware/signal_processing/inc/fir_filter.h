@@ -0,0 +1,117 @@
+#ifndef FIR_FILTER_H_
+#define FIR_FILTER_H_
+/** \addtogroup Drivers_Programable Drivers Programable
+ ** @{ */
+/** \addtogroup Middelware Middelware
+ ** @{ */
+/** \addtogroup FIR_Filter FIR Filter
+ */
+
+/** \brief Block FIR filter for long filters (matched filters, equalizers)
+ * 
+ * Short filters run in direct form (dsps_fir_f32()). Long filters use overlap-save FFT
+ * convolution with the real-input transform of the FFT plans (n / 2 points complex FFT
+ * and split), one forward and one inverse transform per block. The method is chosen at init
+ * from the number of taps and the block lenght.
+ * 
+ * @author Peñalva Albano
+ *
+ * @section changelog
+ *
+ * |   Date	    | Description                                    						|
+ * |:----------:|:----------------------------------------------------------------------|
+ * | 17/10/2026 | Document creation		                         						|
+ * 
+ **/
+
+/*==================[inclusions]=============================================*/
+#include <stdint.h>
+#include <stdbool.h>
+#include "dsps_fir.h"
+#include "fft.h"
+/*==================[macros]=================================================*/
+/** Cost of a radix-2 butterfly relative to a direct form tap (multiply-accumulate), used to choose
+ * the method. "FIRFilterApply benchmark" prints the value that matches the measure. With the ANSI
+ * kernels (-O2 on x86) it measures 2.5 to 5 and overlap-save wins from 32-64 taps with blocks of 256.
+ * The ESP32-C6 (RISC-V) has no optimized esp-dsp kernels and runs these ANSI kernels, but it has not
+ * been measured on that target yet. The SSE direct form of x86 hosts (CONFIG_DSP_OPTIMIZED) makes
+ * taps cheaper, it measures 14 to 18. Define the value in the build flags to calibrate a target. */
+#ifndef FIR_FFT_BUTTERFLY_COST
+#if CONFIG_DSP_OPTIMIZED && (dsps_fir_f32_x86_enabled == 1)
+#define FIR_FFT_BUTTERFLY_COST  16.0f
+#else
+#define FIR_FFT_BUTTERFLY_COST  4.0f
+#endif
+#endif
+
+/*==================[typedef]================================================*/
+/**
+ * @brief FIR filter implementation
+ */
+typedef enum fir_method {
+    FIR_AUTO,           /*!< Choose the cheapest method (only as FIRFilterInit() parameter) */
+    FIR_DIRECT,         /*!< Direct form convolution */
+    FIR_FFT             /*!< Overlap-save FFT convolution */
+} fir_method_t;
+
+/**
+ * @brief FIR filter object
+ */
+typedef struct {
+    fir_method_t method;        /*!< Method in use (FIR_DIRECT or FIR_FFT) */
+    uint16_t n_taps;            /*!< Number of taps */
+    uint16_t block_lenght;      /*!< Samples per block */
+    fir_f32_t fir;              /*!< Direct form filter (FIR_DIRECT) */
+    fft_plan_t plan;            /*!< Transform tables and buffer, block_lenght + n_taps - 1 points or more (FIR_FFT) */
+    float * coeff;              /*!< Reversed taps (FIR_DIRECT) or packed taps spectrum (FIR_FFT) */
+    float * line;               /*!< Last n_taps - 1 input samples followed by one block (FIR_FFT) */
+} fir_filter_t;
+/*==================[external data declaration]==============================*/
+
+/*==================[external functions declaration]=========================*/
+/**
+ * @brief Initialize a FIR filter object
+ * 
+ * @note  FFTInit() must be called before, the FFT method uses its tables.
+ * @note  The FFT method needs block_lenght + n_taps - 1 <= MAX_SIGNAL_LENGHT.
+ * 
+ * @param filter        Filter object
+ * @param coeff         Filter taps: y[n] = coeff[0] * x[n] + ... + coeff[n_taps - 1] * x[n - n_taps + 1] (copied)
+ * @param n_taps        Number of taps
+ * @param block_lenght  Samples per block, FIRFilterApply() lenghts must be multiples of it
+ * @param method        FIR_AUTO to choose the cheapest method, or the method to use
+ * @return true         Filter initialized
+ * @return false        Invalid parameters or not enough memory
+ */
+bool FIRFilterInit(fir_filter_t * filter, float * coeff, uint16_t n_taps, uint16_t block_lenght, fir_method_t method);
+
+/**
+ * @brief Apply a FIR filter object to a signal array
+ * 
+ * @param filter            Filter object
+ * @param input_signal      Input signal array
+ * @param output_signal     Filtered signal array (can be the same as input_signal)
+ * @param signal_lenght     Number of samples of both signals (multiple of block_lenght)
+ */
+void FIRFilterApply(fir_filter_t * filter, float * input_signal, float * output_signal, uint16_t signal_lenght);
+
+/**
+ * @brief Clear the state of a FIR filter object
+ * 
+ * @param filter        Filter object
+ */
+void FIRFilterReset(fir_filter_t * filter);
+
+/**
+ * @brief Release the memory used by a FIR filter object
+ * 
+ * @param filter        Filter object
+ */
+void FIRFilterDeinit(fir_filter_t * filter);
+
+/** @} doxygen end group definition */
+/** @} doxygen end group definition */
+/** @} doxygen end group definition */
+#endif /* FIR_FILTER_H_ */
+
+/*==================[end of file]============================================*/
@@ -16,12 +16,17 @@
  * |   Date	    | Description                                    						|
  * |:----------:|:----------------------------------------------------------------------|
  * | 15/03/2024 | Document creation		                         						|
+ * | 17/10/2026 | Multi-instance and multi-channel filter objects						|
+ * | 17/10/2026 | Single pass cascade, band pass and notch filters						|
+ * | 17/10/2026 | Fixed-point (Q15 data, Q30 coefficients) filter objects				|
  * 
  **/
 
 /*==================[inclusions]=============================================*/
 #include <stdint.h>
+#include <stdbool.h>
 /*==================[macros]=================================================*/
+#define IIR_MAX_CHANNELS    8   /*!< Maximum number of channels filtered by one filter object */
 
 /*==================[typedef]================================================*/
 typedef enum filter_order {
@@ -30,6 +35,36 @@ typedef enum filter_order {
     ORDER_6 = 6,        /*!< 6th order filter */
     ORDER_8 = 8         /*!< 8th order filter */
 } filter_order_t;
+
+/**
+ * @brief Butterworth filter response
+ */
+typedef enum filter_type {
+    LOW_PASS,           /*!< Low pass filter */
+    HI_PASS             /*!< Hi pass filter */
+} filter_type_t;
+
+/**
+ * @brief IIR filter object: cascade of second order sections with its own state for each channel
+ */
+typedef struct {
+    uint8_t n_sos;          /*!< Number of second order sections (order / 2) */
+    uint8_t n_channels;     /*!< Number of channels */
+    float * coeff;          /*!< Sections coefficients, 5 per section (b0, b1, b2, a1, a2) */
+    float * delay;          /*!< Sections state, 2 per section and channel (channel major) */
+} iir_filter_t;
+
+/**
+ * @brief Fixed-point IIR filter object: Q15 samples, Q30 coefficients
+ * 
+ * Designed in floating point at init and converted once, so filtering only uses integer arithmetic.
+ */
+typedef struct {
+    uint8_t n_sos;          /*!< Number of second order sections (order / 2) */
+    uint8_t n_channels;     /*!< Number of channels */
+    int32_t * coeff;        /*!< Sections coefficients in Q30, 5 per section (b0, b1, b2, a1, a2) */
+    int32_t * delay;        /*!< Sections state, 5 per section and channel (channel major) */
+} iir_filter_q15_t;
 /*==================[external data declaration]==============================*/
 
 /*==================[external functions declaration]=========================*/
@@ -69,6 +104,133 @@ void LowPassFilter(float * input_signal, float * output_signal, int16_t signal_l
  */
 void HiPassFilter(float * input_signal, float * output_signal, int16_t signal_lenght);
 
+/**
+ * @brief Initialize a Butterworth filter object
+ * 
+ * @param filter        Filter object
+ * @param type          Filter response (LOW_PASS or HI_PASS)
+ * @param sample_frec   Signal's sample frequency
+ * @param cut_frec      Filter's cut-off frequency
+ * @param order         Filter's order (any even order)
+ * @param n_channels    Number of channels to filter independently (1 to IIR_MAX_CHANNELS)
+ * @return true         Filter initialized
+ * @return false        Invalid parameters or not enough memory
+ */
+bool IIRFilterInit(iir_filter_t * filter, filter_type_t type, float sample_frec, float cut_frec, uint8_t order, uint8_t n_channels);
+
+/**
+ * @brief Initialize a Butterworth band pass filter object
+ * 
+ * The filter is a hi pass filter followed by a low pass filter, both of the given order.
+ * 
+ * @param filter        Filter object
+ * @param sample_frec   Signal's sample frequency
+ * @param low_frec      Band's lower cut-off frequency
+ * @param hi_frec       Band's upper cut-off frequency
+ * @param order         Order of each of the hi pass and low pass filters (any even order)
+ * @param n_channels    Number of channels to filter independently (1 to IIR_MAX_CHANNELS)
+ * @return true         Filter initialized
+ * @return false        Invalid parameters or not enough memory
+ */
+bool IIRBandPassInit(iir_filter_t * filter, float sample_frec, float low_frec, float hi_frec, uint8_t order, uint8_t n_channels);
+
+/**
+ * @brief Initialize a notch filter object (e.g. to reject 50/60 Hz mains interference)
+ * 
+ * @param filter        Filter object
+ * @param sample_frec   Signal's sample frequency
+ * @param notch_frec    Frequency to reject
+ * @param q             Notch's quality factor (notch_frec / rejected bandwidth)
+ * @param n_harmonics   Number of rejected frequencies: notch_frec and its harmonics below sample_frec / 2
+ * @param n_channels    Number of channels to filter independently (1 to IIR_MAX_CHANNELS)
+ * @return true         Filter initialized
+ * @return false        Invalid parameters or not enough memory
+ */
+bool IIRNotchInit(iir_filter_t * filter, float sample_frec, float notch_frec, float q, uint8_t n_harmonics, uint8_t n_channels);
+
+/**
+ * @brief Apply a filter object to one channel signal array
+ * 
+ * @param filter            Filter object
+ * @param channel           Channel whose state is used (0 to n_channels - 1)
+ * @param input_signal      Input signal array
+ * @param output_signal     Filtered signal array (can be the same as input_signal)
+ * @param signal_lenght     Number of samples of both signals
+ */
+void IIRFilterApply(iir_filter_t * filter, uint8_t channel, float * input_signal, float * output_signal, int16_t signal_lenght);
+
+/**
+ * @brief Apply a filter object to all its channels at once
+ * 
+ * Samples are interleaved: input_signal[i * n_channels + ch] is sample i of channel ch. All the
+ * sections are applied to each frame of samples in a single pass, the coefficients of a section
+ * are loaded once for up to 4 channels (dsps_biquad_sos_mc_f32()).
+ * 
+ * @param filter            Filter object
+ * @param input_signal      Interleaved input signal array
+ * @param output_signal     Interleaved filtered signal array (can be the same as input_signal)
+ * @param signal_lenght     Number of samples per channel
+ */
+void IIRFilterApplyInterleaved(iir_filter_t * filter, float * input_signal, float * output_signal, int16_t signal_lenght);
+
+/**
+ * @brief Clear the state of all channels of a filter object
+ * 
+ * @param filter        Filter object
+ */
+void IIRFilterReset(iir_filter_t * filter);
+
+/**
+ * @brief Release the memory used by a filter object
+ * 
+ * @param filter        Filter object
+ */
+void IIRFilterDeinit(iir_filter_t * filter);
+
+/**
+ * @brief Initialize a fixed-point Butterworth filter object
+ * 
+ * Coefficients are rounded to Q30, which keeps the noise floor below -80 dBFS for cut-off
+ * frequencies from 0.001 to 0.45 of sample_frec (about -100 dBFS above 0.01).
+ * 
+ * @param filter        Filter object
+ * @param type          Filter response (LOW_PASS or HI_PASS)
+ * @param sample_frec   Signal's sample frequency
+ * @param cut_frec      Filter's cut-off frequency
+ * @param order         Filter's order (any even order)
+ * @param n_channels    Number of channels to filter independently (1 to IIR_MAX_CHANNELS)
+ * @return true         Filter initialized
+ * @return false        Invalid parameters or not enough memory
+ */
+bool IIRFilterInitQ15(iir_filter_q15_t * filter, filter_type_t type, float sample_frec, float cut_frec, uint8_t order, uint8_t n_channels);
+
+/**
+ * @brief Apply a fixed-point filter object to one channel Q15 signal array
+ * 
+ * Overflows saturate the output to the int16_t range instead of wrapping around.
+ * 
+ * @param filter            Filter object
+ * @param channel           Channel whose state is used (0 to n_channels - 1)
+ * @param input_signal      Input signal array (Q15)
+ * @param output_signal     Filtered signal array (Q15, can be the same as input_signal)
+ * @param signal_lenght     Number of samples of both signals
+ */
+void IIRFilterApplyQ15(iir_filter_q15_t * filter, uint8_t channel, int16_t * input_signal, int16_t * output_signal, int16_t signal_lenght);
+
+/**
+ * @brief Clear the state of all channels of a fixed-point filter object
+ * 
+ * @param filter        Filter object
+ */
+void IIRFilterResetQ15(iir_filter_q15_t * filter);
+
+/**
+ * @brief Release the memory used by a fixed-point filter object
+ * 
+ * @param filter        Filter object
+ */
+void IIRFilterDeinitQ15(iir_filter_q15_t * filter);
+
 /** @} doxygen end group definition */
 /** @} doxygen end group definition */
 /** @} doxygen end group definition */
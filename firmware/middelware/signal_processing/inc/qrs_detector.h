@@ -0,0 +1,140 @@
+#ifndef QRS_DETECTOR_H_
+#define QRS_DETECTOR_H_
+/** \addtogroup Drivers_Programable Drivers Programable
+ ** @{ */
+/** \addtogroup Middelware Middelware
+ ** @{ */
+/** \addtogroup QRS_Detector QRS Detector
+ */
+
+/** \brief Pan-Tompkins QRS (heart beat) detector, integer arithmetic only
+ *
+ * Processing chain (filter lenghts scaled from the original 200 Hz design to sample_frec):
+ * - Band pass 5 - 15 Hz: integer low pass (1 - z^-m)^2 / (1 - z^-1)^2 followed by an integer high pass
+ *   (delayed input minus moving average).
+ * - Five point derivative, squaring and 150 ms moving window integration.
+ * - Peak detection on the integrated signal with adaptive signal / noise thresholds, 200 ms refractory
+ *   period, T wave discrimination (360 ms) and search back for missed beats (166 % of the average RR).
+ *
+ * Thresholds are learned during the first QRS_LEARNING_TIME ms, beats are reported from then on.
+ * Beat timestamps are the R wave: the input extreme next to the band pass extreme of each integration peak.
+ *
+ * @author Peñalva Albano
+ *
+ * @section changelog
+ *
+ * |   Date	    | Description                                    						|
+ * |:----------:|:----------------------------------------------------------------------|
+ * | 17/10/2026 | Document creation		                         						|
+ *
+ **/
+
+/*==================[inclusions]=============================================*/
+#include <stdint.h>
+#include <stdbool.h>
+/*==================[macros]=================================================*/
+#define QRS_LEARNING_TIME   2000    /*!< Threshold learning phase (ms) */
+
+/*==================[typedef]================================================*/
+/**
+ * @brief Detected beat
+ */
+typedef struct {
+    uint32_t sample;            /*!< Sample index of the QRS complex (counted from QRSDetectorInit) */
+    uint16_t rr;                /*!< Samples since the previous beat (0 for the first beat) */
+    uint16_t heart_rate;        /*!< Instantaneous heart rate in beats per minute (0 for the first beat) */
+} qrs_beat_t;
+
+/**
+ * @brief QRS detector object
+ */
+typedef struct {
+    uint16_t sample_frec;       /*!< Sample frequency (Hz) */
+    uint8_t lp_lenght;          /*!< Low pass moving sums lenght */
+    uint8_t hp_lenght;          /*!< High pass moving average lenght */
+    uint8_t mwi_lenght;         /*!< Moving window integration lenght */
+    uint8_t raw_lenght;         /*!< Input delay line lenght (band pass delay plus half the low pass) */
+    uint8_t bp_shift;           /*!< Band pass gain compensation (right shift) */
+    uint8_t lp_pos;             /*!< Low pass delay lines index */
+    uint8_t hp_pos;             /*!< High pass delay line index */
+    uint8_t mwi_pos;            /*!< Integration delay line index */
+    uint8_t dif_pos;            /*!< Derivative delay line index */
+    uint8_t raw_pos;            /*!< Input delay line index */
+    uint16_t delay;             /*!< Band pass delay (samples) */
+    int32_t * lp_line;          /*!< Low pass delay lines (2 x lp_lenght) */
+    int32_t * hp_line;          /*!< High pass delay line (hp_lenght) */
+    int32_t * mwi_line;         /*!< Integration delay line (mwi_lenght) */
+    int32_t * raw_line;         /*!< Input delay line (raw_lenght) */
+    int32_t dif_line[4];        /*!< Derivative delay line */
+    int32_t lp_sum[2];          /*!< Low pass moving sums */
+    int32_t hp_sum;             /*!< High pass moving sum */
+    int32_t mwi_sum;            /*!< Integrated signal */
+    int32_t square_max;         /*!< Squared derivative saturation (keeps mwi_sum within 32 bit) */
+    uint32_t n;                 /*!< Samples processed */
+    int32_t peak;               /*!< Current integration peak */
+    uint32_t peak_n;            /*!< Sample index of the current peak */
+    int32_t slope;              /*!< Steepest squared slope of the current peak */
+    int32_t r_max;              /*!< Band pass extreme (absolute value) of the current peak */
+    uint32_t r_n;               /*!< Sample index of the R wave of r_max */
+    int32_t spki;               /*!< Signal peak level */
+    int32_t npki;               /*!< Noise peak level */
+    int32_t threshold;          /*!< Detection threshold */
+    int32_t learn_max;          /*!< Highest integrated value of the learning phase */
+    int64_t learn_sum;          /*!< Integrated values sum of the learning phase */
+    uint32_t last_qrs;          /*!< Sample index (integration peak) of the last beat */
+    int32_t last_slope;         /*!< Steepest squared slope of the last beat */
+    uint16_t rr_avg;            /*!< Average RR interval (samples, starts at one second) */
+    int32_t back_peak;          /*!< Highest discarded peak above threshold / 2 since the last beat */
+    uint32_t back_n;            /*!< Sample index of back_peak */
+    uint32_t back_r_n;          /*!< Sample index of the R wave of back_peak */
+    int32_t back_slope;         /*!< Steepest squared slope of back_peak */
+    bool beat_found;            /*!< At least one beat detected */
+} qrs_detector_t;
+/*==================[external data declaration]==============================*/
+
+/*==================[external functions declaration]=========================*/
+/**
+ * @brief Initialize a QRS detector object
+ *
+ * @param detector      QRS detector object
+ * @param sample_frec   Sample frequency (100 to 500 Hz)
+ * @return true         Detector initialized
+ * @return false        Invalid sample frequency or not enough memory
+ */
+bool QRSDetectorInit(qrs_detector_t * detector, uint16_t sample_frec);
+
+/**
+ * @brief Process an ECG signal block
+ *
+ * Blocks can be of any lenght, the detector state is kept between calls. Beats found by search back
+ * are reported late, with their own timestamp.
+ *
+ * @param detector          QRS detector object
+ * @param signal            ECG samples (raw ADC values or any signed 16 bit scale)
+ * @param signal_lenght     Number of samples
+ * @param beats             Detected beats array
+ * @param max_beats         Size of the beats array
+ * @return                  Number of beats detected in this block
+ */
+uint8_t QRSDetectorProcess(qrs_detector_t * detector, const int16_t * signal, uint16_t signal_lenght, qrs_beat_t * beats, uint8_t max_beats);
+
+/**
+ * @brief Restart the detector (including the learning phase)
+ *
+ * @param detector      QRS detector object
+ */
+void QRSDetectorReset(qrs_detector_t * detector);
+
+/**
+ * @brief Release the memory used by a QRS detector object
+ *
+ * @param detector      QRS detector object
+ */
+void QRSDetectorDeinit(qrs_detector_t * detector);
+
+/** @} doxygen end group definition */
+/** @} doxygen end group definition */
+/** @} doxygen end group definition */
+#endif /* QRS_DETECTOR_H_ */
+
+/*==================[end of file]============================================*/
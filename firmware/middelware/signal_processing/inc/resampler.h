@@ -0,0 +1,170 @@
+#ifndef RESAMPLER_H_
+#define RESAMPLER_H_
+/** \addtogroup Drivers_Programable Drivers Programable
+ ** @{ */
+/** \addtogroup Middelware Middelware
+ ** @{ */
+/** \addtogroup Resampler Resampler
+ */
+
+/** \brief Sample rate reduction with anti-alias filtering
+ * 
+ * - Decimator: integer factor, split into stages (one per prime factor, e.g. 8 = 2 x 2 x 2)
+ *   each with its own anti-alias FIR, run with dsps_fird_f32() / dsps_fird_s16().
+ * - Resampler: rational factor up / down with a polyphase FIR (float only).
+ * 
+ * Anti-alias filters are Kaiser windowed-sinc designs: frequencies up to pass_frec are kept and
+ * everything that would alias onto them is attenuated at least RESAMPLER_ATTENUATION dB.
+ * 
+ * @author Peñalva Albano
+ *
+ * @section changelog
+ *
+ * |   Date	    | Description                                    						|
+ * |:----------:|:----------------------------------------------------------------------|
+ * | 17/10/2026 | Document creation		                         						|
+ * 
+ **/
+
+/*==================[inclusions]=============================================*/
+#include <stdint.h>
+#include <stdbool.h>
+#include "dsps_fir.h"
+/*==================[macros]=================================================*/
+#define DECIMATOR_MAX_STAGES    4       /*!< Maximum number of decimation stages */
+#define RESAMPLER_ATTENUATION   70      /*!< Anti-alias filters stopband attenuation (dB) */
+
+/*==================[typedef]================================================*/
+/**
+ * @brief Multi-stage decimator object
+ */
+typedef struct {
+    uint8_t decimation;                     /*!< Total decimation factor */
+    uint8_t n_stages;                       /*!< Number of stages */
+    fir_f32_t fir[DECIMATOR_MAX_STAGES];    /*!< Decimation FIR of each stage */
+} decimator_t;
+
+/**
+ * @brief Fixed-point multi-stage decimator object: Q15 coefficients and samples
+ */
+typedef struct {
+    uint8_t decimation;                     /*!< Total decimation factor */
+    uint8_t n_stages;                       /*!< Number of stages */
+    fir_s16_t fir[DECIMATOR_MAX_STAGES];    /*!< Decimation FIR of each stage */
+} decimator_q15_t;
+
+/**
+ * @brief Rational resampler object
+ */
+typedef struct {
+    uint8_t up;                 /*!< Interpolation factor */
+    uint8_t down;               /*!< Decimation factor */
+    uint16_t n_taps;            /*!< Taps per polyphase branch */
+    uint16_t phase;             /*!< Branch of the next output sample */
+    uint16_t pos;               /*!< Delay line index of the newest sample */
+    float * coeff;              /*!< Polyphase branches (up x n_taps, reversed) */
+    float * delay;              /*!< Delay line (2 x n_taps, stored twice to be read contiguously) */
+} resampler_t;
+/*==================[external data declaration]==============================*/
+
+/*==================[external functions declaration]=========================*/
+/**
+ * @brief Initialize a decimator object
+ * 
+ * @param decimator     Decimator object
+ * @param sample_frec   Input sample frequency
+ * @param decimation    Decimation factor (2 to 255, up to DECIMATOR_MAX_STAGES prime factors)
+ * @param pass_frec     Highest frequency to keep (lower than sample_frec / decimation / 2)
+ * @return true         Decimator initialized
+ * @return false        Invalid parameters or not enough memory
+ */
+bool DecimatorInit(decimator_t * decimator, float sample_frec, uint8_t decimation, float pass_frec);
+
+/**
+ * @brief Filter and decimate a signal block
+ * 
+ * @param decimator         Decimator object
+ * @param input_signal      Input signal array
+ * @param output_signal     Decimated signal array (signal_lenght / decimation, can be the same as input_signal)
+ * @param signal_lenght     Number of input samples (multiple of decimation)
+ * @return                  Number of output samples
+ */
+uint16_t DecimatorProcess(decimator_t * decimator, float * input_signal, float * output_signal, uint16_t signal_lenght);
+
+/**
+ * @brief Release the memory used by a decimator object
+ * 
+ * @param decimator     Decimator object
+ */
+void DecimatorDeinit(decimator_t * decimator);
+
+/**
+ * @brief Initialize a fixed-point decimator object
+ * 
+ * @param decimator     Decimator object
+ * @param sample_frec   Input sample frequency
+ * @param decimation    Decimation factor (2 to 255, up to DECIMATOR_MAX_STAGES prime factors)
+ * @param pass_frec     Highest frequency to keep (lower than sample_frec / decimation / 2)
+ * @return true         Decimator initialized
+ * @return false        Invalid parameters or not enough memory
+ */
+bool DecimatorInitQ15(decimator_q15_t * decimator, float sample_frec, uint8_t decimation, float pass_frec);
+
+/**
+ * @brief Filter and decimate a Q15 signal block using integer arithmetic only
+ * 
+ * Raw ADC blocks (12 bit values) can be decimated in place, casting them to int16_t.
+ * 
+ * @param decimator         Decimator object
+ * @param input_signal      Input signal array
+ * @param output_signal     Decimated signal array (signal_lenght / decimation, can be the same as input_signal)
+ * @param signal_lenght     Number of input samples (multiple of decimation)
+ * @return                  Number of output samples
+ */
+uint16_t DecimatorProcessQ15(decimator_q15_t * decimator, int16_t * input_signal, int16_t * output_signal, uint16_t signal_lenght);
+
+/**
+ * @brief Release the memory used by a fixed-point decimator object
+ * 
+ * @param decimator     Decimator object
+ */
+void DecimatorDeinitQ15(decimator_q15_t * decimator);
+
+/**
+ * @brief Initialize a rational resampler object (output frequency = sample_frec * up / down)
+ * 
+ * @param resampler     Resampler object
+ * @param sample_frec   Input sample frequency
+ * @param up            Interpolation factor (1 to 255)
+ * @param down          Decimation factor (1 to 255)
+ * @param pass_frec     Highest frequency to keep (lower than half of both input and output frequencies)
+ * @return true         Resampler initialized
+ * @return false        Invalid parameters or not enough memory
+ */
+bool ResamplerInit(resampler_t * resampler, float sample_frec, uint8_t up, uint8_t down, float pass_frec);
+
+/**
+ * @brief Resample a signal block
+ * 
+ * @param resampler         Resampler object
+ * @param input_signal      Input signal array
+ * @param output_signal     Resampled signal array, of at least signal_lenght * up / down + 1 values
+ *                          (can be the same as input_signal if up <= down)
+ * @param signal_lenght     Number of input samples (any lenght)
+ * @return                  Number of output samples
+ */
+uint16_t ResamplerProcess(resampler_t * resampler, float * input_signal, float * output_signal, uint16_t signal_lenght);
+
+/**
+ * @brief Release the memory used by a resampler object
+ * 
+ * @param resampler     Resampler object
+ */
+void ResamplerDeinit(resampler_t * resampler);
+
+/** @} doxygen end group definition */
+/** @} doxygen end group definition */
+/** @} doxygen end group definition */
+#endif /* RESAMPLER_H_ */
+
+/*==================[end of file]============================================*/
@@ -0,0 +1,129 @@
+#ifndef SIGNAL_QUALITY_H_
+#define SIGNAL_QUALITY_H_
+/** \addtogroup Drivers_Programable Drivers Programable
+ ** @{ */
+/** \addtogroup Middelware Middelware
+ ** @{ */
+/** \addtogroup Signal_Quality Signal Quality
+ */
+
+/** \brief Running SNR, SFDR, THD and noise floor of a channel from its FFT magnitude frames
+ *
+ * Each update takes a magnitude frame already computed for the channel (FFTMagnitude(),
+ * FFTPlanMagnitude() or the STFT frames), so no extra transform is needed, and costs one pass
+ * over the bins. Use one monitor per ADC channel.
+ *
+ * Per frame:
+ * - Bins 0 to lobe (DC and window leakage) are ignored.
+ * - The fundamental is the highest bin, its power is the sum of the bins within +-lobe
+ *   (main lobe and the strongest leakage of the window). Its frequency is interpolated on the log
+ *   magnitude: within 0.02 bins for Hann, Blackman-Harris and Nuttall, 0.15 bins for Flat-Top.
+ * - Harmonics 2 to n_harmonics are found at multiples of the (interpolated) fundamental
+ *   frequency, folded back if they exceed sample_frec / 2 (as the ADC aliases them).
+ * - The remaining bins are noise. Its mean power per bin is extended to the whole band,
+ *   so excluded bins do not lower the noise estimate, and subtracted from the fundamental
+ *   and harmonic bins.
+ *
+ * Powers are averaged along frames (exponentially, over about 'averaging' frames) and the
+ * ratios are calculated when they are read:
+ * - SNR: fundamental / noise
+ * - THD: harmonics / fundamental (negative dB)
+ * - SFDR: fundamental peak bin / highest other bin (harmonic or not)
+ * - Noise floor: rms noise per bin, in the frame units
+ *
+ * A low SNR or a noise floor rise flags, for example, a bad electrode contact or a noisy load cell.
+ * The window leakage of a tone between bins must be below the noise outside +-lobe bins: about 6 for
+ * Hann (FFTMagnitude()), 4 for Blackman-Harris and Nuttall (lower side lobes), 6 for Flat-Top (wider main lobe).
+ *
+ * @author Peñalva Albano
+ *
+ * @section changelog
+ *
+ * |   Date	    | Description                                    						|
+ * |:----------:|:----------------------------------------------------------------------|
+ * | 17/10/2026 | Document creation		                         						|
+ *
+ **/
+
+/*==================[inclusions]=============================================*/
+#include <stdint.h>
+#include <stdbool.h>
+/*==================[macros]=================================================*/
+#define SIGNAL_QUALITY_LOBE_HANN    6   /*!< Bins around a tone holding its Hann window leakage (the rest is below -55 dB) */
+#define SIGNAL_QUALITY_MAX_HARMONICS 10 /*!< Highest harmonic included in THD */
+
+/*==================[typedef]================================================*/
+/**
+ * @brief Signal quality estimates
+ */
+typedef struct {
+    float snr;                  /*!< Signal to noise ratio (dB) */
+    float sfdr;                 /*!< Spurious free dynamic range (dB) */
+    float thd;                  /*!< Total harmonic distortion (dB, negative) */
+    float noise_floor;          /*!< Noise rms per bin (frame units) */
+    float frequency;            /*!< Fundamental frequency (Hz) */
+} signal_quality_t;
+
+/**
+ * @brief Signal quality monitor object
+ */
+typedef struct {
+    uint16_t bins;              /*!< Bins per frame (signal_lenght / 2) */
+    float bin_frec;             /*!< Frequency step between bins (Hz) */
+    uint8_t lobe;               /*!< Bins around each tone holding its window leakage */
+    uint8_t n_harmonics;        /*!< Highest harmonic included in THD */
+    float alpha;                /*!< Averaging weight of each new frame */
+    uint32_t frames;            /*!< Frames averaged since init or reset */
+    float signal;               /*!< Fundamental power, without noise (average) */
+    float peak;                 /*!< Fundamental peak bin power (average) */
+    float harmonics;            /*!< Harmonics power, without noise (average) */
+    float spur;                 /*!< Highest bin power outside the fundamental (average) */
+    float noise;                /*!< Noise power per bin (average) */
+    float frequency;            /*!< Fundamental frequency, in bins (average) */
+} signal_quality_monitor_t;
+/*==================[external data declaration]==============================*/
+
+/*==================[external functions declaration]=========================*/
+/**
+ * @brief Initialize a signal quality monitor
+ *
+ * @param monitor           Signal quality monitor object
+ * @param sample_frec       Signal's sample frequency
+ * @param signal_lenght     Samples per FFT frame (the frames have signal_lenght / 2 bins)
+ * @param lobe              Bins around each tone holding its window leakage (see SIGNAL_QUALITY_LOBE_HANN)
+ * @param n_harmonics       Highest harmonic included in THD (2 to SIGNAL_QUALITY_MAX_HARMONICS)
+ * @param averaging         Frames averaged (1 for no averaging)
+ * @return true             Monitor initialized
+ * @return false            Invalid parameters
+ */
+bool SignalQualityInit(signal_quality_monitor_t * monitor, float sample_frec, uint16_t signal_lenght, uint8_t lobe, uint8_t n_harmonics, uint16_t averaging);
+
+/**
+ * @brief Update the estimates with a new magnitude frame
+ *
+ * @param monitor           Signal quality monitor object
+ * @param fft               FFT magnitude frame (signal_lenght / 2 values)
+ */
+void SignalQualityUpdate(signal_quality_monitor_t * monitor, const float * fft);
+
+/**
+ * @brief Read the current estimates
+ *
+ * @param monitor           Signal quality monitor object
+ * @param quality           Estimates (all zero before the first frame)
+ */
+void SignalQualityGet(signal_quality_monitor_t * monitor, signal_quality_t * quality);
+
+/**
+ * @brief Clear the averages (the next frame starts them again)
+ *
+ * @param monitor           Signal quality monitor object
+ */
+void SignalQualityReset(signal_quality_monitor_t * monitor);
+
+/** @} doxygen end group definition */
+/** @} doxygen end group definition */
+/** @} doxygen end group definition */
+#endif /* SIGNAL_QUALITY_H_ */
+
+/*==================[end of file]============================================*/
@@ -0,0 +1,99 @@
+#ifndef STFT_H_
+#define STFT_H_
+/** \addtogroup Drivers_Programable Drivers Programable
+ ** @{ */
+/** \addtogroup Middelware Middelware
+ ** @{ */
+/** \addtogroup STFT Short-Time Fourier Transform
+ */
+
+/** \brief Streaming spectrogram of a signal received in blocks
+ * 
+ * Samples are stored in a ring buffer of one frame and a magnitude frame is emitted
+ * every hop samples (once the first frame is complete), e.g. 512 points frames with
+ * a 128 samples hop (75 % overlap).
+ * 
+ * @author Peñalva Albano
+ *
+ * @section changelog
+ *
+ * |   Date	    | Description                                    						|
+ * |:----------:|:----------------------------------------------------------------------|
+ * | 17/10/2026 | Document creation		                         						|
+ * 
+ **/
+
+/*==================[inclusions]=============================================*/
+#include <stdint.h>
+#include <stdbool.h>
+#include "fft.h"
+/*==================[macros]=================================================*/
+
+/*==================[typedef]================================================*/
+/**
+ * @brief STFT object
+ */
+typedef struct {
+    fft_plan_t plan;            /*!< FFT plan for the frame lenght and window */
+    uint16_t hop;               /*!< Samples between consecutive frames */
+    float * ring;               /*!< Ring buffer with the last frame lenght samples */
+    float * frame;              /*!< Magnitude of the last emitted frame (frame lenght / 2 values) */
+    uint16_t write;             /*!< Ring index where the next sample is stored */
+    uint16_t pending;           /*!< Samples still needed to emit the next frame */
+    uint32_t frames;            /*!< Number of frames emitted since init or reset */
+    void (*func_p)(void *, float *);    /*!< Function called with param_p and the magnitude of each new frame */
+    void * param_p;             /*!< Parameter passed to func_p */
+} stft_t;
+/*==================[external data declaration]==============================*/
+
+/*==================[external functions declaration]=========================*/
+/**
+ * @brief Initialize a STFT object
+ * 
+ * @note  FFTInit() must be called before using the object.
+ * 
+ * @param stft              STFT object
+ * @param frame_lenght      Samples per frame (power of two, from 4 to MAX_SIGNAL_LENGHT)
+ * @param hop               Samples between consecutive frames (1 to frame_lenght)
+ * @param window            Window applied to each frame
+ * @param func_p            Function called for each new frame (can be NULL), its second argument is the
+ *                          frame magnitude (frame_lenght / 2 values, same scale as FFTMagnitude())
+ * @param param_p           Parameter passed to func_p
+ * @return true             Object initialized
+ * @return false            Invalid parameters or not enough memory
+ */
+bool STFTInit(stft_t * stft, uint16_t frame_lenght, uint16_t hop, fft_window_t window, void (*func_p)(void *, float *), void * param_p);
+
+/**
+ * @brief Feed a block of samples to a STFT object
+ * 
+ * Every frame completed by the block is transformed and passed to func_p as soon as its last
+ * sample arrives. The last frame is also available in stft->frame.
+ * 
+ * @param stft              STFT object
+ * @param signal            Array with new signal values
+ * @param signal_lenght     Lenght of signal array (any lenght)
+ * @return                  Number of frames emitted
+ */
+uint16_t STFTProcess(stft_t * stft, float * signal, uint16_t signal_lenght);
+
+/**
+ * @brief Discard the stored samples, the next frame is emitted after a whole frame lenght
+ * 
+ * @param stft              STFT object
+ */
+void STFTReset(stft_t * stft);
+
+/**
+ * @brief Release the memory used by a STFT object
+ * 
+ * @param stft              STFT object
+ */
+void STFTDeinit(stft_t * stft);
+
+/** @} doxygen end group definition */
+/** @} doxygen end group definition */
+/** @} doxygen end group definition */
+#endif /* STFT_H_ */
+
+/*==================[end of file]============================================*/
@@ -0,0 +1,242 @@
+/**
+ * @file attitude.c
+ * @author Albano Peñalva (albano.penalva@uner.edu.ar)
+ * @brief
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2023
+ *
+ */
+
+/*==================[inclusions]=============================================*/
+#include <string.h>
+#include <math.h>
+#include "attitude.h"
+/*==================[macros and definitions]=================================*/
+#define ONE_Q30             (1LL << 30)
+#define PI_2_Q30            1686629713L                 /* pi / 2 (Q30) */
+#define PI_Q29              1686629713L                 /* pi (Q29) */
+#define RAD_TO_CDEG         ((int64_t)(5729.5779513 * 65536))  /* 0.01 ° per radian (Q16) */
+#define ALIGN_MIN           (1L << 20)                  /* Smallest cos(angle / 2) of the alignment quaternion (Q30) */
+/*==================[internal data declaration]==============================*/
+
+/*==================[internal functions declaration]=========================*/
+static uint32_t ISqrt64(uint64_t x);
+static int32_t Atan2(int32_t y, int32_t x);
+static int16_t Centidegrees(int32_t angle);
+static void AttitudeAlign(attitude_t * attitude, const attitude_sample_t * sample);
+/*==================[internal data definition]===============================*/
+/* atan(t) = t * (c0 + c1 t^2 + c2 t^4 + c3 t^6 + c4 t^8) on [0, 1], error below 1e-5 rad (Q30) */
+static const int32_t atan_coeff[5] = {1073597943, -354656388, 193424926, -91410863, 22371518};
+/*==================[external data definition]===============================*/
+
+/*==================[internal functions definition]==========================*/
+/**
+ * @brief Integer square root (floor) of a 64 bit value
+ */
+static uint32_t ISqrt64(uint64_t x){
+    uint64_t res = 0;
+    uint64_t bit = 1ULL << 62;
+    while (bit > x){
+        bit >>= 2;
+    }
+    while (bit != 0){
+        if (x >= res + bit){
+            x -= res + bit;
+            res = (res >> 1) + bit;
+        } else {
+            res >>= 1;
+        }
+        bit >>= 2;
+    }
+    return res;
+}
+
+/**
+ * @brief Four quadrant arctangent
+ *
+ * @param y         Ordinate (any scale, same as x)
+ * @param x         Abscissa
+ * @return          Angle (Q29 rad)
+ */
+static int32_t Atan2(int32_t y, int32_t x){
+    int64_t abs_y = (y < 0) ? -(int64_t)y : y;
+    int64_t abs_x = (x < 0) ? -(int64_t)x : x;
+    if (abs_x == 0 && abs_y == 0){
+        return 0;
+    }
+    bool swap = abs_y > abs_x;
+    int64_t t = swap ? (abs_x << 30) / abs_y : (abs_y << 30) / abs_x;
+    int64_t t2 = (t * t) >> 30;
+    int64_t p = atan_coeff[4];
+    for (int8_t i = 3; i >= 0; i--){
+        p = atan_coeff[i] + ((p * t2) >> 30);
+    }
+    int64_t angle = (p * t) >> 30;
+    if (swap){
+        angle = PI_2_Q30 - angle;
+    }
+    angle >>= 1;
+    if (x < 0){
+        angle = PI_Q29 - angle;
+    }
+    return (y < 0) ? -angle : angle;
+}
+
+/**
+ * @brief Convert an angle from Q29 radians to 0.01 °
+ */
+static int16_t Centidegrees(int32_t angle){
+    return ((int64_t)angle * RAD_TO_CDEG + (1LL << 44)) >> 45;
+}
+
+/**
+ * @brief Set roll and pitch (yaw = 0) from the gravity direction of one sample
+ *
+ * Solves v(q) = a for q = (c, ay / 2c, -ax / 2c, 0), with c = sqrt((1 + az) / 2).
+ */
+static void AttitudeAlign(attitude_t * attitude, const attitude_sample_t * sample){
+    uint32_t norm = ISqrt64((int64_t)sample->ax * sample->ax + (int64_t)sample->ay * sample->ay + (int64_t)sample->az * sample->az);
+    if (norm == 0){
+        return;
+    }
+    int64_t ax = ((int64_t)sample->ax << 30) / norm;
+    int64_t ay = ((int64_t)sample->ay << 30) / norm;
+    int64_t az = ((int64_t)sample->az << 30) / norm;
+    int64_t c = ISqrt64((uint64_t)(ONE_Q30 + az) << 29);
+    if (c < ALIGN_MIN){
+        /* Upside down: half turn around X */
+        attitude->q[0] = 0;
+        attitude->q[1] = ONE_Q30;
+        attitude->q[2] = 0;
+    }
+    else {
+        attitude->q[0] = c;
+        attitude->q[1] = (ay << 29) / c;
+        attitude->q[2] = -(ax << 29) / c;
+    }
+    attitude->q[3] = 0;
+    attitude->aligned = true;
+}
+
+/*==================[external functions definition]==========================*/
+bool AttitudeInit(attitude_t * attitude, uint16_t sample_frec, uint16_t gyro_range, float kp, float ki){
+    if (sample_frec == 0 || kp < 0 || ki < 0){
+        return false;
+    }
+    if (gyro_range != 250 && gyro_range != 500 && gyro_range != 1000 && gyro_range != 2000){
+        return false;
+    }
+    double half_period = 0.5 / sample_frec;
+    double gyro_scale = gyro_range * M_PI / 180 / 32768 * half_period * (1LL << 45);
+    double kp_scaled = kp * half_period * ONE_Q30;
+    double ki_scaled = ki * half_period / sample_frec * (1LL << 46);
+    if (gyro_scale > INT32_MAX || kp_scaled > INT32_MAX || ki_scaled > INT32_MAX){
+        return false;
+    }
+    memset(attitude, 0, sizeof(attitude_t));
+    attitude->gyro_scale = lround(gyro_scale);
+    attitude->kp = lround(kp_scaled);
+    attitude->ki = lround(ki_scaled);
+    AttitudeReset(attitude);
+    return true;
+}
+
+void AttitudeUpdate(attitude_t * attitude, const attitude_sample_t * samples, uint16_t n_samples){
+    int32_t * q = attitude->q;
+    int64_t * integral = attitude->integral;
+    for (uint16_t i = 0; i < n_samples; i++){
+        const attitude_sample_t * s = &samples[i];
+        if (!attitude->aligned){
+            AttitudeAlign(attitude, s);
+        }
+        /* Gyroscope rates to half angle per sample (Q30) */
+        int32_t h[3];
+        h[0] = ((int64_t)s->gx * attitude->gyro_scale) >> 15;
+        h[1] = ((int64_t)s->gy * attitude->gyro_scale) >> 15;
+        h[2] = ((int64_t)s->gz * attitude->gyro_scale) >> 15;
+        uint32_t norm = ISqrt64((int64_t)s->ax * s->ax + (int64_t)s->ay * s->ay + (int64_t)s->az * s->az);
+        if (norm != 0){
+            /* Measured (a) and estimated (v) gravity directions (Q15), error e = a x v (Q30) */
+            int32_t ax = ((int32_t)s->ax << 15) / (int32_t)norm;
+            int32_t ay = ((int32_t)s->ay << 15) / (int32_t)norm;
+            int32_t az = ((int32_t)s->az << 15) / (int32_t)norm;
+            int32_t vx = ((int64_t)q[1] * q[3] - (int64_t)q[0] * q[2]) >> 44;
+            int32_t vy = ((int64_t)q[0] * q[1] + (int64_t)q[2] * q[3]) >> 44;
+            int32_t vz = ((int64_t)q[0] * q[0] - (int64_t)q[1] * q[1] - (int64_t)q[2] * q[2] + (int64_t)q[3] * q[3]) >> 45;
+            int32_t e[3];
+            e[0] = ay * vz - az * vy;
+            e[1] = az * vx - ax * vz;
+            e[2] = ax * vy - ay * vx;
+            for (uint8_t j = 0; j < 3; j++){
+                integral[j] += ((int64_t)attitude->ki * e[j]) >> 30;
+                h[j] += ((int64_t)attitude->kp * e[j]) >> 30;
+            }
+        }
+        h[0] += integral[0] >> 16;
+        h[1] += integral[1] >> 16;
+        h[2] += integral[2] >> 16;
+        /* q += q * (0, h) */
+        int32_t q0 = q[0], q1 = q[1], q2 = q[2], q3 = q[3];
+        q[0] += (-(int64_t)q1 * h[0] - (int64_t)q2 * h[1] - (int64_t)q3 * h[2]) >> 30;
+        q[1] += ((int64_t)q0 * h[0] + (int64_t)q2 * h[2] - (int64_t)q3 * h[1]) >> 30;
+        q[2] += ((int64_t)q0 * h[1] - (int64_t)q1 * h[2] + (int64_t)q3 * h[0]) >> 30;
+        q[3] += ((int64_t)q0 * h[2] + (int64_t)q1 * h[1] - (int64_t)q2 * h[0]) >> 30;
+        /* Renormalization: one Newton step of 1 / sqrt(|q|^2), |q| stays within 1e-8 of 1 */
+        int64_t norm2 = ((int64_t)q[0] * q[0] + (int64_t)q[1] * q[1] + (int64_t)q[2] * q[2] + (int64_t)q[3] * q[3]) >> 30;
+        int64_t factor = (3 * ONE_Q30 - norm2) >> 1;
+        for (uint8_t j = 0; j < 4; j++){
+            q[j] = (q[j] * factor) >> 30;
+        }
+    }
+}
+
+uint16_t AttitudeUnpackFIFO(const uint8_t * fifo, uint16_t fifo_lenght, attitude_sample_t * samples){
+    uint16_t n_samples = fifo_lenght / ATTITUDE_PACKET;
+    for (uint16_t i = 0; i < n_samples; i++){
+        const uint8_t * p = &fifo[i * ATTITUDE_PACKET];
+        samples[i].ax = (int16_t)((p[0] << 8) | p[1]);
+        samples[i].ay = (int16_t)((p[2] << 8) | p[3]);
+        samples[i].az = (int16_t)((p[4] << 8) | p[5]);
+        samples[i].gx = (int16_t)((p[6] << 8) | p[7]);
+        samples[i].gy = (int16_t)((p[8] << 8) | p[9]);
+        samples[i].gz = (int16_t)((p[10] << 8) | p[11]);
+    }
+    return n_samples;
+}
+
+void AttitudeGetEuler(attitude_t * attitude, int16_t euler[3]){
+    int64_t q0 = attitude->q[0], q1 = attitude->q[1], q2 = attitude->q[2], q3 = attitude->q[3];
+    /* Rotation matrix terms (Q30) */
+    int32_t sin_pitch = (q0 * q2 - q3 * q1) >> 29;
+    if (sin_pitch > ONE_Q30){
+        sin_pitch = ONE_Q30;
+    }
+    else if (sin_pitch < -ONE_Q30){
+        sin_pitch = -ONE_Q30;
+    }
+    int32_t cos_pitch = ISqrt64((uint64_t)(ONE_Q30 * ONE_Q30) - (int64_t)sin_pitch * sin_pitch);
+    euler[0] = Centidegrees(Atan2((q0 * q1 + q2 * q3) >> 29, ONE_Q30 - ((q1 * q1 + q2 * q2) >> 29)));
+    euler[1] = Centidegrees(Atan2(sin_pitch, cos_pitch));
+    euler[2] = Centidegrees(Atan2((q0 * q3 + q1 * q2) >> 29, ONE_Q30 - ((q2 * q2 + q3 * q3) >> 29)));
+}
+
+void AttitudeGetGyroBias(attitude_t * attitude, int16_t bias[3]){
+    for (uint8_t i = 0; i < 3; i++){
+        /* The integral is the correction added to the rates: bias = -integral (Q45 / Q45 = raw) */
+        int64_t raw = -(attitude->integral[i] >> 1) / attitude->gyro_scale;
+        bias[i] = (raw > INT16_MAX) ? INT16_MAX : (raw < INT16_MIN) ? INT16_MIN : raw;
+    }
+}
+
+void AttitudeReset(attitude_t * attitude){
+    attitude->q[0] = ONE_Q30;
+    attitude->q[1] = 0;
+    attitude->q[2] = 0;
+    attitude->q[3] = 0;
+    memset(attitude->integral, 0, sizeof(attitude->integral));
+    attitude->aligned = false;
+}
+
+/*==================[end of file]============================================*/
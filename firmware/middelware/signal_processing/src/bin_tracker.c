@@ -0,0 +1,304 @@
+/**
+ * @file bin_tracker.c
+ * @author Albano Peñalva (albano.penalva@uner.edu.ar)
+ * @brief 
+ * @version 0.1
+ * @date 2026-10-17
+ * 
+ * @copyright Copyright (c) 2023
+ * 
+ */
+
+/*==================[inclusions]=============================================*/
+#include <string.h>
+#include <stdlib.h>
+#include <math.h>
+#include "bin_tracker.h"
+/*==================[macros and definitions]=================================*/
+#define N_COEFF         2           /* cos(w), sin(w) */
+#define N_STATE         2           /* Real and imaginary parts */
+#define Q30_ONE         (1L << 30)
+#define Q15_TO_Q31      16          /* Shift from Q15 samples to the Q31 Goertzel state */
+#define Q45_TO_Q31      14          /* Shift from the Q45 (Q15 * Q30) sliding DFT state to Q31 */
+/*==================[internal data declaration]==============================*/
+
+/*==================[internal functions declaration]=========================*/
+static bool BinTrackerCoeff(float sample_frec, float bin_frec, uint16_t window_lenght, double * c, double * s);
+static int64_t MulQ30(int64_t a, int32_t b);
+static uint32_t ISqrt64(uint64_t x);
+static int16_t AmplitudeQ15(int64_t re, int64_t im, uint16_t window_lenght, bool single);
+/*==================[internal data definition]===============================*/
+
+/*==================[external data definition]===============================*/
+
+/*==================[internal functions definition]==========================*/
+/**
+ * @brief cos(w) and sin(w) of the bin of window_lenght points nearest to bin_frec
+ * 
+ * sin(w) is exactly 0 for DC and sample_frec / 2, which are the bins not doubled by the amplitude.
+ */
+static bool BinTrackerCoeff(float sample_frec, float bin_frec, uint16_t window_lenght, double * c, double * s){
+    if ((bin_frec < 0) || (bin_frec > sample_frec / 2)){
+        return false;
+    }
+    long bin = lround(bin_frec * window_lenght / sample_frec);
+    double w = 2 * M_PI * bin / window_lenght;
+    *c = cos(w);
+    *s = ((bin == 0) || (2 * bin == window_lenght)) ? 0 : sin(w);
+    return true;
+}
+
+/**
+ * @brief Multiply a 64 bit value by a Q30 value, using only 32x32 bit products
+ */
+static int64_t MulQ30(int64_t a, int32_t b){
+    int64_t hi = a >> 32;
+    uint32_t lo = (uint32_t)a;
+    return ((hi * b) << 2) + (((int64_t)lo * b + (1L << 29)) >> 30);
+}
+
+/**
+ * @brief Integer square root (floor) of a 64 bit value
+ */
+static uint32_t ISqrt64(uint64_t x){
+    uint64_t res = 0;
+    uint64_t bit = 1ULL << 62;
+    while (bit > x){
+        bit >>= 2;
+    }
+    while (bit != 0){
+        if (x >= res + bit){
+            x -= res + bit;
+            res = (res >> 1) + bit;
+        } else {
+            res >>= 1;
+        }
+        bit >>= 2;
+    }
+    return res;
+}
+
+/**
+ * @brief Amplitude in Q15 of a bin complex value in Q31 (2 * |X| / N, |X| / N for single bins: DC and sample_frec / 2)
+ */
+static int16_t AmplitudeQ15(int64_t re, int64_t im, uint16_t window_lenght, bool single){
+    uint8_t shift = 0;
+    // Scale down until the squared magnitude fits 64 bits
+    while ((re >= (1L << 30)) || (re <= -(1L << 30)) || (im >= (1L << 30)) || (im <= -(1L << 30))){
+        re >>= 1;
+        im >>= 1;
+        shift++;
+    }
+    uint64_t mag = (uint64_t)ISqrt64((uint64_t)(re * re) + (uint64_t)(im * im)) << shift;
+    mag = (mag << (single ? 0 : 1)) / window_lenght;
+    mag = (mag + (1UL << (Q15_TO_Q31 - 1))) >> Q15_TO_Q31;
+    return (mag > INT16_MAX) ? INT16_MAX : mag;
+}
+
+/*==================[external functions definition]==========================*/
+bool BinTrackerInit(bin_tracker_t * tracker, float sample_frec, float * bin_frec, uint8_t n_bins, uint16_t window_lenght){
+    memset(tracker, 0, sizeof(bin_tracker_t));
+    if ((n_bins == 0) || (window_lenght < 2)){
+        return false;
+    }
+    tracker->n_bins = n_bins;
+    tracker->window_lenght = window_lenght;
+    tracker->coeff = (float *)malloc(n_bins * N_COEFF * sizeof(float));
+    tracker->state = (float *)malloc(n_bins * N_STATE * sizeof(float));
+    tracker->phasor = (float *)malloc(n_bins * N_STATE * sizeof(float));
+    tracker->history = (float *)malloc(window_lenght * sizeof(float));
+    if ((tracker->coeff == NULL) || (tracker->state == NULL) || (tracker->phasor == NULL) || (tracker->history == NULL)){
+        BinTrackerDeinit(tracker);
+        return false;
+    }
+    for (uint8_t k = 0; k < n_bins; k++){
+        double c, s;
+        if (!BinTrackerCoeff(sample_frec, bin_frec[k], window_lenght, &c, &s)){
+            BinTrackerDeinit(tracker);
+            return false;
+        }
+        tracker->coeff[k * N_COEFF] = c;
+        tracker->coeff[k * N_COEFF + 1] = s;
+    }
+    BinTrackerReset(tracker);
+    return true;
+}
+
+void BinTrackerGoertzel(bin_tracker_t * tracker, float * signal, float * amplitude){
+    float s1[2], s2[2];
+    // Bins are processed in pairs: two independent recursions per sample hide the FPU latency
+    for (uint8_t k = 0; k < tracker->n_bins; k += 2){
+        uint8_t last = (k + 1 < tracker->n_bins) ? k + 1 : k;
+        float c2a = 2 * tracker->coeff[k * N_COEFF];
+        float c2b = 2 * tracker->coeff[last * N_COEFF];
+        s1[0] = s2[0] = s1[1] = s2[1] = 0;
+        for (uint16_t i = 0; i < tracker->window_lenght; i++){
+            float s0a = signal[i] + c2a * s1[0] - s2[0];
+            float s0b = signal[i] + c2b * s1[1] - s2[1];
+            s2[0] = s1[0];
+            s1[0] = s0a;
+            s2[1] = s1[1];
+            s1[1] = s0b;
+        }
+        for (uint8_t j = 0; j <= last - k; j++){
+            float c = tracker->coeff[(k + j) * N_COEFF];
+            float s = tracker->coeff[(k + j) * N_COEFF + 1];
+            // X = s1 - e^(-jw) * s2 (up to a phase term)
+            float re = s1[j] - c * s2[j];
+            float im = s * s2[j];
+            float norm = ((s == 0) ? 1.0f : 2.0f) / tracker->window_lenght;
+            amplitude[k + j] = norm * sqrtf(re * re + im * im);
+        }
+    }
+}
+
+void BinTrackerSlide(bin_tracker_t * tracker, float * signal, uint16_t signal_lenght){
+    for (uint16_t i = 0; i < signal_lenght; i++){
+        // Modulated sliding DFT: Y(n) = Y(n-1) + (x(n) - x(n-N)) * e^(-jwn), |Y(n)| = |X(n)|.
+        // x(n) and x(n-N) use the same phasor value, so rounding errors do not accumulate.
+        float d = signal[i] - tracker->history[tracker->pos];
+        tracker->history[tracker->pos] = signal[i];
+        for (uint8_t k = 0; k < tracker->n_bins; k++){
+            float c = tracker->coeff[k * N_COEFF];
+            float s = tracker->coeff[k * N_COEFF + 1];
+            float pr = tracker->phasor[k * N_STATE];
+            float pi = tracker->phasor[k * N_STATE + 1];
+            tracker->state[k * N_STATE] += d * pr;
+            tracker->state[k * N_STATE + 1] += d * pi;
+            // e^(-jw(n+1)) = e^(-jwn) * e^(-jw)
+            tracker->phasor[k * N_STATE] = pr * c + pi * s;
+            tracker->phasor[k * N_STATE + 1] = pi * c - pr * s;
+        }
+        if (++tracker->pos == tracker->window_lenght){
+            // e^(-jwN) = 1: restart the phasors from their exact value
+            tracker->pos = 0;
+            for (uint8_t k = 0; k < tracker->n_bins; k++){
+                tracker->phasor[k * N_STATE] = 1;
+                tracker->phasor[k * N_STATE + 1] = 0;
+            }
+        }
+    }
+}
+
+void BinTrackerAmplitude(bin_tracker_t * tracker, float * amplitude){
+    for (uint8_t k = 0; k < tracker->n_bins; k++){
+        float re = tracker->state[k * N_STATE];
+        float im = tracker->state[k * N_STATE + 1];
+        float norm = ((tracker->coeff[k * N_COEFF + 1] == 0) ? 1.0f : 2.0f) / tracker->window_lenght;
+        amplitude[k] = norm * sqrtf(re * re + im * im);
+    }
+}
+
+void BinTrackerReset(bin_tracker_t * tracker){
+    tracker->pos = 0;
+    memset(tracker->state, 0, tracker->n_bins * N_STATE * sizeof(float));
+    for (uint8_t k = 0; k < tracker->n_bins; k++){
+        tracker->phasor[k * N_STATE] = 1;
+        tracker->phasor[k * N_STATE + 1] = 0;
+    }
+    memset(tracker->history, 0, tracker->window_lenght * sizeof(float));
+}
+
+void BinTrackerDeinit(bin_tracker_t * tracker){
+    free(tracker->coeff);
+    free(tracker->state);
+    free(tracker->phasor);
+    free(tracker->history);
+    memset(tracker, 0, sizeof(bin_tracker_t));
+}
+
+bool BinTrackerInitQ15(bin_tracker_q15_t * tracker, float sample_frec, float * bin_frec, uint8_t n_bins, uint16_t window_lenght){
+    memset(tracker, 0, sizeof(bin_tracker_q15_t));
+    if ((n_bins == 0) || (window_lenght < 2)){
+        return false;
+    }
+    tracker->n_bins = n_bins;
+    tracker->window_lenght = window_lenght;
+    tracker->coeff = (int32_t *)malloc(n_bins * N_COEFF * sizeof(int32_t));
+    tracker->state = (int64_t *)malloc(n_bins * N_STATE * sizeof(int64_t));
+    tracker->phasor = (int32_t *)malloc(n_bins * N_STATE * sizeof(int32_t));
+    tracker->history = (int16_t *)malloc(window_lenght * sizeof(int16_t));
+    if ((tracker->coeff == NULL) || (tracker->state == NULL) || (tracker->phasor == NULL) || (tracker->history == NULL)){
+        BinTrackerDeinitQ15(tracker);
+        return false;
+    }
+    for (uint8_t k = 0; k < n_bins; k++){
+        double c, s;
+        if (!BinTrackerCoeff(sample_frec, bin_frec[k], window_lenght, &c, &s)){
+            BinTrackerDeinitQ15(tracker);
+            return false;
+        }
+        tracker->coeff[k * N_COEFF] = lround(c * Q30_ONE);
+        tracker->coeff[k * N_COEFF + 1] = lround(s * Q30_ONE);
+    }
+    BinTrackerResetQ15(tracker);
+    return true;
+}
+
+void BinTrackerGoertzelQ15(bin_tracker_q15_t * tracker, int16_t * signal, int16_t * amplitude){
+    for (uint8_t k = 0; k < tracker->n_bins; k++){
+        int32_t c = tracker->coeff[k * N_COEFF];
+        int32_t s = tracker->coeff[k * N_COEFF + 1];
+        int64_t s1 = 0, s2 = 0;
+        for (uint16_t i = 0; i < tracker->window_lenght; i++){
+            int64_t s0 = ((int64_t)signal[i] << Q15_TO_Q31) + 2 * MulQ30(s1, c) - s2;
+            s2 = s1;
+            s1 = s0;
+        }
+        int64_t re = s1 - MulQ30(s2, c);
+        int64_t im = MulQ30(s2, s);
+        amplitude[k] = AmplitudeQ15(re, im, tracker->window_lenght, s == 0);
+    }
+}
+
+void BinTrackerSlideQ15(bin_tracker_q15_t * tracker, int16_t * signal, uint16_t signal_lenght){
+    for (uint16_t i = 0; i < signal_lenght; i++){
+        // Same recursion as BinTrackerSlide(): integer accumulation, x(n) and x(n-N) cancel exactly
+        int32_t d = (int32_t)signal[i] - tracker->history[tracker->pos];
+        tracker->history[tracker->pos] = signal[i];
+        for (uint8_t k = 0; k < tracker->n_bins; k++){
+            int32_t c = tracker->coeff[k * N_COEFF];
+            int32_t s = tracker->coeff[k * N_COEFF + 1];
+            int32_t pr = tracker->phasor[k * N_STATE];
+            int32_t pi = tracker->phasor[k * N_STATE + 1];
+            tracker->state[k * N_STATE] += (int64_t)d * pr;
+            tracker->state[k * N_STATE + 1] += (int64_t)d * pi;
+            tracker->phasor[k * N_STATE] = ((int64_t)pr * c + (int64_t)pi * s + (1L << 29)) >> 30;
+            tracker->phasor[k * N_STATE + 1] = ((int64_t)pi * c - (int64_t)pr * s + (1L << 29)) >> 30;
+        }
+        if (++tracker->pos == tracker->window_lenght){
+            tracker->pos = 0;
+            for (uint8_t k = 0; k < tracker->n_bins; k++){
+                tracker->phasor[k * N_STATE] = Q30_ONE;
+                tracker->phasor[k * N_STATE + 1] = 0;
+            }
+        }
+    }
+}
+
+void BinTrackerAmplitudeQ15(bin_tracker_q15_t * tracker, int16_t * amplitude){
+    for (uint8_t k = 0; k < tracker->n_bins; k++){
+        amplitude[k] = AmplitudeQ15(tracker->state[k * N_STATE] >> Q45_TO_Q31, tracker->state[k * N_STATE + 1] >> Q45_TO_Q31,
+                                    tracker->window_lenght, tracker->coeff[k * N_COEFF + 1] == 0);
+    }
+}
+
+void BinTrackerResetQ15(bin_tracker_q15_t * tracker){
+    tracker->pos = 0;
+    memset(tracker->state, 0, tracker->n_bins * N_STATE * sizeof(int64_t));
+    for (uint8_t k = 0; k < tracker->n_bins; k++){
+        tracker->phasor[k * N_STATE] = Q30_ONE;
+        tracker->phasor[k * N_STATE + 1] = 0;
+    }
+    memset(tracker->history, 0, tracker->window_lenght * sizeof(int16_t));
+}
+
+void BinTrackerDeinitQ15(bin_tracker_q15_t * tracker){
+    free(tracker->coeff);
+    free(tracker->state);
+    free(tracker->phasor);
+    free(tracker->history);
+    memset(tracker, 0, sizeof(bin_tracker_q15_t));
+}
+
+/*==================[end of file]============================================*/
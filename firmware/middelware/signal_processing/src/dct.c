@@ -0,0 +1,122 @@
+/**
+ * @file dct.c
+ * @author Albano Peñalva (albano.penalva@uner.edu.ar)
+ * @brief
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2023
+ *
+ */
+
+/*==================[inclusions]=============================================*/
+#include <string.h>
+#include <stdlib.h>
+#include <math.h>
+#include "dct.h"
+/*==================[macros and definitions]=================================*/
+
+/*==================[internal data declaration]==============================*/
+
+/*==================[internal functions declaration]=========================*/
+static void DCTForwardStage(float * x, float * tmp, uint16_t n, const float * factor);
+static void DCTInverseStage(float * x, float * tmp, uint16_t n, const float * factor);
+/*==================[internal data definition]===============================*/
+
+/*==================[external data definition]===============================*/
+
+/*==================[internal functions definition]==========================*/
+/**
+ * @brief DCT-II of n values: split into the DCT of the sums and of the weighted differences (n / 2 each)
+ *
+ * x and tmp swap roles at each level, so one buffer of n values is all the extra memory needed.
+ */
+static void DCTForwardStage(float * x, float * tmp, uint16_t n, const float * factor){
+    if (n == 1){
+        return;
+    }
+    uint16_t half = n / 2;
+    for (uint16_t i = 0; i < half; i++){
+        float a = x[i];
+        float b = x[n - 1 - i];
+        tmp[i] = a + b;
+        tmp[half + i] = (a - b) * factor[i];
+    }
+    DCTForwardStage(tmp, x, half, factor + half);
+    DCTForwardStage(tmp + half, x + half, half, factor + half);
+    for (uint16_t i = 0; i < half - 1; i++){
+        x[2 * i] = tmp[i];
+        x[2 * i + 1] = tmp[half + i] + tmp[half + i + 1];
+    }
+    x[n - 2] = tmp[half - 1];
+    x[n - 1] = tmp[n - 1];
+}
+
+/**
+ * @brief DCT-III of n values (X[0] weighted by 1), the forward stage run backwards
+ */
+static void DCTInverseStage(float * x, float * tmp, uint16_t n, const float * factor){
+    if (n == 1){
+        return;
+    }
+    uint16_t half = n / 2;
+    tmp[0] = x[0];
+    tmp[half] = x[1];
+    for (uint16_t i = 1; i < half; i++){
+        tmp[i] = x[2 * i];
+        tmp[half + i] = x[2 * i - 1] + x[2 * i + 1];
+    }
+    DCTInverseStage(tmp, x, half, factor + half);
+    DCTInverseStage(tmp + half, x + half, half, factor + half);
+    for (uint16_t i = 0; i < half; i++){
+        float a = tmp[i];
+        float b = tmp[half + i] * factor[i];
+        x[i] = a + b;
+        x[n - 1 - i] = a - b;
+    }
+}
+
+/*==================[external functions definition]==========================*/
+bool DCTPlanCreate(dct_plan_t * plan, uint16_t lenght){
+    memset(plan, 0, sizeof(dct_plan_t));
+    if ((lenght < 2) || (lenght > DCT_MAX_LENGHT) || ((lenght & (lenght - 1)) != 0)){
+        return false;
+    }
+    plan->lenght = lenght;
+    plan->factor = (float *)malloc((lenght - 1) * sizeof(float));
+    plan->buffer = (float *)malloc(lenght * sizeof(float));
+    if ((plan->factor == NULL) || (plan->buffer == NULL)){
+        DCTPlanDestroy(plan);
+        return false;
+    }
+    float * factor = plan->factor;
+    for (uint16_t n = lenght; n > 1; n /= 2){
+        for (uint16_t i = 0; i < n / 2; i++){
+            factor[i] = 0.5 / cos((i + 0.5) * M_PI / n);
+        }
+        factor += n / 2;
+    }
+    return true;
+}
+
+void DCTForward(dct_plan_t * plan, float * data){
+    DCTForwardStage(data, plan->buffer, plan->lenght, plan->factor);
+}
+
+void DCTInverse(dct_plan_t * plan, float * data){
+    // The stages weight X[0] as the other terms: X[0] / N and X[k] * 2 / N give the exact inverse of DCTForward()
+    float scale = 2.0f / plan->lenght;
+    data[0] *= 0.5f * scale;
+    for (uint16_t i = 1; i < plan->lenght; i++){
+        data[i] *= scale;
+    }
+    DCTInverseStage(data, plan->buffer, plan->lenght, plan->factor);
+}
+
+void DCTPlanDestroy(dct_plan_t * plan){
+    free(plan->factor);
+    free(plan->buffer);
+    memset(plan, 0, sizeof(dct_plan_t));
+}
+
+/*==================[end of file]============================================*/
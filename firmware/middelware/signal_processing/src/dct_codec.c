@@ -0,0 +1,167 @@
+/**
+ * @file dct_codec.c
+ * @author Albano Peñalva (albano.penalva@uner.edu.ar)
+ * @brief
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2023
+ *
+ */
+
+/*==================[inclusions]=============================================*/
+#include <string.h>
+#include <stdlib.h>
+#include <math.h>
+#include "dct_codec.h"
+/*==================[macros and definitions]=================================*/
+#define QUANT_MAX           (1L << 27)  /* Quantized coefficients limit (zigzag code and run within 32 bit) */
+#define VARINT_MAX_BYTES    5
+#define RUN_BITS            3           /* Zero run packed with the coefficient */
+#define RUN_ESCAPE          ((1 << RUN_BITS) - 1)   /* Longer runs follow as a second integer */
+/*==================[internal data declaration]==============================*/
+
+/*==================[internal functions declaration]=========================*/
+static uint16_t PutVarint(uint8_t * data, uint16_t pos, uint16_t data_size, uint32_t value);
+static uint16_t GetVarint(const uint8_t * data, uint16_t pos, uint16_t data_lenght, uint32_t * value);
+/*==================[internal data definition]===============================*/
+
+/*==================[external data definition]===============================*/
+
+/*==================[internal functions definition]==========================*/
+/**
+ * @brief Write a variable lenght integer (7 bits per byte, least significant first)
+ *
+ * @return      Position after the integer, 0 if it doesn't fit
+ */
+static uint16_t PutVarint(uint8_t * data, uint16_t pos, uint16_t data_size, uint32_t value){
+    do {
+        if (pos >= data_size){
+            return 0;
+        }
+        data[pos++] = (value & 0x7F) | ((value > 0x7F) ? 0x80 : 0);
+        value >>= 7;
+    } while (value != 0);
+    return pos;
+}
+
+/**
+ * @brief Read a variable lenght integer
+ *
+ * @return      Position after the integer, 0 if it is incomplete or too long
+ */
+static uint16_t GetVarint(const uint8_t * data, uint16_t pos, uint16_t data_lenght, uint32_t * value){
+    *value = 0;
+    for (uint8_t i = 0; i < VARINT_MAX_BYTES; i++){
+        if (pos >= data_lenght){
+            return 0;
+        }
+        uint8_t byte = data[pos++];
+        *value |= (uint32_t)(byte & 0x7F) << (7 * i);
+        if ((byte & 0x80) == 0){
+            return pos;
+        }
+    }
+    return 0;
+}
+
+/*==================[external functions definition]==========================*/
+bool DCTCodecInit(dct_codec_t * codec, uint16_t block_lenght, float step){
+    memset(codec, 0, sizeof(dct_codec_t));
+    if (!(step > 0) || !DCTPlanCreate(&codec->plan, block_lenght)){
+        return false;
+    }
+    codec->block = (float *)malloc(block_lenght * sizeof(float));
+    if (codec->block == NULL){
+        DCTCodecDeinit(codec);
+        return false;
+    }
+    // Orthonormal DCT: coefficients scaled by sqrt(1 / N) (DC) and sqrt(2 / N)
+    codec->quant[0] = sqrtf(1.0f / block_lenght) / step;
+    codec->quant[1] = sqrtf(2.0f / block_lenght) / step;
+    codec->dequant[0] = 1 / codec->quant[0];
+    codec->dequant[1] = 1 / codec->quant[1];
+    return true;
+}
+
+uint16_t DCTCodecEncode(dct_codec_t * codec, const int16_t * signal, uint8_t * data, uint16_t data_size){
+    uint16_t n = codec->plan.lenght;
+    float * block = codec->block;
+    for (uint16_t i = 0; i < n; i++){
+        block[i] = signal[i];
+    }
+    DCTForward(&codec->plan, block);
+    uint16_t pos = 0;
+    uint16_t run = 0;
+    for (uint16_t k = 0; k < n; k++){
+        float c = block[k] * codec->quant[(k == 0) ? 0 : 1];
+        int32_t q = (c >= QUANT_MAX) ? QUANT_MAX : (c <= -QUANT_MAX) ? -QUANT_MAX : lroundf(c);
+        if (q == 0){
+            run++;
+            continue;
+        }
+        // Zigzag (0, -1, 1, -2, 2... as 0, 1, 2, 3, 4...) and the zero run in one integer:
+        // coefficients up to +-8 after runs shorter than RUN_ESCAPE take one byte
+        uint32_t zigzag = ((uint32_t)q << 1) ^ (uint32_t)(q >> 31);
+        uint32_t token = (zigzag << RUN_BITS) | ((run < RUN_ESCAPE) ? run : RUN_ESCAPE);
+        pos = PutVarint(data, pos, data_size, token);
+        if ((pos != 0) && (run >= RUN_ESCAPE)){
+            pos = PutVarint(data, pos, data_size, run - RUN_ESCAPE);
+        }
+        if (pos == 0){
+            return 0;
+        }
+        run = 0;
+    }
+    // End of block
+    return PutVarint(data, pos, data_size, 0);
+}
+
+uint16_t DCTCodecDecode(dct_codec_t * codec, const uint8_t * data, uint16_t data_lenght, int16_t * signal){
+    uint16_t n = codec->plan.lenght;
+    float * block = codec->block;
+    memset(block, 0, n * sizeof(float));
+    uint16_t pos = 0;
+    uint16_t k = 0;
+    while (1){
+        uint32_t token, run;
+        pos = GetVarint(data, pos, data_lenght, &token);
+        if (pos == 0){
+            return 0;
+        }
+        if (token == 0){
+            break;
+        }
+        uint32_t zigzag = token >> RUN_BITS;
+        run = token & RUN_ESCAPE;
+        if (run == RUN_ESCAPE){
+            uint32_t extra;
+            pos = GetVarint(data, pos, data_lenght, &extra);
+            if ((pos == 0) || (extra >= n)){
+                return 0;
+            }
+            run += extra;
+        }
+        if ((zigzag == 0) || (run >= (uint32_t)(n - k))){
+            return 0;
+        }
+        k += run;
+        int32_t q = (int32_t)(zigzag >> 1) ^ -(int32_t)(zigzag & 1);
+        block[k] = q * codec->dequant[(k == 0) ? 0 : 1];
+        k++;
+    }
+    DCTInverse(&codec->plan, block);
+    for (uint16_t i = 0; i < n; i++){
+        long x = lroundf(block[i]);
+        signal[i] = (x > INT16_MAX) ? INT16_MAX : (x < INT16_MIN) ? INT16_MIN : x;
+    }
+    return pos;
+}
+
+void DCTCodecDeinit(dct_codec_t * codec){
+    DCTPlanDestroy(&codec->plan);
+    free(codec->block);
+    codec->block = NULL;
+}
+
+/*==================[end of file]============================================*/
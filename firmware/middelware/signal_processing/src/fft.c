@@ -11,26 +11,311 @@
 
 /*==================[inclusions]=============================================*/
 #include <string.h>
+#include <stdlib.h>
 #include <math.h>
 #include "fft.h"
+#include "fft_tables.h"
 #include "esp_dsp.h"
 #include "esp_log.h"
 /*==================[macros and definitions]=================================*/
 #define TAG "FFT Module"
+#define DB_PER_LOG2         3.0102999566f   /* 10 * log10(2): power in dB from its base 2 logarithm */
 /*==================[internal data declaration]==============================*/
-static float fft_complex[2 * MAX_SIGNAL_LENGHT];
-static float wind[MAX_SIGNAL_LENGHT];
+static fft_plan_t magnitude_plan;   /* Plan used by FFTMagnitude(), rebuilt only when lenght changes */
+static int16_t fft_q15[MAX_SIGNAL_LENGHT];
+static int16_t wind_q15[MAX_SIGNAL_LENGHT];
+static uint16_t wind_q15_lenght = 0;
 /*==================[internal functions declaration]=========================*/
-
+static int8_t FFTTransformQ15(uint16_t * signal, uint16_t signal_lenght);
+static uint8_t FFTStagesQ15(int16_t * data, uint16_t n, uint16_t max);
+static inline int32_t FFTSplitPairQ15(int16_t * data, uint16_t n, uint16_t k, int32_t * out);
+static uint8_t FFTSplitQ15(int16_t * data, uint16_t n);
+static uint32_t ISqrt(uint32_t x);
+static void FFTPlanSpectrum(fft_plan_t * plan, float * fft);
+static inline float FastSqrt(float x);
+static inline float FastLog2(float x);
+static inline float FFTOutput(fft_output_t output, float re, float im, float norm);
 /*==================[internal data definition]===============================*/
 
 /*==================[external data definition]===============================*/
 
 /*==================[internal functions definition]==========================*/
+/**
+ * @brief Radix-2 complex FFT in Q15 with block floating point scaling
+ * 
+ * Same butterflies as dsps_fft2r_sc16_ansi(), but instead of a fixed 1/2 scale per stage each
+ * stage is scaled (by 1/2 or 1/4) only when its largest possible output would not fit, so blocks
+ * that do not grow keep their resolution. The output is the transform scaled by 2^-S.
+ * 
+ * @param data      n complex values (re, im), natural order input, bit reversed output
+ * @param n         Number of complex values (power of two)
+ * @param max       Largest absolute component of the input
+ * @return S        Accumulated scale (number of right shifts applied)
+ */
+static uint8_t FFTStagesQ15(int16_t * data, uint16_t n, uint16_t max){
+    const int16_t * w = dsps_fft_w_table_sc16;
+    uint8_t scale = 0;
+    uint16_t ie = 1;
+    for (uint16_t n2 = n / 2; n2 > 0; n2 >>= 1){
+        // Butterfly outputs are below |a| + sqrt(2) * |b| < 2.5 * max
+        uint8_t s = 0;
+        while ((5 * (int32_t)max) >> 1 > (INT16_MAX << s)){
+            s++;
+        }
+        int32_t round = (s > 0) ? (1 << (s - 1)) : 0;
+        int32_t new_max = 0;
+        int32_t new_min = 0;
+        uint16_t ia = 0;
+        for (uint16_t j = 0; j < ie; j++){
+            // First twiddle is 1: Q15 0x7fff would leak the (large) DC into every other bin
+            int32_t c = (j == 0) ? 0x8000 : w[2 * j];
+            int32_t sn = (j == 0) ? 0 : w[2 * j + 1];
+            for (uint16_t i = 0; i < n2; i++){
+                uint16_t m = ia + n2;
+                int32_t t_re = (c * data[2 * m] + sn * data[2 * m + 1] + 0x4000) >> 15;
+                int32_t t_im = (c * data[2 * m + 1] - sn * data[2 * m] + 0x4000) >> 15;
+                int32_t a_re = data[2 * ia];
+                int32_t a_im = data[2 * ia + 1];
+                int32_t out[4] = {(a_re - t_re + round) >> s, (a_im - t_im + round) >> s,
+                                  (a_re + t_re + round) >> s, (a_im + t_im + round) >> s};
+                data[2 * m] = out[0];
+                data[2 * m + 1] = out[1];
+                data[2 * ia] = out[2];
+                data[2 * ia + 1] = out[3];
+                for (uint8_t k = 0; k < 4; k++){
+                    new_max = (out[k] > new_max) ? out[k] : new_max;
+                    new_min = (out[k] < new_min) ? out[k] : new_min;
+                }
+                ia++;
+            }
+            ia += n2;
+        }
+        ie <<= 1;
+        scale += s;
+        max = (new_max > -new_min) ? new_max : -new_min;
+    }
+    return scale;
+}
+
+/**
+ * @brief Real spectrum bins k and n - k (twice their value) from a n points complex FFT output
+ * 
+ * Same split as dsps_cplx2real_sc16_ansi(), computed in 32 bits.
+ * 
+ * @return Largest absolute component of the four outputs (k re, im, n - k re, im)
+ */
+static inline int32_t FFTSplitPairQ15(int16_t * data, uint16_t n, uint16_t k, int32_t * out){
+    const int16_t * w = dsps_fft_w_table_sc16;
+    // Twiddle table is in bit reversed order
+    uint16_t index = 0;
+    for (uint16_t bit = 1, rev = n >> 1; bit < n; bit <<= 1, rev >>= 1){
+        if (k & bit){
+            index |= rev;
+        }
+    }
+    int32_t w_re = w[2 * index];
+    int32_t w_im = w[2 * index + 1];
+    int32_t f1_re = data[2 * k] + data[2 * (n - k)];
+    int32_t f1_im = data[2 * k + 1] - data[2 * (n - k) + 1];
+    int32_t f2_re = data[2 * k] - data[2 * (n - k)];
+    int32_t f2_im = data[2 * k + 1] + data[2 * (n - k) + 1];
+    int32_t tw_re = (w_re * f2_im - w_im * f2_re + 0x4000) >> 15;
+    int32_t tw_im = (w_re * f2_re + w_im * f2_im + 0x4000) >> 15;
+    out[0] = f1_re + tw_re;
+    out[1] = f1_im - tw_im;
+    out[2] = f1_re - tw_re;
+    out[3] = -(f1_im + tw_im);
+    int32_t max = 0;
+    for (uint8_t i = 0; i < 4; i++){
+        int32_t abs_out = (out[i] < 0) ? -out[i] : out[i];
+        if (abs_out > max){
+            max = abs_out;
+        }
+    }
+    return max;
+}
+
+/**
+ * @brief Split a n points complex FFT output into the real signal spectrum, block floating point
+ * 
+ * Unlike dsps_cplx2real_sc16_ansi(), which always scales the output by 1/4 (its sums are 16 bits),
+ * the output is computed in 32 bits in a first pass and then scaled only by what it needs to fit
+ * in Q15. Output is the spectrum X[k] scaled by 2^(1 - S), DC in data[0] and
+ * Nyquist in data[1].
+ * 
+ * @param data      n complex values, FFT output in natural order
+ * @param n         Number of complex values (power of two)
+ * @return S        Scale applied (number of right shifts)
+ */
+static uint8_t FFTSplitQ15(int16_t * data, uint16_t n){
+    int32_t out[4];
+    int32_t max = 2 * (abs(data[0]) + abs(data[1]));
+    for (uint16_t k = 1; k <= n / 2; k++){
+        int32_t pair_max = FFTSplitPairQ15(data, n, k, out);
+        if (pair_max > max){
+            max = pair_max;
+        }
+    }
+    uint8_t s = 0;
+    while (max > (INT16_MAX << s)){
+        s++;
+    }
+    int32_t round = (s > 0) ? (1 << (s - 1)) : 0;
+    int32_t dc = data[0];
+    data[0] = (2 * (dc + data[1]) + round) >> s;
+    data[1] = (2 * (dc - data[1]) + round) >> s;
+    for (uint16_t k = 1; k <= n / 2; k++){
+        FFTSplitPairQ15(data, n, k, out);
+        data[2 * k] = (out[0] + round) >> s;
+        data[2 * k + 1] = (out[1] + round) >> s;
+        data[2 * (n - k)] = (out[2] + round) >> s;
+        data[2 * (n - k) + 1] = (out[3] + round) >> s;
+    }
+    return s;
+}
+
+/**
+ * @brief Windowed real FFT of a raw ADC block in Q15
+ * 
+ * The result is left in fft_q15 (signal_lenght / 2 complex bins, DC in fft_q15[0]).
+ * 
+ * @return Exponent e so that Q15 magnitude (same scale as FFTMagnitude()) = |fft_q15[k]| * 2^e for k > 0.
+ */
+static int8_t FFTTransformQ15(uint16_t * signal, uint16_t signal_lenght){
+    uint16_t half = signal_lenght / 2;
+    uint16_t max = 0;
+    int8_t shift = 0;
+    // Hann window in Q15, regenerated only when lenght changes
+    if (wind_q15_lenght != signal_lenght){
+        for (uint16_t i = 0; i < signal_lenght; i++){
+            wind_q15[i] = (int16_t)(INT16_MAX * 0.5f * (1 - cosf(i * 2 * M_PI / (signal_lenght - 1))));
+        }
+        wind_q15_lenght = signal_lenght;
+    }
+    // Block scaling: normalize input to use the full Q15 range
+    for (uint16_t i = 0; i < signal_lenght; i++){
+        if (signal[i] > max){
+            max = signal[i];
+        }
+    }
+    while ((shift < 15) && (((uint32_t)max << (shift + 1)) <= INT16_MAX)){
+        shift++;
+    }
+    // Window, even samples as real part and odd samples as imaginary part
+    max = 0;
+    for (uint16_t i = 0; i < signal_lenght; i++){
+        fft_q15[i] = ((int32_t)(signal[i] << shift) * wind_q15[i]) >> 15;
+        if (fft_q15[i] > max){
+            max = fft_q15[i];
+        }
+    }
+    // Half lenght complex FFT and split into the real spectrum, both scaled only when needed
+    uint8_t scale = FFTStagesQ15(fft_q15, half, max);
+    dsps_bit_rev_sc16_ansi(fft_q15, half);
+    scale += FFTSplitQ15(fft_q15, half);
+    // Transform output is X[k] * 2^(shift + 1 - scale) (X in counts), while FFTMagnitude() scale
+    // in Q15 is 8 * 2^ADC_Q15_SHIFT * |X[k]| / signal_lenght
+    return 2 + ADC_Q15_SHIFT - shift + scale - dsp_power_of_two(signal_lenght);
+}
+
+/**
+ * @brief Integer square root (floor)
+ */
+static uint32_t ISqrt(uint32_t x){
+    uint32_t res = 0;
+    uint32_t bit = 1UL << 30;
+    while (bit > x){
+        bit >>= 2;
+    }
+    while (bit != 0){
+        if (x >= res + bit){
+            x -= res + bit;
+            res = (res >> 1) + bit;
+        } else {
+            res >>= 1;
+        }
+        bit >>= 2;
+    }
+    return res;
+}
+
+/**
+ * @brief Square root from the inverse square root bit estimate and one Newton step (relative error below 0.18 %)
+ * 
+ * Only multiplications: no division nor software square root routine on targets without FPU.
+ */
+static inline float FastSqrt(float x){
+    if (!(x > 0)){
+        return 0;
+    }
+    union { float f; uint32_t u; } v = { .f = x };
+    v.u = 0x5F3759DF - (v.u >> 1);
+    float y = v.f;
+    y = y * (1.5f - 0.5f * x * y * y);
+    return x * y;
+}
+
+/**
+ * @brief Base 2 logarithm: exponent bits plus a minimax polynomial of the mantissa (error below 9e-5)
+ */
+static inline float FastLog2(float x){
+    union { float f; uint32_t u; } v = { .f = x };
+    float e = (float)((int32_t)(v.u >> 23) - 127);
+    v.u = (v.u & 0x007FFFFF) | 0x3F800000;
+    float m = v.f - 1;
+    return e + (8.75919222e-05f + (1.43770439f + (-0.674942892f + (0.31867913f - 0.0816158087f * m) * m) * m) * m);
+}
+
+/**
+ * @brief One output bin from its (scaled) spectrum, normalization included
+ */
+static inline float FFTOutput(fft_output_t output, float re, float im, float norm){
+    float power = re * re + im * im;
+    switch (output){
+        case FFT_OUTPUT_MAGNITUDE_FAST:
+            return norm * FastSqrt(power);
+        case FFT_OUTPUT_POWER:
+            return norm * norm * power;
+        case FFT_OUTPUT_DB:
+            return DB_PER_LOG2 * FastLog2(norm * norm * power);
+        default:
+            return norm * sqrtf(power);
+    }
+}
+
+/**
+ * @brief Transform the windowed signal already in plan->buffer and calculate its magnitude (or the plan output)
+ */
+static void FFTPlanSpectrum(fft_plan_t * plan, float * fft){
+    uint16_t half = plan->signal_lenght / 2;
+    fft_output_t output = plan->output;
+    float * z = plan->buffer;
+    // Calculate half lenght complex FFT
+    dsps_fft2r_fc32(z, half);
+    // Bit reverse
+    dsps_bit_rev_lookup_fc32(z, plan->bit_rev_size, (uint16_t *)plan->bit_rev);
+    // Split into the real signal spectrum and calculate magnitude.
+    // Scale matches the former full lenght transform: 4*|X[k]|/half, |X[0]|/half for DC.
+    float norm = 2.0f / half;
+    fft[0] = FFTOutput(output, z[0] + z[1], 0, 1.0f / half);
+    for (uint16_t k = 1; k <= half / 2; k++){
+        float ar = z[2 * k], ai = z[2 * k + 1];
+        float br = z[2 * (half - k)], bi = z[2 * (half - k) + 1];
+        // Even and odd samples spectra (scaled by 2)
+        float er = ar + br, ei = ai - bi;
+        float odr = ai + bi, odi = br - ar;
+        float c = plan->twiddle[2 * k], s = plan->twiddle[2 * k + 1];
+        float tr = c * odr + s * odi;
+        float ti = c * odi - s * odr;
+        fft[k] = FFTOutput(output, er + tr, ei + ti, norm);
+        fft[half - k] = FFTOutput(output, er - tr, ei - ti, norm);
+    }
+}
 
 /*==================[external functions definition]==========================*/
 bool FFTInit(void){
-    esp_err_t ret = dsps_fft2r_init_fc32(NULL, CONFIG_DSP_MAX_FFT_SIZE);
+    // Constant twiddles in flash: nothing to compute or allocate
+    esp_err_t ret = dsps_fft2r_init_fc32_const(FFTTableTwiddle(), FFT_W_TABLE_SIZE);
     if (ret != ESP_OK){
         return false;
     }
@@ -38,25 +323,63 @@ bool FFTInit(void){
 }
 
 void FFTMagnitude(float * signal, float * fft, uint16_t signal_lenght){
-    // Generate Hann window
-    dsps_wind_hann_f32(wind, signal_lenght);
-    // Clear fft array
-    memset(fft_complex, 0, 2 * MAX_SIGNAL_LENGHT * sizeof(float));
-    // Multiply input array with window and store as real part
-    dsps_mul_f32(signal, wind, fft_complex, signal_lenght, 1, 1, 2);    
-    // Calculate FFT  
-    dsps_fft2r_fc32(fft_complex, signal_lenght);
-    // Bit reverse
-    dsps_bit_rev_fc32(fft_complex, signal_lenght);
-    // Convert one complex vector to two complex vectors
-    dsps_cplx2reC_fc32(fft_complex, signal_lenght);
-    // Calculate FFT magnitude 
-    for (int j = 0; j < signal_lenght; j++){
-            fft_complex[j] = 2*(sqrt(fft_complex[j*2+0]*fft_complex[j*2+0] + fft_complex[j*2+1]*fft_complex[j*2+1])) / (signal_lenght/2);
+    if (magnitude_plan.signal_lenght != signal_lenght){
+        FFTPlanDestroy(&magnitude_plan);
+        if (!FFTPlanCreate(&magnitude_plan, signal_lenght, FFT_WINDOW_HANN)){
+            ESP_LOGE(TAG, "Not possible to create plan for %d points", signal_lenght);
+            return;
+        }
+    }
+    FFTPlanMagnitude(&magnitude_plan, signal, fft);
+}
+
+bool FFTInitQ15(void){
+    esp_err_t ret = dsps_fft2r_init_sc16_const(FFTTableTwiddleQ15(), FFT_W_TABLE_SIZE);
+    if (ret != ESP_OK){
+        return false;
+    }
+    return true;
+}
+
+void FFTMagnitudeQ15(uint16_t * signal, int16_t * fft, uint16_t signal_lenght){
+    uint16_t half = signal_lenght / 2;
+    int8_t exp = FFTTransformQ15(signal, signal_lenght);
+    for (uint16_t k = 0; k < half; k++){
+        int32_t re = fft_q15[2 * k];
+        int32_t im = (k == 0) ? 0 : fft_q15[2 * k + 1];
+        uint32_t mag = ISqrt((uint32_t)(re * re) + (uint32_t)(im * im));
+        if (k == 0){
+            // DC bin is not doubled (FFTMagnitude() scale)
+            exp -= 2;
+        }
+        if (exp >= 0){
+            mag <<= exp;
+        } else {
+            mag = (mag + (1UL << (-exp - 1))) >> -exp;
+        }
+        if (k == 0){
+            exp += 2;
+        }
+        fft[k] = (mag > INT16_MAX) ? INT16_MAX : mag;
+    }
+}
+
+void FFTPowerQ15(uint16_t * signal, uint32_t * power, uint16_t signal_lenght){
+    uint16_t half = signal_lenght / 2;
+    int8_t exp = FFTTransformQ15(signal, signal_lenght);
+    for (uint16_t k = 0; k < half; k++){
+        int32_t re = fft_q15[2 * k];
+        int32_t im = (k == 0) ? 0 : fft_q15[2 * k + 1];
+        // Power exponent is twice the magnitude one, DC bin is not doubled
+        int8_t pexp = 2 * exp - ((k == 0) ? 4 : 0);
+        uint64_t pow = (uint64_t)(re * re) + (uint64_t)(im * im);
+        if (pexp >= 0){
+            pow <<= pexp;
+        } else {
+            pow = (pow + (1ULL << (-pexp - 1))) >> -pexp;
+        }
+        power[k] = (pow > UINT32_MAX) ? UINT32_MAX : pow;
     }
-    fft_complex[0] = fft_complex[0] / 2;
-    // Copy result in fft array
-    memcpy(fft, fft_complex, (signal_lenght / 2) * sizeof(float));
 }
 
 void FFTFrequency(float sample_freq, uint16_t signal_lenght, float * f){
@@ -66,4 +389,130 @@ void FFTFrequency(float sample_freq, uint16_t signal_lenght, float * f){
     }
 }
 
+bool FFTPlanCreate(fft_plan_t * plan, uint16_t signal_lenght, fft_window_t window){
+    memset(plan, 0, sizeof(fft_plan_t));
+    if ((signal_lenght < 4) || (signal_lenght > MAX_SIGNAL_LENGHT) || !dsp_is_power_of_two(signal_lenght)){
+        return false;
+    }
+    uint16_t half = signal_lenght / 2;
+    plan->signal_lenght = signal_lenght;
+    plan->window = window;
+    // Split twiddles and bit reverse pairs are constant tables
+    plan->twiddle = FFTTableSplit(signal_lenght);
+    plan->bit_rev = FFTTableBitRev(half, &plan->bit_rev_size);
+    plan->wind = (float *)malloc(signal_lenght * sizeof(float));
+    plan->buffer = (float *)malloc(signal_lenght * sizeof(float));
+    if ((plan->wind == NULL) || (plan->buffer == NULL)){
+        FFTPlanDestroy(plan);
+        return false;
+    }
+    // Window table
+    switch(window){
+        case FFT_WINDOW_NONE:
+            for (uint16_t i = 0; i < signal_lenght; i++){
+                plan->wind[i] = 1;
+            }
+        break;
+        case FFT_WINDOW_HANN:
+            dsps_wind_hann_f32(plan->wind, signal_lenght);
+        break;
+        case FFT_WINDOW_BLACKMAN:
+            dsps_wind_blackman_f32(plan->wind, signal_lenght);
+        break;
+        case FFT_WINDOW_BLACKMAN_HARRIS:
+            dsps_wind_blackman_harris_f32(plan->wind, signal_lenght);
+        break;
+        case FFT_WINDOW_NUTTALL:
+            dsps_wind_nuttall_f32(plan->wind, signal_lenght);
+        break;
+        case FFT_WINDOW_FLAT_TOP:
+            dsps_wind_flat_top_f32(plan->wind, signal_lenght);
+        break;
+    }
+    return true;
+}
+
+void FFTPlanSetOutput(fft_plan_t * plan, fft_output_t output){
+    plan->output = output;
+}
+
+void FFTPlanMagnitude(fft_plan_t * plan, float * signal, float * fft){
+    // Multiply input array with window, even samples as real part and odd samples as imaginary part
+    dsps_mul_f32(signal, plan->wind, plan->buffer, plan->signal_lenght, 1, 1, 1);
+    FFTPlanSpectrum(plan, fft);
+}
+
+void FFTPlanMagnitudeRing(fft_plan_t * plan, float * ring, uint16_t start, float * fft){
+    // Oldest samples (from start to the end of the ring) first, then the wrapped around ones;
+    // the window product is the only copy of the frame
+    uint16_t first = plan->signal_lenght - start;
+    dsps_mul_f32(&ring[start], plan->wind, plan->buffer, first, 1, 1, 1);
+    if (start > 0){
+        dsps_mul_f32(ring, &plan->wind[first], &plan->buffer[first], start, 1, 1, 1);
+    }
+    FFTPlanSpectrum(plan, fft);
+}
+
+void FFTPlanForward(fft_plan_t * plan){
+    uint16_t half = plan->signal_lenght / 2;
+    float * z = plan->buffer;
+    // Even samples as real part and odd samples as imaginary part
+    dsps_fft2r_fc32(z, half);
+    dsps_bit_rev_lookup_fc32(z, plan->bit_rev_size, (uint16_t *)plan->bit_rev);
+    float z0 = z[0];
+    z[0] = z0 + z[1];
+    z[1] = z0 - z[1];
+    for (uint16_t k = 1; k <= half / 2; k++){
+        float ar = z[2 * k], ai = z[2 * k + 1];
+        float br = z[2 * (half - k)], bi = z[2 * (half - k) + 1];
+        // Even (E) and odd (O) samples spectra, X[k] = E + W^k * O and X[half - k] = conj(E - W^k * O)
+        float er = 0.5f * (ar + br), ei = 0.5f * (ai - bi);
+        float odr = 0.5f * (ai + bi), odi = 0.5f * (br - ar);
+        float c = plan->twiddle[2 * k], s = plan->twiddle[2 * k + 1];
+        float tr = c * odr + s * odi;
+        float ti = c * odi - s * odr;
+        z[2 * k] = er + tr;
+        z[2 * k + 1] = ei + ti;
+        z[2 * (half - k)] = er - tr;
+        z[2 * (half - k) + 1] = ti - ei;
+    }
+}
+
+void FFTPlanInverse(fft_plan_t * plan){
+    uint16_t half = plan->signal_lenght / 2;
+    float * z = plan->buffer;
+    // Rebuild the n / 2 points spectrum of (even + j * odd samples), conjugated so that
+    // the forward transform computes the inverse one
+    float y0 = z[0];
+    z[0] = 0.5f * (y0 + z[1]);
+    z[1] = -0.5f * (y0 - z[1]);
+    for (uint16_t k = 1; k <= half / 2; k++){
+        float ar = z[2 * k], ai = z[2 * k + 1];
+        float br = z[2 * (half - k)], bi = z[2 * (half - k) + 1];
+        // E = (Y[k] + conj(Y[half - k])) / 2, O = (Y[k] - conj(Y[half - k])) * conj(W^k) / 2
+        float er = 0.5f * (ar + br), ei = 0.5f * (ai - bi);
+        float dr = 0.5f * (ar - br), di = 0.5f * (ai + bi);
+        float c = plan->twiddle[2 * k], s = plan->twiddle[2 * k + 1];
+        float odr = c * dr - s * di;
+        float odi = c * di + s * dr;
+        // Z[k] = E + j * O, Z[half - k] = conj(E) + j * conj(O), both conjugated
+        z[2 * k] = er - odi;
+        z[2 * k + 1] = -(ei + odr);
+        z[2 * (half - k)] = er + odi;
+        z[2 * (half - k) + 1] = ei - odr;
+    }
+    dsps_fft2r_fc32(z, half);
+    dsps_bit_rev_lookup_fc32(z, plan->bit_rev_size, (uint16_t *)plan->bit_rev);
+    // Conjugate back: odd samples are the imaginary parts
+    for (uint16_t k = 0; k < half; k++){
+        z[2 * k + 1] = -z[2 * k + 1];
+    }
+}
+
+void FFTPlanDestroy(fft_plan_t * plan){
+    free(plan->wind);
+    free(plan->buffer);
+    memset(plan, 0, sizeof(fft_plan_t));
+}
+
 /*==================[end of file]============================================*/
\ No newline at end of file
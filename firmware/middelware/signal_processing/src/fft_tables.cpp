@@ -0,0 +1,242 @@
+/**
+ * @file fft_tables.cpp
+ * @author Albano Peñalva (albano.penalva@uner.edu.ar)
+ * @brief
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2023
+ *
+ */
+
+/*==================[inclusions]=============================================*/
+#include <stddef.h>
+#include <array>
+#include "fft_tables.h"
+/*==================[macros and definitions]=================================*/
+#define MIN_SPLIT_LENGHT    4
+#define MAX_BITREV_POINTS   (MAX_SIGNAL_LENGHT / 2)
+
+static_assert((MAX_SIGNAL_LENGHT & (MAX_SIGNAL_LENGHT - 1)) == 0, "MAX_SIGNAL_LENGHT must be a power of two");
+static_assert(MAX_SIGNAL_LENGHT >= 8, "MAX_SIGNAL_LENGHT too small for the FFT tables");
+/*==================[internal data declaration]==============================*/
+
+/*==================[internal functions declaration]=========================*/
+
+/*==================[internal functions definition]==========================*/
+namespace {
+
+constexpr double PI = 3.14159265358979323846;
+
+/**
+ * @brief sin(x) for |x| <= pi / 4 (Taylor series, error below 1e-17)
+ */
+constexpr double SinSeries(double x){
+    double term = x, sum = x;
+    for (int i = 1; i < 12; i++){
+        term *= -x * x / ((2 * i) * (2 * i + 1));
+        sum += term;
+    }
+    return sum;
+}
+
+/**
+ * @brief cos(x) for |x| <= pi / 4 (Taylor series, error below 1e-17)
+ */
+constexpr double CosSeries(double x){
+    double term = 1, sum = 1;
+    for (int i = 1; i < 12; i++){
+        term *= -x * x / ((2 * i - 1) * (2 * i));
+        sum += term;
+    }
+    return sum;
+}
+
+/**
+ * @brief cos(2*pi*k/n) for 0 <= k <= n / 2, reduced to the first octant with integer arithmetic
+ */
+constexpr double CosTurn(int32_t k, int32_t n){
+    if (8 * k <= n){
+        return CosSeries(2 * PI * k / n);
+    }
+    if (8 * k <= 3 * n){
+        return SinSeries(2 * PI * (n - 4 * k) / (4.0 * n));
+    }
+    return -CosSeries(2 * PI * (n - 2 * k) / (2.0 * n));
+}
+
+/**
+ * @brief sin(2*pi*k/n) for 0 <= k <= n / 2, reduced to the first octant with integer arithmetic
+ */
+constexpr double SinTurn(int32_t k, int32_t n){
+    if (8 * k <= n){
+        return SinSeries(2 * PI * k / n);
+    }
+    if (8 * k <= 3 * n){
+        return CosSeries(2 * PI * (n - 4 * k) / (4.0 * n));
+    }
+    return SinSeries(2 * PI * (n - 2 * k) / (2.0 * n));
+}
+
+/**
+ * @brief Reverse the lowest bits of i
+ */
+constexpr uint32_t BitReverse(uint32_t i, uint32_t bits){
+    uint32_t r = 0;
+    for (uint32_t b = 0; b < bits; b++){
+        r = (r << 1) | ((i >> b) & 1);
+    }
+    return r;
+}
+
+constexpr uint32_t Log2(uint32_t n){
+    uint32_t bits = 0;
+    while ((1UL << bits) < n){
+        bits++;
+    }
+    return bits;
+}
+
+/**
+ * @brief Radix 2 twiddles as dsps_fft2r_init_fc32() / dsps_fft2r_init_sc16() leave them:
+ * W^i = cos, sin(2*pi*i/FFT_W_TABLE_SIZE) for i < FFT_W_TABLE_SIZE / 2, in bit reversed order
+ */
+template <typename T>
+constexpr std::array<T, FFT_W_TABLE_SIZE> RadixTwiddles(double scale){
+    std::array<T, FFT_W_TABLE_SIZE> w{};
+    constexpr uint32_t points = FFT_W_TABLE_SIZE / 2;
+    for (uint32_t i = 0; i < points; i++){
+        uint32_t r = BitReverse(i, Log2(points));
+        /* Conversion truncates, as the esp-dsp generator does for sc16 */
+        w[2 * r] = static_cast<T>(scale * CosTurn(i, FFT_W_TABLE_SIZE));
+        w[2 * r + 1] = static_cast<T>(scale * SinTurn(i, FFT_W_TABLE_SIZE));
+    }
+    return w;
+}
+
+/**
+ * @brief Split twiddle pairs of one real signal lenght n (n / 4 + 1 pairs)
+ */
+constexpr uint32_t SplitOffset(uint32_t n){
+    uint32_t offset = 0;
+    for (uint32_t m = MIN_SPLIT_LENGHT; m < n; m <<= 1){
+        offset += 2 * (m / 4 + 1);
+    }
+    return offset;
+}
+
+constexpr std::array<float, SplitOffset(2 * MAX_SIGNAL_LENGHT)> SplitTwiddles(void){
+    std::array<float, SplitOffset(2 * MAX_SIGNAL_LENGHT)> w{};
+    for (uint32_t n = MIN_SPLIT_LENGHT; n <= MAX_SIGNAL_LENGHT; n <<= 1){
+        uint32_t offset = SplitOffset(n);
+        for (uint32_t k = 0; k <= n / 4; k++){
+            w[offset + 2 * k] = static_cast<float>(CosTurn(k, n));
+            w[offset + 2 * k + 1] = static_cast<float>(SinTurn(k, n));
+        }
+    }
+    return w;
+}
+
+/**
+ * @brief Bit reverse swap pairs of a n points transform
+ */
+constexpr uint32_t BitRevPairs(uint32_t n){
+    uint32_t pairs = 0;
+    for (uint32_t i = 0; i < n; i++){
+        if (i < BitReverse(i, Log2(n))){
+            pairs++;
+        }
+    }
+    return pairs;
+}
+
+constexpr uint32_t BitRevOffset(uint32_t n){
+    uint32_t offset = 0;
+    for (uint32_t m = 2; m < n; m <<= 1){
+        offset += 2 * BitRevPairs(m);
+    }
+    return offset;
+}
+
+/**
+ * @brief Swap pairs of every transform lenght, as byte offsets of complex float elements
+ */
+constexpr std::array<uint16_t, BitRevOffset(2 * MAX_BITREV_POINTS)> BitRevTables(void){
+    std::array<uint16_t, BitRevOffset(2 * MAX_BITREV_POINTS)> table{};
+    for (uint32_t n = 2; n <= MAX_BITREV_POINTS; n <<= 1){
+        uint32_t pos = BitRevOffset(n);
+        for (uint32_t i = 0; i < n; i++){
+            uint32_t j = BitReverse(i, Log2(n));
+            if (i < j){
+                table[pos++] = i * 2 * sizeof(float);
+                table[pos++] = j * 2 * sizeof(float);
+            }
+        }
+    }
+    return table;
+}
+
+/**
+ * @brief Start of each lenght (indexed by log2) in the split or bit reverse tables, and bit reverse pairs
+ */
+constexpr std::array<uint16_t, 16> Index(uint32_t (*f)(uint32_t)){
+    std::array<uint16_t, 16> index{};
+    for (uint32_t bits = 1; (1UL << bits) <= MAX_SIGNAL_LENGHT; bits++){
+        index[bits] = f(1UL << bits);
+    }
+    return index;
+}
+
+constexpr auto split_table = SplitTwiddles();
+constexpr auto bitrev_table = BitRevTables();
+constexpr auto w_table_fc32 = RadixTwiddles<float>(1.0);
+constexpr auto w_table_sc16 = RadixTwiddles<int16_t>(INT16_MAX);
+constexpr auto split_offset = Index(SplitOffset);
+constexpr auto bitrev_offset = Index(BitRevOffset);
+constexpr auto bitrev_pairs = Index(BitRevPairs);
+
+/**
+ * @brief log2(n) if n is a power of two between min and max, 0 otherwise
+ */
+uint8_t PowerOfTwo(uint16_t n, uint16_t min, uint16_t max){
+    if ((n < min) || (n > max) || ((n & (n - 1)) != 0)){
+        return 0;
+    }
+    uint8_t bits = 0;
+    while ((1U << bits) < n){
+        bits++;
+    }
+    return bits;
+}
+
+} /* namespace */
+
+/*==================[external data definition]===============================*/
+
+/*==================[external functions definition]==========================*/
+const float * FFTTableTwiddle(void){
+    return w_table_fc32.data();
+}
+
+const int16_t * FFTTableTwiddleQ15(void){
+    return w_table_sc16.data();
+}
+
+const float * FFTTableSplit(uint16_t signal_lenght){
+    uint8_t bits = PowerOfTwo(signal_lenght, MIN_SPLIT_LENGHT, MAX_SIGNAL_LENGHT);
+    if (bits == 0){
+        return NULL;
+    }
+    return &split_table[split_offset[bits]];
+}
+
+const uint16_t * FFTTableBitRev(uint16_t n, uint16_t * pairs){
+    uint8_t bits = PowerOfTwo(n, 2, MAX_BITREV_POINTS);
+    if (bits == 0){
+        return NULL;
+    }
+    *pairs = bitrev_pairs[bits];
+    return &bitrev_table[bitrev_offset[bits]];
+}
+
+/*==================[end of file]============================================*/
@@ -0,0 +1,153 @@
+/**
+ * @file fir_filter.c
+ * @author Albano Peñalva (albano.penalva@uner.edu.ar)
+ * @brief 
+ * @version 0.1
+ * @date 2026-10-17
+ * 
+ * @copyright Copyright (c) 2023
+ * 
+ */
+
+/*==================[inclusions]=============================================*/
+#include <string.h>
+#include <stdlib.h>
+#include "fir_filter.h"
+#include "fft.h"
+#include "esp_dsp.h"
+/*==================[macros and definitions]=================================*/
+
+/*==================[internal data declaration]==============================*/
+
+/*==================[internal functions declaration]=========================*/
+static uint16_t FIRFFTLenght(uint16_t n_taps, uint16_t block_lenght);
+static float FIRFFTCost(uint16_t n_taps, uint16_t block_lenght);
+/*==================[internal data definition]===============================*/
+
+/*==================[external data definition]===============================*/
+
+/*==================[internal functions definition]==========================*/
+/**
+ * @brief Real FFT points needed for a block (0 if larger than MAX_SIGNAL_LENGHT)
+ */
+static uint16_t FIRFFTLenght(uint16_t n_taps, uint16_t block_lenght){
+    uint32_t n = 4;
+    while (n < (uint32_t)block_lenght + n_taps - 1){
+        n <<= 1;
+    }
+    return (n > MAX_SIGNAL_LENGHT) ? 0 : n;
+}
+
+/**
+ * @brief Estimated cost per output sample of the FFT method, in direct form taps
+ */
+static float FIRFFTCost(uint16_t n_taps, uint16_t block_lenght){
+    uint16_t n = FIRFFTLenght(n_taps, block_lenght);
+    uint8_t stages = 0;
+    while ((2 << stages) < n){
+        stages++;
+    }
+    // Forward and inverse n / 2 points complex transforms, plus split, product and merge
+    return (2 * (n / 4) * stages * FIR_FFT_BUTTERFLY_COST + 4.0f * n) / block_lenght;
+}
+
+/*==================[external functions definition]==========================*/
+bool FIRFilterInit(fir_filter_t * filter, float * coeff, uint16_t n_taps, uint16_t block_lenght, fir_method_t method){
+    memset(filter, 0, sizeof(fir_filter_t));
+    if ((n_taps == 0) || (block_lenght == 0)){
+        return false;
+    }
+    uint16_t n = FIRFFTLenght(n_taps, block_lenght);
+    if (method == FIR_AUTO){
+        method = ((n > 0) && (FIRFFTCost(n_taps, block_lenght) < n_taps)) ? FIR_FFT : FIR_DIRECT;
+    }
+    if ((method == FIR_FFT) && (n == 0)){
+        return false;
+    }
+    filter->method = method;
+    filter->n_taps = n_taps;
+    filter->block_lenght = block_lenght;
+    if (method == FIR_DIRECT){
+        // dsps_fir_f32() applies its first tap to the oldest sample
+        filter->coeff = (float *)malloc(n_taps * sizeof(float));
+        if (filter->coeff == NULL){
+            return false;
+        }
+        for (uint16_t i = 0; i < n_taps; i++){
+            filter->coeff[i] = coeff[n_taps - 1 - i];
+        }
+        if (dsps_fir_init_f32(&filter->fir, filter->coeff, NULL, n_taps) != ESP_OK){
+            FIRFilterDeinit(filter);
+            return false;
+        }
+        return true;
+    }
+    filter->coeff = (float *)malloc(n * sizeof(float));
+    filter->line = (float *)malloc((n_taps - 1 + block_lenght) * sizeof(float));
+    if ((filter->coeff == NULL) || (filter->line == NULL) || !FFTPlanCreate(&filter->plan, n, FFT_WINDOW_NONE)){
+        FIRFilterDeinit(filter);
+        return false;
+    }
+    // Taps spectrum (packed), with the inverse transform 2 / n scale
+    memset(filter->plan.buffer, 0, n * sizeof(float));
+    for (uint16_t i = 0; i < n_taps; i++){
+        filter->plan.buffer[i] = coeff[i] * 2 / n;
+    }
+    FFTPlanForward(&filter->plan);
+    memcpy(filter->coeff, filter->plan.buffer, n * sizeof(float));
+    FIRFilterReset(filter);
+    return true;
+}
+
+void FIRFilterApply(fir_filter_t * filter, float * input_signal, float * output_signal, uint16_t signal_lenght){
+    if (filter->method == FIR_DIRECT){
+        dsps_fir_f32(&filter->fir, input_signal, output_signal, signal_lenght);
+        return;
+    }
+    uint16_t n = filter->plan.signal_lenght;
+    uint16_t l = filter->block_lenght;
+    uint16_t h = filter->n_taps - 1;
+    float * z = filter->plan.buffer;
+    float * c = filter->coeff;
+    for (uint16_t start = 0; start < signal_lenght; start += l){
+        // History and new block, zero padded. The history is updated before the output
+        // is written, so input and output can be the same array.
+        memcpy(&filter->line[h], &input_signal[start], l * sizeof(float));
+        memcpy(z, filter->line, (h + l) * sizeof(float));
+        memset(&z[h + l], 0, (n - h - l) * sizeof(float));
+        memmove(filter->line, &filter->line[l], h * sizeof(float));
+        FFTPlanForward(&filter->plan);
+        // Spectrum product (X[0] and X[n / 2] are real)
+        z[0] *= c[0];
+        z[1] *= c[1];
+        for (uint16_t k = 2; k < n; k += 2){
+            float zr = z[k], zi = z[k + 1];
+            z[k] = zr * c[k] - zi * c[k + 1];
+            z[k + 1] = zr * c[k + 1] + zi * c[k];
+        }
+        FFTPlanInverse(&filter->plan);
+        // First n_taps - 1 samples are corrupted by the circular wrap around (overlap-save)
+        memcpy(&output_signal[start], &z[h], l * sizeof(float));
+    }
+}
+
+void FIRFilterReset(fir_filter_t * filter){
+    if (filter->method == FIR_DIRECT){
+        memset(filter->fir.delay, 0, filter->n_taps * sizeof(float));
+        filter->fir.pos = 0;
+    } else {
+        memset(filter->line, 0, (filter->n_taps - 1) * sizeof(float));
+    }
+}
+
+void FIRFilterDeinit(fir_filter_t * filter){
+    if (filter->fir.delay != NULL){
+        dsps_fir_f32_free(&filter->fir);
+    }
+    FFTPlanDestroy(&filter->plan);
+    free(filter->coeff);
+    free(filter->line);
+    memset(filter, 0, sizeof(fir_filter_t));
+}
+
+/*==================[end of file]============================================*/
@@ -10,6 +10,9 @@
  */
 
 /*==================[inclusions]=============================================*/
+#include <string.h>
+#include <stdlib.h>
+#include <math.h>
 #include "iir_filter.h"
 #include "esp_dsp.h"
 /*==================[macros and definitions]=================================*/
@@ -29,127 +32,206 @@
 #define ORDER8_Q2   (1 / 1.111)
 #define ORDER8_Q3   (1 / 1.663)
 #define ORDER8_Q4   (1 / 1.962)
+// Notch gain for dsps_biquad_gen_notch_f32 (-60 dB at notch frequency)
+#define NOTCH_GAIN  -120
 /*==================[internal data declaration]==============================*/
-static uint8_t lp_order, hp_order;
-float hp2_delay[N_DELAY] = {0, 0};  // delay
-float hp4_delay[N_DELAY] = {0, 0};  // delay
-float hp6_delay[N_DELAY] = {0, 0};  // delay
-float hp8_delay[N_DELAY] = {0, 0};  // delay
-float lp2_delay[N_DELAY] = {0, 0};  // delay
-float lp4_delay[N_DELAY] = {0, 0};  // delay
-float lp6_delay[N_DELAY] = {0, 0};  // delay
-float lp8_delay[N_DELAY] = {0, 0};  // delay
-float lp2_sos_coeff[N_SOS]; 
-float lp4_sos_coeff[N_SOS]; 
-float lp6_sos_coeff[N_SOS]; 
-float lp8_sos_coeff[N_SOS]; 
-float hp2_sos_coeff[N_SOS]; 
-float hp4_sos_coeff[N_SOS]; 
-float hp6_sos_coeff[N_SOS]; 
-float hp8_sos_coeff[N_SOS]; 
+static iir_filter_t lp_filter;      /* Filter used by LowPassInit()/LowPassFilter() */
+static iir_filter_t hp_filter;      /* Filter used by HiPassInit()/HiPassFilter() */
 /*==================[internal functions declaration]=========================*/
-
+static float ButterworthQ(uint8_t order, uint8_t section);
+static bool IIRFilterAlloc(iir_filter_t * filter, uint8_t n_sos, uint8_t n_channels);
+static int32_t IIRCoeffQ30(float coeff);
 /*==================[internal data definition]===============================*/
-
+static const float order2_q[] = {ORDER2_Q};
+static const float order4_q[] = {ORDER4_Q1, ORDER4_Q2};
+static const float order6_q[] = {ORDER6_Q1, ORDER6_Q2, ORDER6_Q3};
+static const float order8_q[] = {ORDER8_Q1, ORDER8_Q2, ORDER8_Q3, ORDER8_Q4};
 /*==================[external data definition]===============================*/
 
 /*==================[internal functions definition]==========================*/
-
-/*==================[external functions definition]==========================*/
-
-void LowPassInit(float sample_frec, float cut_frec, filter_order_t order){
-    float f = cut_frec / sample_frec;
-    lp_order = order;
-    switch(lp_order){
+/**
+ * @brief Q factor of a section of a Butterworth filter of a given even order
+ * 
+ * Tabulated values are used up to 8th order; higher orders use Q = 1 / (2 * cos(theta)),
+ * with the sections sorted from the highest to the lowest Q.
+ */
+static float ButterworthQ(uint8_t order, uint8_t section){
+    switch(order){
         case ORDER_2:
-            dsps_biquad_gen_lpf_f32(lp2_sos_coeff, f, ORDER2_Q);
-        break;
+            return order2_q[section];
         case ORDER_4:
-            dsps_biquad_gen_lpf_f32(lp2_sos_coeff, f, ORDER4_Q1);
-            dsps_biquad_gen_lpf_f32(lp4_sos_coeff, f, ORDER4_Q2);
-        break;
+            return order4_q[section];
         case ORDER_6:
-            dsps_biquad_gen_lpf_f32(lp2_sos_coeff, f, ORDER6_Q1);
-            dsps_biquad_gen_lpf_f32(lp4_sos_coeff, f, ORDER6_Q2);
-            dsps_biquad_gen_lpf_f32(lp6_sos_coeff, f, ORDER6_Q3);
-        break;
+            return order6_q[section];
         case ORDER_8:
-            dsps_biquad_gen_lpf_f32(lp2_sos_coeff, f, ORDER8_Q1);
-            dsps_biquad_gen_lpf_f32(lp4_sos_coeff, f, ORDER8_Q2);
-            dsps_biquad_gen_lpf_f32(lp6_sos_coeff, f, ORDER8_Q3);
-            dsps_biquad_gen_lpf_f32(lp8_sos_coeff, f, ORDER8_Q4);
-        break;
+            return order8_q[section];
+        default:
+            return 1 / (2 * cosf(M_PI * (order - 1 - 2 * section) / (2 * order)));
     }
 }
 
-void HiPassInit(float sample_frec, float cut_frec, filter_order_t order){
+/**
+ * @brief Allocate coefficients and cleared state of a filter object
+ */
+static bool IIRFilterAlloc(iir_filter_t * filter, uint8_t n_sos, uint8_t n_channels){
+    memset(filter, 0, sizeof(iir_filter_t));
+    if ((n_sos == 0) || (n_channels == 0) || (n_channels > IIR_MAX_CHANNELS)){
+        return false;
+    }
+    filter->n_sos = n_sos;
+    filter->n_channels = n_channels;
+    filter->coeff = (float *)malloc(n_sos * N_SOS * sizeof(float));
+    filter->delay = (float *)malloc(n_channels * n_sos * N_DELAY * sizeof(float));
+    if ((filter->coeff == NULL) || (filter->delay == NULL)){
+        IIRFilterDeinit(filter);
+        return false;
+    }
+    IIRFilterReset(filter);
+    return true;
+}
+
+/**
+ * @brief Round a coefficient to Q30, saturating to the int32_t range (|coeff| < 2)
+ */
+static int32_t IIRCoeffQ30(float coeff){
+    double q = round((double)coeff * (1 << DSPS_BIQUAD_S16_COEF_SHIFT));
+    if (q > INT32_MAX){
+        return INT32_MAX;
+    }
+    if (q < INT32_MIN){
+        return INT32_MIN;
+    }
+    return (int32_t)q;
+}
+
+/*==================[external functions definition]==========================*/
+bool IIRFilterInit(iir_filter_t * filter, filter_type_t type, float sample_frec, float cut_frec, uint8_t order, uint8_t n_channels){
+    if ((order % 2) || !IIRFilterAlloc(filter, order / 2, n_channels)){
+        return false;
+    }
     float f = cut_frec / sample_frec;
-    hp_order = order;
-    switch(hp_order){
-        case ORDER_2:
-            dsps_biquad_gen_hpf_f32(hp2_sos_coeff, f, ORDER2_Q);
-        break;
-        case ORDER_4:
-            dsps_biquad_gen_hpf_f32(hp2_sos_coeff, f, ORDER4_Q1);
-            dsps_biquad_gen_hpf_f32(hp4_sos_coeff, f, ORDER4_Q2);
-        break;
-        case ORDER_6:
-            dsps_biquad_gen_hpf_f32(hp2_sos_coeff, f, ORDER6_Q1);
-            dsps_biquad_gen_hpf_f32(hp4_sos_coeff, f, ORDER6_Q2);
-            dsps_biquad_gen_hpf_f32(hp6_sos_coeff, f, ORDER6_Q3);
-        break;
-        case ORDER_8:
-            dsps_biquad_gen_hpf_f32(hp2_sos_coeff, f, ORDER8_Q1);
-            dsps_biquad_gen_hpf_f32(hp4_sos_coeff, f, ORDER8_Q2);
-            dsps_biquad_gen_hpf_f32(hp6_sos_coeff, f, ORDER8_Q3);
-            dsps_biquad_gen_hpf_f32(hp8_sos_coeff, f, ORDER8_Q4);
-        break;
+    for (uint8_t i = 0; i < filter->n_sos; i++){
+        if (type == LOW_PASS){
+            dsps_biquad_gen_lpf_f32(&filter->coeff[i * N_SOS], f, ButterworthQ(order, i));
+        } else {
+            dsps_biquad_gen_hpf_f32(&filter->coeff[i * N_SOS], f, ButterworthQ(order, i));
+        }
+    }
+    return true;
+}
+
+bool IIRBandPassInit(iir_filter_t * filter, float sample_frec, float low_frec, float hi_frec, uint8_t order, uint8_t n_channels){
+    if ((order % 2) || (low_frec >= hi_frec) || !IIRFilterAlloc(filter, order, n_channels)){
+        return false;
+    }
+    uint8_t half = order / 2;
+    for (uint8_t i = 0; i < half; i++){
+        dsps_biquad_gen_hpf_f32(&filter->coeff[i * N_SOS], low_frec / sample_frec, ButterworthQ(order, i));
+        dsps_biquad_gen_lpf_f32(&filter->coeff[(half + i) * N_SOS], hi_frec / sample_frec, ButterworthQ(order, i));
+    }
+    return true;
+}
+
+bool IIRNotchInit(iir_filter_t * filter, float sample_frec, float notch_frec, float q, uint8_t n_harmonics, uint8_t n_channels){
+    uint8_t n_sos = 0;
+    while ((n_sos < n_harmonics) && ((n_sos + 1) * notch_frec < sample_frec / 2)){
+        n_sos++;
     }
+    if (!IIRFilterAlloc(filter, n_sos, n_channels)){
+        return false;
+    }
+    for (uint8_t i = 0; i < n_sos; i++){
+        dsps_biquad_gen_notch_f32(&filter->coeff[i * N_SOS], (i + 1) * notch_frec / sample_frec, NOTCH_GAIN, q);
+    }
+    return true;
+}
+
+void IIRFilterApply(iir_filter_t * filter, uint8_t channel, float * input_signal, float * output_signal, int16_t signal_lenght){
+    // All sections are applied to each sample in a single pass over the signal
+    dsps_biquad_sos_f32(input_signal, output_signal, signal_lenght, filter->coeff,
+                        &filter->delay[channel * filter->n_sos * N_DELAY], filter->n_sos);
+}
+
+void IIRFilterApplyInterleaved(iir_filter_t * filter, float * input_signal, float * output_signal, int16_t signal_lenght){
+    // All channels go through all the sections in a single pass, sharing the coefficients loads
+    dsps_biquad_sos_mc_f32(input_signal, output_signal, signal_lenght, filter->n_channels,
+                           filter->coeff, filter->delay, filter->n_sos);
+}
+
+void IIRFilterReset(iir_filter_t * filter){
+    memset(filter->delay, 0, filter->n_channels * filter->n_sos * N_DELAY * sizeof(float));
+}
+
+void IIRFilterDeinit(iir_filter_t * filter){
+    free(filter->coeff);
+    free(filter->delay);
+    memset(filter, 0, sizeof(iir_filter_t));
+}
+
+bool IIRFilterInitQ15(iir_filter_q15_t * filter, filter_type_t type, float sample_frec, float cut_frec, uint8_t order, uint8_t n_channels){
+    memset(filter, 0, sizeof(iir_filter_q15_t));
+    if ((order % 2) || (order == 0) || (n_channels == 0) || (n_channels > IIR_MAX_CHANNELS)){
+        return false;
+    }
+    filter->n_sos = order / 2;
+    filter->n_channels = n_channels;
+    filter->coeff = (int32_t *)malloc(filter->n_sos * N_SOS * sizeof(int32_t));
+    filter->delay = (int32_t *)malloc(n_channels * filter->n_sos * DSPS_BIQUAD_S16_STATE_SIZE * sizeof(int32_t));
+    if ((filter->coeff == NULL) || (filter->delay == NULL)){
+        IIRFilterDeinitQ15(filter);
+        return false;
+    }
+    IIRFilterResetQ15(filter);
+    // Sections are designed in floating point and converted once
+    float f = cut_frec / sample_frec;
+    float coeff[N_SOS];
+    for (uint8_t i = 0; i < filter->n_sos; i++){
+        if (type == LOW_PASS){
+            dsps_biquad_gen_lpf_f32(coeff, f, ButterworthQ(order, i));
+        } else {
+            dsps_biquad_gen_hpf_f32(coeff, f, ButterworthQ(order, i));
+        }
+        for (uint8_t j = 0; j < N_SOS; j++){
+            filter->coeff[i * N_SOS + j] = IIRCoeffQ30(coeff[j]);
+        }
+    }
+    return true;
+}
+
+void IIRFilterApplyQ15(iir_filter_q15_t * filter, uint8_t channel, int16_t * input_signal, int16_t * output_signal, int16_t signal_lenght){
+    dsps_biquad_sos_s16(input_signal, output_signal, signal_lenght, filter->coeff,
+                        &filter->delay[channel * filter->n_sos * DSPS_BIQUAD_S16_STATE_SIZE], filter->n_sos);
+}
+
+void IIRFilterResetQ15(iir_filter_q15_t * filter){
+    memset(filter->delay, 0, filter->n_channels * filter->n_sos * DSPS_BIQUAD_S16_STATE_SIZE * sizeof(int32_t));
+}
+
+void IIRFilterDeinitQ15(iir_filter_q15_t * filter){
+    free(filter->coeff);
+    free(filter->delay);
+    memset(filter, 0, sizeof(iir_filter_q15_t));
+}
+
+void LowPassInit(float sample_frec, float cut_frec, filter_order_t order){
+    IIRFilterDeinit(&lp_filter);
+    IIRFilterInit(&lp_filter, LOW_PASS, sample_frec, cut_frec, order, 1);
+}
+
+void HiPassInit(float sample_frec, float cut_frec, filter_order_t order){
+    IIRFilterDeinit(&hp_filter);
+    IIRFilterInit(&hp_filter, HI_PASS, sample_frec, cut_frec, order, 1);
 }
 
 void LowPassFilter(float * input_signal, float * output_signal, int16_t signal_lenght){
-    switch(lp_order){
-        case ORDER_2:
-            dsps_biquad_f32(input_signal, output_signal, signal_lenght, lp2_sos_coeff, lp2_delay);
-        break;
-        case ORDER_4:
-            dsps_biquad_f32(input_signal, output_signal, signal_lenght, lp2_sos_coeff, lp2_delay);
-            dsps_biquad_f32(output_signal, output_signal, signal_lenght, lp4_sos_coeff, lp4_delay);
-        break;
-        case ORDER_6:
-            dsps_biquad_f32(input_signal, output_signal, signal_lenght, lp2_sos_coeff, lp2_delay);
-            dsps_biquad_f32(output_signal, output_signal, signal_lenght, lp4_sos_coeff, lp4_delay);
-            dsps_biquad_f32(output_signal, output_signal, signal_lenght, lp6_sos_coeff, lp6_delay);
-        break;
-        case ORDER_8:
-            dsps_biquad_f32(input_signal, output_signal, signal_lenght, lp2_sos_coeff, lp2_delay);
-            dsps_biquad_f32(output_signal, output_signal, signal_lenght, lp4_sos_coeff, lp4_delay);
-            dsps_biquad_f32(output_signal, output_signal, signal_lenght, lp6_sos_coeff, lp6_delay);
-            dsps_biquad_f32(output_signal, output_signal, signal_lenght, lp8_sos_coeff, lp8_delay);
-        break;
+    if (lp_filter.n_sos > 0){
+        IIRFilterApply(&lp_filter, 0, input_signal, output_signal, signal_lenght);
     }
 }
 
 void HiPassFilter(float * input_signal, float * output_signal, int16_t signal_lenght){
-    switch(hp_order){
-        case ORDER_2:
-            dsps_biquad_f32(input_signal, output_signal, signal_lenght, hp2_sos_coeff, hp2_delay);
-        break;
-        case ORDER_4:
-            dsps_biquad_f32(input_signal, output_signal, signal_lenght, hp2_sos_coeff, hp2_delay);
-            dsps_biquad_f32(output_signal, output_signal, signal_lenght, hp4_sos_coeff, hp4_delay);
-        break;
-        case ORDER_6:
-            dsps_biquad_f32(input_signal, output_signal, signal_lenght, hp2_sos_coeff, hp2_delay);
-            dsps_biquad_f32(output_signal, output_signal, signal_lenght, hp4_sos_coeff, hp4_delay);
-            dsps_biquad_f32(output_signal, output_signal, signal_lenght, hp6_sos_coeff, hp6_delay);
-        break;
-        case ORDER_8:
-            dsps_biquad_f32(input_signal, output_signal, signal_lenght, hp2_sos_coeff, hp2_delay);
-            dsps_biquad_f32(output_signal, output_signal, signal_lenght, hp4_sos_coeff, hp4_delay);
-            dsps_biquad_f32(output_signal, output_signal, signal_lenght, hp6_sos_coeff, hp6_delay);
-            dsps_biquad_f32(output_signal, output_signal, signal_lenght, hp8_sos_coeff, hp8_delay);
-        break;
+    if (hp_filter.n_sos > 0){
+        IIRFilterApply(&hp_filter, 0, input_signal, output_signal, signal_lenght);
     }
 }
 
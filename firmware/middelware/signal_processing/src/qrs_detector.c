@@ -0,0 +1,322 @@
+/**
+ * @file qrs_detector.c
+ * @author Albano Peñalva (albano.penalva@uner.edu.ar)
+ * @brief
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2023
+ *
+ */
+
+/*==================[inclusions]=============================================*/
+#include <string.h>
+#include <stdlib.h>
+#include "qrs_detector.h"
+/*==================[macros and definitions]=================================*/
+#define ORIGINAL_FREC       200     /* Sample frequency of the original Pan-Tompkins filters */
+#define LP_LENGHT           6       /* Low pass lenght at ORIGINAL_FREC */
+#define HP_LENGHT           32      /* High pass lenght at ORIGINAL_FREC */
+#define MWI_TIME            150     /* Moving window integration (ms) */
+#define REFRACTORY_TIME     200     /* No beat can follow another one within this time (ms) */
+#define T_WAVE_TIME         360     /* Peaks within this time need a steep slope to be a beat (ms) */
+#define SEARCH_BACK_RR      166     /* Search back after this percentage of the average RR */
+#define QRS_MIN_FREC        100
+#define QRS_MAX_FREC        500     /* Keeps the band pass within 32 bit for full scale int16 inputs */
+/*==================[internal data declaration]==============================*/
+
+/*==================[internal functions declaration]=========================*/
+static uint16_t Millis(qrs_detector_t * detector, uint16_t time);
+static void QRSPrime(qrs_detector_t * detector, int16_t x);
+static int32_t QRSFilter(qrs_detector_t * detector, int16_t x, int32_t * square, int32_t * band_pass);
+static bool QRSBeat(qrs_detector_t * detector, int32_t peak, uint32_t peak_n, uint32_t r_n, int32_t slope, uint8_t weight_shift, qrs_beat_t * beat);
+static void QRSPeak(qrs_detector_t * detector, int32_t peak, uint32_t peak_n, uint32_t r_n, int32_t slope);
+static uint32_t QRSRWave(qrs_detector_t * detector, uint32_t n, bool positive);
+/*==================[internal data definition]===============================*/
+
+/*==================[external data definition]===============================*/
+
+/*==================[internal functions definition]==========================*/
+/**
+ * @brief Convert a time (ms) to samples
+ */
+static uint16_t Millis(qrs_detector_t * detector, uint16_t time){
+    return ((uint32_t)time * detector->sample_frec + 500) / 1000;
+}
+
+/**
+ * @brief Fill the delay lines as if the signal had been constant, so the first samples don't
+ * produce a filter transient that would spoil the learned thresholds
+ */
+static void QRSPrime(qrs_detector_t * detector, int16_t x){
+    int32_t sum1 = (int32_t)x * detector->lp_lenght;
+    int32_t sum2 = sum1 * detector->lp_lenght;
+    for (uint8_t i = 0; i < detector->lp_lenght; i++){
+        detector->lp_line[i] = x;
+        detector->lp_line[detector->lp_lenght + i] = sum1;
+    }
+    for (uint8_t i = 0; i < detector->hp_lenght; i++){
+        detector->hp_line[i] = sum2;
+    }
+    for (uint8_t i = 0; i < detector->raw_lenght; i++){
+        detector->raw_line[i] = x;
+    }
+    detector->lp_sum[0] = sum1;
+    detector->lp_sum[1] = sum2;
+    detector->hp_sum = sum2 * detector->hp_lenght;
+}
+
+/**
+ * @brief Band pass, derivative, squaring and moving window integration of one sample
+ *
+ * @param square    Squared derivative
+ * @param band_pass Band pass output
+ * @return          Integrated signal
+ */
+static int32_t QRSFilter(qrs_detector_t * detector, int16_t x, int32_t * square, int32_t * band_pass){
+    detector->raw_line[detector->raw_pos] = x;
+    if (++detector->raw_pos == detector->raw_lenght){
+        detector->raw_pos = 0;
+    }
+    /* Low pass: two cascaded moving sums */
+    int32_t * line = detector->lp_line;
+    uint8_t pos = detector->lp_pos;
+    detector->lp_sum[0] += x - line[pos];
+    line[pos] = x;
+    line += detector->lp_lenght;
+    detector->lp_sum[1] += detector->lp_sum[0] - line[pos];
+    line[pos] = detector->lp_sum[0];
+    if (++detector->lp_pos == detector->lp_lenght){
+        detector->lp_pos = 0;
+    }
+    /* High pass: delayed sample minus moving average (scaled by hp_lenght) */
+    int32_t lp = detector->lp_sum[1];
+    pos = detector->hp_pos;
+    detector->hp_sum += lp - detector->hp_line[pos];
+    detector->hp_line[pos] = lp;
+    uint8_t center = (pos >= detector->hp_lenght / 2) ? pos - detector->hp_lenght / 2 : pos + detector->hp_lenght - detector->hp_lenght / 2;
+    int32_t bp = (detector->hp_line[center] * detector->hp_lenght - detector->hp_sum) >> detector->bp_shift;
+    if (++detector->hp_pos == detector->hp_lenght){
+        detector->hp_pos = 0;
+    }
+    /* Five point derivative: (2 x[n] + x[n-1] - x[n-3] - 2 x[n-4]) / 8 */
+    int32_t * dif = detector->dif_line;
+    pos = detector->dif_pos;
+    int32_t d = (2 * bp + dif[(pos + 3) & 3] - dif[(pos + 1) & 3] - 2 * dif[pos]) >> 3;
+    dif[pos] = bp;
+    detector->dif_pos = (pos + 1) & 3;
+    /* Squaring (saturated) and moving window integration */
+    int32_t sq = (d > 46340 || d < -46340) ? detector->square_max : d * d;
+    if (sq > detector->square_max){
+        sq = detector->square_max;
+    }
+    pos = detector->mwi_pos;
+    detector->mwi_sum += sq - detector->mwi_line[pos];
+    detector->mwi_line[pos] = sq;
+    if (++detector->mwi_pos == detector->mwi_lenght){
+        detector->mwi_pos = 0;
+    }
+    *square = sq;
+    *band_pass = bp;
+    return detector->mwi_sum;
+}
+
+/**
+ * @brief Accept a peak as a beat and update the signal level
+ *
+ * @param r_n           Sample index of the band pass extreme of the peak (R wave)
+ * @param weight_shift  Signal level update weight (1 / 2^weight_shift)
+ * @param beat          Beat to fill
+ * @return true         Beat filled
+ */
+static bool QRSBeat(qrs_detector_t * detector, int32_t peak, uint32_t peak_n, uint32_t r_n, int32_t slope, uint8_t weight_shift, qrs_beat_t * beat){
+    detector->spki += (peak - detector->spki) >> weight_shift;
+    beat->sample = r_n;
+    beat->rr = 0;
+    beat->heart_rate = 0;
+    if (detector->beat_found){
+        uint32_t rr = peak_n - detector->last_qrs;
+        beat->rr = (rr > UINT16_MAX) ? UINT16_MAX : rr;
+        beat->heart_rate = (60 * (uint32_t)detector->sample_frec + rr / 2) / rr;
+        detector->rr_avg = (7 * (uint32_t)detector->rr_avg + beat->rr) / 8;
+    }
+    detector->last_qrs = peak_n;
+    detector->last_slope = slope;
+    detector->back_peak = 0;
+    detector->beat_found = true;
+    detector->threshold = detector->npki + (detector->spki - detector->npki) / 4;
+    return true;
+}
+
+/**
+ * @brief Classify a completed peak as noise or search back candidate (beats are handled by the caller)
+ */
+static void QRSPeak(qrs_detector_t * detector, int32_t peak, uint32_t peak_n, uint32_t r_n, int32_t slope){
+    detector->npki += (peak - detector->npki) >> 3;
+    if (peak > detector->threshold / 2 && peak > detector->back_peak && peak_n - detector->last_qrs > Millis(detector, REFRACTORY_TIME)){
+        detector->back_peak = peak;
+        detector->back_n = peak_n;
+        detector->back_r_n = r_n;
+        detector->back_slope = slope;
+    }
+    detector->threshold = detector->npki + (detector->spki - detector->npki) / 4;
+}
+
+/**
+ * @brief Locate the R wave on the input signal, around the sample the band pass extreme at n comes from
+ *
+ * The band pass moves the extreme of an asymmetric QRS complex by a few milliseconds, the input
+ * extreme within half a low pass lenght of it is the R wave.
+ *
+ * @param n         Sample index of the band pass extreme (the last one processed)
+ * @param positive  Band pass extreme sign
+ * @return          Sample index of the R wave
+ */
+static uint32_t QRSRWave(qrs_detector_t * detector, uint32_t n, bool positive){
+    uint8_t half = detector->lp_lenght / 2;
+    uint32_t r_n = n - detector->delay;
+    int32_t r = positive ? INT32_MIN : INT32_MAX;
+    for (uint16_t age = detector->delay - half; age <= detector->delay + half; age++){
+        /* raw_pos is next to the oldest sample, age 0 is the sample n */
+        uint8_t pos = (detector->raw_pos + detector->raw_lenght - 1 - age) % detector->raw_lenght;
+        int32_t x = detector->raw_line[pos];
+        if (positive ? (x > r) : (x < r)){
+            r = x;
+            r_n = n - age;
+        }
+    }
+    return r_n;
+}
+
+/*==================[external functions definition]==========================*/
+bool QRSDetectorInit(qrs_detector_t * detector, uint16_t sample_frec){
+    if (sample_frec < QRS_MIN_FREC || sample_frec > QRS_MAX_FREC){
+        return false;
+    }
+    memset(detector, 0, sizeof(qrs_detector_t));
+    detector->sample_frec = sample_frec;
+    detector->lp_lenght = (LP_LENGHT * sample_frec + ORIGINAL_FREC / 2) / ORIGINAL_FREC;
+    detector->hp_lenght = (HP_LENGHT * sample_frec + ORIGINAL_FREC / 2) / ORIGINAL_FREC;
+    detector->mwi_lenght = Millis(detector, MWI_TIME);
+    uint32_t gain = (uint32_t)detector->lp_lenght * detector->lp_lenght * detector->hp_lenght;
+    while (gain >>= 1){
+        detector->bp_shift++;
+    }
+    detector->delay = (detector->lp_lenght - 1) + detector->hp_lenght / 2;
+    detector->raw_lenght = detector->delay + detector->lp_lenght / 2 + 1;
+    detector->square_max = INT32_MAX / detector->mwi_lenght;
+    detector->lp_line = (int32_t *)malloc((2 * detector->lp_lenght + detector->hp_lenght + detector->mwi_lenght + detector->raw_lenght) * sizeof(int32_t));
+    if (detector->lp_line == NULL){
+        return false;
+    }
+    detector->hp_line = detector->lp_line + 2 * detector->lp_lenght;
+    detector->mwi_line = detector->hp_line + detector->hp_lenght;
+    detector->raw_line = detector->mwi_line + detector->mwi_lenght;
+    QRSDetectorReset(detector);
+    return true;
+}
+
+uint8_t QRSDetectorProcess(qrs_detector_t * detector, const int16_t * signal, uint16_t signal_lenght, qrs_beat_t * beats, uint8_t max_beats){
+    uint8_t n_beats = 0;
+    uint32_t learning = Millis(detector, QRS_LEARNING_TIME);
+    uint16_t refractory = Millis(detector, REFRACTORY_TIME);
+    uint16_t t_wave = Millis(detector, T_WAVE_TIME);
+    qrs_beat_t beat;
+    for (uint16_t i = 0; i < signal_lenght; i++){
+        if (detector->n == 0){
+            QRSPrime(detector, signal[i]);
+        }
+        int32_t square, bp;
+        int32_t mwi = QRSFilter(detector, signal[i], &square, &bp);
+        uint32_t n = detector->n++;
+        if (square > detector->slope){
+            detector->slope = square;
+        }
+        /* R wave: band pass extreme of the current peak, either polarity */
+        if (((bp < 0) ? -bp : bp) > detector->r_max){
+            detector->r_max = (bp < 0) ? -bp : bp;
+            detector->r_n = QRSRWave(detector, n, bp > 0);
+        }
+        if (n < learning){
+            /* Learning phase: signal level from the highest peak, noise level from the mean */
+            if (mwi > detector->learn_max){
+                detector->learn_max = mwi;
+            }
+            detector->learn_sum += mwi;
+            if (n == learning - 1){
+                detector->spki = detector->learn_max / 3;
+                detector->npki = detector->learn_sum / learning / 2;
+                detector->threshold = detector->npki + (detector->spki - detector->npki) / 4;
+                detector->rr_avg = detector->sample_frec;
+                detector->last_qrs = n;
+                detector->peak = 0;
+                detector->slope = 0;
+                detector->r_max = 0;
+            }
+            continue;
+        }
+        bool found = false;
+        if (mwi > detector->peak){
+            detector->peak = mwi;
+            detector->peak_n = n;
+        }
+        else if (mwi < detector->peak / 2){
+            /* Peak completed once the integrated signal falls to half of it */
+            int32_t peak = detector->peak;
+            uint32_t since = detector->peak_n - detector->last_qrs;
+            if (detector->beat_found && since < refractory){
+                /* Refractory period: physiologically impossible beat */
+            }
+            else if (peak > detector->threshold && !(detector->beat_found && since < t_wave && detector->slope < detector->last_slope / 2)){
+                found = QRSBeat(detector, peak, detector->peak_n, detector->r_n, detector->slope, 3, &beat);
+            }
+            else {
+                /* Noise or T wave */
+                QRSPeak(detector, peak, detector->peak_n, detector->r_n, detector->slope);
+            }
+            detector->peak = 0;
+            detector->slope = 0;
+            detector->r_max = 0;
+        }
+        if (!found && detector->back_peak > 0 && n - detector->last_qrs > (uint32_t)detector->rr_avg * SEARCH_BACK_RR / 100){
+            /* Search back: take the highest discarded peak since the last beat */
+            found = QRSBeat(detector, detector->back_peak, detector->back_n, detector->back_r_n, detector->back_slope, 2, &beat);
+        }
+        if (found && n_beats < max_beats){
+            beats[n_beats++] = beat;
+        }
+    }
+    return n_beats;
+}
+
+void QRSDetectorReset(qrs_detector_t * detector){
+    memset(detector->lp_line, 0, (2 * detector->lp_lenght + detector->hp_lenght + detector->mwi_lenght + detector->raw_lenght) * sizeof(int32_t));
+    memset(detector->dif_line, 0, sizeof(detector->dif_line));
+    detector->lp_pos = 0;
+    detector->hp_pos = 0;
+    detector->mwi_pos = 0;
+    detector->raw_pos = 0;
+    detector->dif_pos = 0;
+    detector->mwi_sum = 0;
+    detector->n = 0;
+    detector->peak = 0;
+    detector->slope = 0;
+    detector->r_max = 0;
+    detector->spki = 0;
+    detector->npki = 0;
+    detector->threshold = 0;
+    detector->learn_max = 0;
+    detector->learn_sum = 0;
+    detector->last_qrs = 0;
+    detector->last_slope = 0;
+    detector->rr_avg = 0;
+    detector->back_peak = 0;
+    detector->beat_found = false;
+}
+
+void QRSDetectorDeinit(qrs_detector_t * detector){
+    free(detector->lp_line);
+    detector->lp_line = NULL;
+}
+
+/*==================[end of file]============================================*/
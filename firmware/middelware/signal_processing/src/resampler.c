@@ -0,0 +1,291 @@
+/**
+ * @file resampler.c
+ * @author Albano Peñalva (albano.penalva@uner.edu.ar)
+ * @brief 
+ * @version 0.1
+ * @date 2026-10-17
+ * 
+ * @copyright Copyright (c) 2023
+ * 
+ */
+
+/*==================[inclusions]=============================================*/
+#include <string.h>
+#include <stdlib.h>
+#include <math.h>
+#include "resampler.h"
+#include "esp_dsp.h"
+/*==================[macros and definitions]=================================*/
+#define Q15_ONE     32768
+/* Design margin (dB): Kaiser's lenght estimate falls a few dB short for the short filters of the first
+ * stages, and the stopband leakage of up to three cascaded stages adds up on the output */
+#define FIR_LENGHT_MARGIN   15
+/*==================[internal data declaration]==============================*/
+
+/*==================[internal functions declaration]=========================*/
+static float BesselI0(float x);
+static float * FIRDesign(float sample_frec, float pass_frec, float stop_frec, uint16_t * n_taps);
+static uint8_t DecimatorStages(uint8_t decimation, uint8_t * factor);
+/*==================[internal data definition]===============================*/
+
+/*==================[external data definition]===============================*/
+
+/*==================[internal functions definition]==========================*/
+/**
+ * @brief Modified Bessel function of the first kind, order 0 (power series)
+ */
+static float BesselI0(float x){
+    float sum = 1, term = 1;
+    for (uint8_t k = 1; k < 32; k++){
+        term *= (x / (2 * k)) * (x / (2 * k));
+        sum += term;
+        if (term < 1e-9f * sum){
+            break;
+        }
+    }
+    return sum;
+}
+
+/**
+ * @brief Kaiser windowed-sinc low pass FIR with unity DC gain and RESAMPLER_ATTENUATION dB stopband
+ * 
+ * Window and lenght (odd) are designed for RESAMPLER_ATTENUATION plus FIR_LENGHT_MARGIN dB, the lenght
+ * estimated from the transition band with Kaiser's formula.
+ * 
+ * @return Coefficients array (allocated, n_taps values) or NULL
+ */
+static float * FIRDesign(float sample_frec, float pass_frec, float stop_frec, uint16_t * n_taps){
+    float transition = (stop_frec - pass_frec) / sample_frec;
+    if (transition <= 0){
+        return NULL;
+    }
+    float attenuation = RESAMPLER_ATTENUATION + FIR_LENGHT_MARGIN;
+    uint16_t n = ceilf((attenuation - 7.95f) / (2.285f * 2 * M_PI * transition)) + 1;
+    n |= 1;
+    float * coeff = (float *)malloc(n * sizeof(float));
+    if (coeff == NULL){
+        return NULL;
+    }
+    float beta = 0.1102f * (attenuation - 8.7f);
+    float fc = (pass_frec + stop_frec) / (2 * sample_frec);
+    float i0_beta = BesselI0(beta);
+    float sum = 0;
+    for (uint16_t i = 0; i < n; i++){
+        float m = i - (n - 1) / 2.0f;
+        float r = 2.0f * i / (n - 1) - 1;
+        float sinc = (m == 0) ? 2 * fc : sinf(2 * M_PI * fc * m) / (M_PI * m);
+        coeff[i] = sinc * BesselI0(beta * sqrtf(1 - r * r)) / i0_beta;
+        sum += coeff[i];
+    }
+    for (uint16_t i = 0; i < n; i++){
+        coeff[i] /= sum;
+    }
+    *n_taps = n;
+    return coeff;
+}
+
+/**
+ * @brief Split a decimation factor into its prime factors, largest first
+ * 
+ * Early stages run at the highest rate but have the widest transition bands (short filters),
+ * the longest filter runs at the lowest rate.
+ * 
+ * @return Number of stages (0 if more than DECIMATOR_MAX_STAGES are needed)
+ */
+static uint8_t DecimatorStages(uint8_t decimation, uint8_t * factor){
+    uint8_t primes[8];
+    uint8_t n = 0;
+    // Trial division finds the prime factors smallest first (at most 7 for a uint8_t)
+    for (uint8_t p = 2; decimation > 1; p++){
+        while ((decimation % p) == 0){
+            primes[n++] = p;
+            decimation /= p;
+        }
+    }
+    if (n > DECIMATOR_MAX_STAGES){
+        return 0;
+    }
+    for (uint8_t i = 0; i < n; i++){
+        factor[i] = primes[n - 1 - i];
+    }
+    return n;
+}
+
+/*==================[external functions definition]==========================*/
+bool DecimatorInit(decimator_t * decimator, float sample_frec, uint8_t decimation, float pass_frec){
+    uint8_t factor[DECIMATOR_MAX_STAGES];
+    memset(decimator, 0, sizeof(decimator_t));
+    if ((decimation < 2) || (pass_frec >= sample_frec / decimation / 2)){
+        return false;
+    }
+    uint8_t n_stages = DecimatorStages(decimation, factor);
+    if (n_stages == 0){
+        return false;
+    }
+    decimator->decimation = decimation;
+    for (uint8_t i = 0; i < n_stages; i++){
+        uint16_t n_taps;
+        sample_frec /= factor[i];
+        // Stage input rate is sample_frec * factor[i]: only what aliases onto 0..pass_frec is rejected
+        float * coeff = FIRDesign(sample_frec * factor[i], pass_frec, sample_frec - pass_frec, &n_taps);
+        float * delay = (float *)malloc(n_taps * sizeof(float));
+        if ((coeff == NULL) || (delay == NULL) || (dsps_fird_init_f32(&decimator->fir[i], coeff, delay, n_taps, factor[i]) != ESP_OK)){
+            free(coeff);
+            free(delay);
+            DecimatorDeinit(decimator);
+            return false;
+        }
+        decimator->n_stages++;
+    }
+    return true;
+}
+
+uint16_t DecimatorProcess(decimator_t * decimator, float * input_signal, float * output_signal, uint16_t signal_lenght){
+    // Each stage writes its output over its input, which it has already read
+    float * in = input_signal;
+    for (uint8_t i = 0; i < decimator->n_stages; i++){
+        signal_lenght /= decimator->fir[i].decim;
+        dsps_fird_f32(&decimator->fir[i], in, output_signal, signal_lenght);
+        in = output_signal;
+    }
+    return signal_lenght;
+}
+
+void DecimatorDeinit(decimator_t * decimator){
+    for (uint8_t i = 0; i < decimator->n_stages; i++){
+        free(decimator->fir[i].coeffs);
+        free(decimator->fir[i].delay);
+    }
+    memset(decimator, 0, sizeof(decimator_t));
+}
+
+bool DecimatorInitQ15(decimator_q15_t * decimator, float sample_frec, uint8_t decimation, float pass_frec){
+    uint8_t factor[DECIMATOR_MAX_STAGES];
+    memset(decimator, 0, sizeof(decimator_q15_t));
+    if ((decimation < 2) || (pass_frec >= sample_frec / decimation / 2)){
+        return false;
+    }
+    uint8_t n_stages = DecimatorStages(decimation, factor);
+    if (n_stages == 0){
+        return false;
+    }
+    decimator->decimation = decimation;
+    for (uint8_t i = 0; i < n_stages; i++){
+        uint16_t n_taps;
+        sample_frec /= factor[i];
+        float * coeff = FIRDesign(sample_frec * factor[i], pass_frec, sample_frec - pass_frec, &n_taps);
+        if (coeff == NULL){
+            DecimatorDeinitQ15(decimator);
+            return false;
+        }
+        int16_t * coeff_q15 = (int16_t *)malloc(n_taps * sizeof(int16_t));
+        int16_t * delay = (int16_t *)malloc(n_taps * sizeof(int16_t));
+        if ((coeff_q15 != NULL) && (delay != NULL)){
+            // Taps are below 1.0 (the largest one is about 2 * cut-off / sample frequency)
+            for (uint16_t j = 0; j < n_taps; j++){
+                coeff_q15[j] = lroundf(coeff[j] * Q15_ONE);
+            }
+        }
+        free(coeff);
+        if ((coeff_q15 == NULL) || (delay == NULL) ||
+            (dsps_fird_init_s16(&decimator->fir[i], coeff_q15, delay, n_taps, factor[i], 0, 0) != ESP_OK)){
+            free(coeff_q15);
+            free(delay);
+            DecimatorDeinitQ15(decimator);
+            return false;
+        }
+        decimator->n_stages++;
+    }
+    return true;
+}
+
+uint16_t DecimatorProcessQ15(decimator_q15_t * decimator, int16_t * input_signal, int16_t * output_signal, uint16_t signal_lenght){
+    int16_t * in = input_signal;
+    for (uint8_t i = 0; i < decimator->n_stages; i++){
+        signal_lenght /= decimator->fir[i].decim;
+        dsps_fird_s16(&decimator->fir[i], in, output_signal, signal_lenght);
+        in = output_signal;
+    }
+    return signal_lenght;
+}
+
+void DecimatorDeinitQ15(decimator_q15_t * decimator){
+    for (uint8_t i = 0; i < decimator->n_stages; i++){
+        dsps_fird_s16_aexx_free(&decimator->fir[i]);
+        free(decimator->fir[i].coeffs);
+        free(decimator->fir[i].delay);
+    }
+    memset(decimator, 0, sizeof(decimator_q15_t));
+}
+
+bool ResamplerInit(resampler_t * resampler, float sample_frec, uint8_t up, uint8_t down, float pass_frec){
+    memset(resampler, 0, sizeof(resampler_t));
+    if ((up == 0) || (down == 0)){
+        return false;
+    }
+    // Reduce up / down to lowest terms
+    uint8_t a = up, b = down;
+    while (b != 0){
+        uint8_t t = a % b;
+        a = b;
+        b = t;
+    }
+    up /= a;
+    down /= a;
+    float out_frec = sample_frec * up / down;
+    float stop_frec = ((out_frec < sample_frec) ? out_frec : sample_frec) - pass_frec;
+    uint16_t n_taps;
+    // Prototype filter runs at the interpolated rate
+    float * proto = FIRDesign(sample_frec * up, pass_frec, stop_frec, &n_taps);
+    if (proto == NULL){
+        return false;
+    }
+    resampler->up = up;
+    resampler->down = down;
+    resampler->n_taps = (n_taps + up - 1) / up;
+    resampler->coeff = (float *)calloc(up * resampler->n_taps, sizeof(float));
+    resampler->delay = (float *)calloc(2 * resampler->n_taps, sizeof(float));
+    if ((resampler->coeff == NULL) || (resampler->delay == NULL)){
+        free(proto);
+        ResamplerDeinit(resampler);
+        return false;
+    }
+    // Branch p tap k (applied to x[n - k]) is proto[p + k * up], stored reversed so that it matches
+    // the delay line from the oldest to the newest sample. Gain up restores the interpolated level.
+    for (uint8_t p = 0; p < up; p++){
+        for (uint16_t k = 0; k < resampler->n_taps; k++){
+            uint16_t i = p + k * up;
+            resampler->coeff[p * resampler->n_taps + resampler->n_taps - 1 - k] = (i < n_taps) ? up * proto[i] : 0;
+        }
+    }
+    free(proto);
+    return true;
+}
+
+uint16_t ResamplerProcess(resampler_t * resampler, float * input_signal, float * output_signal, uint16_t signal_lenght){
+    uint16_t n = resampler->n_taps;
+    uint16_t result = 0;
+    for (uint16_t i = 0; i < signal_lenght; i++){
+        if (++resampler->pos == n){
+            resampler->pos = 0;
+        }
+        resampler->delay[resampler->pos] = input_signal[i];
+        resampler->delay[resampler->pos + n] = input_signal[i];
+        // Outputs between this input sample and the next one
+        while (resampler->phase < resampler->up){
+            dsps_dotprod_f32(&resampler->delay[resampler->pos + 1], &resampler->coeff[resampler->phase * n],
+                             &output_signal[result++], n);
+            resampler->phase += resampler->down;
+        }
+        resampler->phase -= resampler->up;
+    }
+    return result;
+}
+
+void ResamplerDeinit(resampler_t * resampler){
+    free(resampler->coeff);
+    free(resampler->delay);
+    memset(resampler, 0, sizeof(resampler_t));
+}
+
+/*==================[end of file]============================================*/
@@ -0,0 +1,186 @@
+/**
+ * @file signal_quality.c
+ * @author Albano Peñalva (albano.penalva@uner.edu.ar)
+ * @brief
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2023
+ *
+ */
+
+/*==================[inclusions]=============================================*/
+#include <string.h>
+#include <math.h>
+#include <float.h>
+#include "signal_quality.h"
+#include "fft.h"
+/*==================[macros and definitions]=================================*/
+#define MASK_WORDS      (MAX_SIGNAL_LENGHT / 2 / 32)    /* Bins already assigned to the signal or its harmonics */
+#define MIN_LENGHT      16
+/*==================[internal data declaration]==============================*/
+
+/*==================[internal functions declaration]=========================*/
+static float Average(float average, float value, float alpha);
+static float PowerRatio(float num, float den);
+/*==================[internal data definition]===============================*/
+
+/*==================[external data definition]===============================*/
+
+/*==================[internal functions definition]==========================*/
+/**
+ * @brief Exponential average step
+ */
+static float Average(float average, float value, float alpha){
+    return average + alpha * (value - average);
+}
+
+/**
+ * @brief Power ratio in dB, protected against zero powers
+ */
+static float PowerRatio(float num, float den){
+    return 10.0f * log10f(fmaxf(num, FLT_MIN) / fmaxf(den, FLT_MIN));
+}
+
+/*==================[external functions definition]==========================*/
+bool SignalQualityInit(signal_quality_monitor_t * monitor, float sample_frec, uint16_t signal_lenght, uint8_t lobe, uint8_t n_harmonics, uint16_t averaging){
+    memset(monitor, 0, sizeof(signal_quality_monitor_t));
+    if ((signal_lenght < MIN_LENGHT) || (signal_lenght > MAX_SIGNAL_LENGHT) || ((signal_lenght & (signal_lenght - 1)) != 0)){
+        return false;
+    }
+    // The fundamental lobe, the DC region and some noise bins must fit in the frame
+    if ((lobe == 0) || (4 * lobe + 4 > signal_lenght / 2)){
+        return false;
+    }
+    if ((n_harmonics < 2) || (n_harmonics > SIGNAL_QUALITY_MAX_HARMONICS) || (averaging == 0) || !(sample_frec > 0)){
+        return false;
+    }
+    monitor->bins = signal_lenght / 2;
+    monitor->bin_frec = sample_frec / signal_lenght;
+    monitor->lobe = lobe;
+    monitor->n_harmonics = n_harmonics;
+    monitor->alpha = 1.0f / averaging;
+    return true;
+}
+
+void SignalQualityUpdate(signal_quality_monitor_t * monitor, const float * fft){
+    uint32_t mask[MASK_WORDS];
+    int16_t bins = monitor->bins;
+    int16_t lobe = monitor->lobe;
+    int16_t first = lobe + 1;           // Bins 0 to lobe hold DC and its leakage
+    memset(mask, 0, ((bins + 31) / 32) * sizeof(uint32_t));
+
+    // Fundamental: highest bin, frequency refined by parabolic interpolation of the log magnitude
+    // (a window main lobe is close to a gaussian: much less bias than on the magnitude)
+    int16_t peak = first;
+    for (int16_t k = first + 1; k < bins; k++){
+        if (fft[k] > fft[peak]){
+            peak = k;
+        }
+    }
+    float f0 = peak;
+    if ((peak > first) && (peak < bins - 1) && (fft[peak - 1] > 0) && (fft[peak + 1] > 0)){
+        float a = logf(fft[peak - 1]);
+        float b = logf(fft[peak]);
+        float c = logf(fft[peak + 1]);
+        float den = a - 2 * b + c;
+        if (den < 0){
+            f0 += 0.5f * (a - c) / den;
+        }
+    }
+    int16_t lo = (peak - lobe < first) ? first : peak - lobe;
+    int16_t hi = (peak + lobe > bins - 1) ? bins - 1 : peak + lobe;
+    float signal = 0;
+    uint16_t signal_bins = hi - lo + 1;
+    for (int16_t k = lo; k <= hi; k++){
+        signal += fft[k] * fft[k];
+        mask[k >> 5] |= 1UL << (k & 31);
+    }
+
+    // Harmonics, folded back into 0 to sample_frec / 2 as the ADC aliases them
+    float harmonics = 0;
+    uint16_t harmonic_bins = 0;
+    for (uint8_t h = 2; h <= monitor->n_harmonics; h++){
+        float f = fmodf(h * f0, 2.0f * bins);
+        if (f > bins){
+            f = 2.0f * bins - f;
+        }
+        int16_t center = lroundf(f);
+        if ((center < first) || (center > bins - 1)){
+            continue;
+        }
+        lo = (center - lobe < first) ? first : center - lobe;
+        hi = (center + lobe > bins - 1) ? bins - 1 : center + lobe;
+        for (int16_t k = lo; k <= hi; k++){
+            if ((mask[k >> 5] & (1UL << (k & 31))) == 0){
+                harmonics += fft[k] * fft[k];
+                harmonic_bins++;
+                mask[k >> 5] |= 1UL << (k & 31);
+            }
+        }
+    }
+
+    // Noise: every other bin. Spur: highest bin outside the fundamental lobe
+    float noise = 0;
+    float spur = 0;
+    uint16_t noise_bins = 0;
+    for (int16_t k = first; k < bins; k++){
+        float p = fft[k] * fft[k];
+        if ((k < peak - lobe) || (k > peak + lobe)){
+            spur = fmaxf(spur, p);
+        }
+        if ((mask[k >> 5] & (1UL << (k & 31))) == 0){
+            noise += p;
+            noise_bins++;
+        }
+    }
+    noise = (noise_bins > 0) ? noise / noise_bins : 0;
+    // The noise in the signal and harmonic bins is not part of them (small harmonics would be hidden by it)
+    signal -= noise * signal_bins;
+    harmonics -= noise * harmonic_bins;
+
+    float peak_power = fft[peak] * fft[peak];
+    if (monitor->frames == 0){
+        monitor->signal = signal;
+        monitor->peak = peak_power;
+        monitor->harmonics = harmonics;
+        monitor->spur = spur;
+        monitor->noise = noise;
+        monitor->frequency = f0;
+    } else {
+        float alpha = monitor->alpha;
+        monitor->signal = Average(monitor->signal, signal, alpha);
+        monitor->peak = Average(monitor->peak, peak_power, alpha);
+        monitor->harmonics = Average(monitor->harmonics, harmonics, alpha);
+        monitor->spur = Average(monitor->spur, spur, alpha);
+        monitor->noise = Average(monitor->noise, noise, alpha);
+        monitor->frequency = Average(monitor->frequency, f0, alpha);
+    }
+    monitor->frames++;
+}
+
+void SignalQualityGet(signal_quality_monitor_t * monitor, signal_quality_t * quality){
+    memset(quality, 0, sizeof(signal_quality_t));
+    if (monitor->frames == 0){
+        return;
+    }
+    // Noise mean per bin extended to all the bins above the DC region
+    float noise = monitor->noise * (monitor->bins - monitor->lobe - 1);
+    quality->snr = PowerRatio(monitor->signal, noise);
+    quality->sfdr = PowerRatio(monitor->peak, monitor->spur);
+    quality->thd = PowerRatio(monitor->harmonics, monitor->signal);
+    quality->noise_floor = sqrtf(monitor->noise);
+    quality->frequency = monitor->frequency * monitor->bin_frec;
+}
+
+void SignalQualityReset(signal_quality_monitor_t * monitor){
+    monitor->frames = 0;
+    monitor->signal = 0;
+    monitor->peak = 0;
+    monitor->harmonics = 0;
+    monitor->spur = 0;
+    monitor->noise = 0;
+    monitor->frequency = 0;
+}
+
+/*==================[end of file]============================================*/
@@ -0,0 +1,94 @@
+/**
+ * @file stft.c
+ * @author Albano Peñalva (albano.penalva@uner.edu.ar)
+ * @brief 
+ * @version 0.1
+ * @date 2026-10-17
+ * 
+ * @copyright Copyright (c) 2023
+ * 
+ */
+
+/*==================[inclusions]=============================================*/
+#include <string.h>
+#include <stdlib.h>
+#include "stft.h"
+/*==================[macros and definitions]=================================*/
+
+/*==================[internal data declaration]==============================*/
+
+/*==================[internal functions declaration]=========================*/
+
+/*==================[internal data definition]===============================*/
+
+/*==================[external data definition]===============================*/
+
+/*==================[internal functions definition]==========================*/
+
+/*==================[external functions definition]==========================*/
+bool STFTInit(stft_t * stft, uint16_t frame_lenght, uint16_t hop, fft_window_t window, void (*func_p)(void *, float *), void * param_p){
+    memset(stft, 0, sizeof(stft_t));
+    if ((hop == 0) || (hop > frame_lenght) || !FFTPlanCreate(&stft->plan, frame_lenght, window)){
+        return false;
+    }
+    stft->hop = hop;
+    stft->func_p = func_p;
+    stft->param_p = param_p;
+    stft->ring = (float *)malloc(frame_lenght * sizeof(float));
+    stft->frame = (float *)malloc(frame_lenght / 2 * sizeof(float));
+    if ((stft->ring == NULL) || (stft->frame == NULL)){
+        STFTDeinit(stft);
+        return false;
+    }
+    STFTReset(stft);
+    return true;
+}
+
+uint16_t STFTProcess(stft_t * stft, float * signal, uint16_t signal_lenght){
+    uint16_t n = stft->plan.signal_lenght;
+    uint16_t emitted = 0;
+    while (signal_lenght > 0){
+        // Copy up to the end of the next frame or the end of the ring, whatever comes first
+        uint16_t chunk = stft->pending;
+        if (chunk > signal_lenght){
+            chunk = signal_lenght;
+        }
+        if (chunk > n - stft->write){
+            chunk = n - stft->write;
+        }
+        memcpy(&stft->ring[stft->write], signal, chunk * sizeof(float));
+        signal += chunk;
+        signal_lenght -= chunk;
+        stft->pending -= chunk;
+        stft->write += chunk;
+        if (stft->write == n){
+            stft->write = 0;
+        }
+        if (stft->pending == 0){
+            // Ring is full: the oldest sample is the one to be overwritten next
+            FFTPlanMagnitudeRing(&stft->plan, stft->ring, stft->write, stft->frame);
+            stft->pending = stft->hop;
+            stft->frames++;
+            emitted++;
+            if (stft->func_p != NULL){
+                stft->func_p(stft->param_p, stft->frame);
+            }
+        }
+    }
+    return emitted;
+}
+
+void STFTReset(stft_t * stft){
+    stft->write = 0;
+    stft->pending = stft->plan.signal_lenght;
+    stft->frames = 0;
+}
+
+void STFTDeinit(stft_t * stft){
+    FFTPlanDestroy(&stft->plan);
+    free(stft->ring);
+    free(stft->frame);
+    memset(stft, 0, sizeof(stft_t));
+}
+
+/*==================[end of file]============================================*/
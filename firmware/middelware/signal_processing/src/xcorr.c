@@ -0,0 +1,234 @@
+/**
+ * @file xcorr.c
+ * @author Albano Peñalva (albano.penalva@uner.edu.ar)
+ * @brief
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2023
+ *
+ */
+
+/*==================[inclusions]=============================================*/
+#include <string.h>
+#include <stdlib.h>
+#include <math.h>
+#include "xcorr.h"
+/*==================[macros and definitions]=================================*/
+#define REFINE_STEPS    2           /* Newton steps on the interpolated peak */
+/*==================[internal data declaration]==============================*/
+
+/*==================[internal functions declaration]=========================*/
+static void XCorrCompute(xcorr_t * xcorr);
+static void XCorrAt(xcorr_t * xcorr, float m, float * r);
+/*==================[internal data definition]===============================*/
+
+/*==================[external data definition]===============================*/
+
+/*==================[internal functions definition]==========================*/
+/**
+ * @brief Weight the accumulated cross spectrum and transform it back
+ *
+ * The correlation is left in plan.buffer, lags -max_lag ... max_lag from index 0, and the weighted
+ * spectrum in x_spectrum (for XCorrAt()).
+ */
+static void XCorrCompute(xcorr_t * xcorr){
+    uint16_t n = xcorr->plan.signal_lenght;
+    float * z = xcorr->x_spectrum;
+    float * c = xcorr->cross;
+    // FFTPlanInverse() scales by n / 2
+    float scale = 2.0f / n;
+    if (xcorr->weighting == XCORR_PHAT){
+        // Magnitudes (X[0] and X[n / 2] are real) in plan.buffer, free until the inverse transform
+        float * mag = xcorr->plan.buffer;
+        mag[0] = fabsf(c[0]);
+        mag[n / 2] = fabsf(c[1]);
+        float mean = mag[0] + mag[n / 2];
+        for (uint16_t k = 2; k < n; k += 2){
+            mag[k / 2] = sqrtf(c[k] * c[k] + c[k + 1] * c[k + 1]);
+            mean += 2 * mag[k / 2];
+        }
+        // Floor: bins without signal would otherwise get the full weight of their noise
+        float floor = XCORR_PHAT_FLOOR * mean / n;
+        z[0] = c[0] * scale / (mag[0] + floor + 1e-30f);
+        z[1] = c[1] * scale / (mag[n / 2] + floor + 1e-30f);
+        for (uint16_t k = 2; k < n; k += 2){
+            float w = scale / (mag[k / 2] + floor + 1e-30f);
+            z[k] = c[k] * w;
+            z[k + 1] = c[k + 1] * w;
+        }
+    } else {
+        for (uint16_t k = 0; k < n; k++){
+            z[k] = c[k] * scale;
+        }
+    }
+    memcpy(xcorr->plan.buffer, z, n * sizeof(float));
+    FFTPlanInverse(&xcorr->plan);
+}
+
+/**
+ * @brief Band-limited correlation between lags, from the weighted spectrum left by XCorrCompute()
+ *
+ * r(m) = w[0] / 2 + w[1] / 2 * cos(pi * m) + sum of Re(W[k] * e^(j * 2 * pi * k * m / n)), which is
+ * plan.buffer[m] at integer m.
+ *
+ * @param m                 Fractional index in plan.buffer
+ * @param r                 Correlation and its first and second derivatives at m
+ */
+static void XCorrAt(xcorr_t * xcorr, float m, float * r){
+    uint16_t n = xcorr->plan.signal_lenght;
+    float * w = xcorr->x_spectrum;
+    float f0 = 2 * M_PI / n;
+    float nyquist = 0.5f * w[1];
+    r[0] = 0.5f * w[0] + nyquist * cosf(M_PI * m);
+    r[1] = -M_PI * nyquist * sinf(M_PI * m);
+    r[2] = -M_PI * M_PI * nyquist * cosf(M_PI * m);
+    // e^(j * k * f0 * m) by recurrence
+    float cs = cosf(f0 * m), sn = sinf(f0 * m);
+    float pr = cs, pi = sn;
+    for (uint16_t k = 1; k < n / 2; k++){
+        float re = w[2 * k] * pr - w[2 * k + 1] * pi;
+        float im = w[2 * k] * pi + w[2 * k + 1] * pr;
+        float f = f0 * k;
+        r[0] += re;
+        r[1] -= f * im;
+        r[2] -= f * f * re;
+        float t = pr * cs - pi * sn;
+        pi = pr * sn + pi * cs;
+        pr = t;
+    }
+}
+
+/*==================[external functions definition]==========================*/
+bool XCorrInit(xcorr_t * xcorr, uint16_t block_lenght, uint16_t max_lag, xcorr_weighting_t weighting, uint16_t averaging){
+    memset(xcorr, 0, sizeof(xcorr_t));
+    if ((block_lenght == 0) || ((uint32_t)block_lenght + 2 * max_lag > MAX_SIGNAL_LENGHT)){
+        return false;
+    }
+    if ((weighting != XCORR_PLAIN) && (weighting != XCORR_PHAT)){
+        return false;
+    }
+    uint16_t n = 4;
+    while (n < block_lenght + 2 * max_lag){
+        n <<= 1;
+    }
+    xcorr->weighting = weighting;
+    xcorr->block_lenght = block_lenght;
+    xcorr->max_lag = max_lag;
+    xcorr->alpha = (averaging == 0) ? 0 : 1.0f / averaging;
+    xcorr->cross = (float *)malloc(n * sizeof(float));
+    xcorr->x_spectrum = (float *)malloc(n * sizeof(float));
+    xcorr->x_line = (float *)malloc((max_lag + block_lenght) * sizeof(float));
+    xcorr->y_line = (float *)malloc((2 * max_lag + block_lenght) * sizeof(float));
+    if ((xcorr->cross == NULL) || (xcorr->x_spectrum == NULL) || (xcorr->x_line == NULL) || (xcorr->y_line == NULL) ||
+        !FFTPlanCreate(&xcorr->plan, n, FFT_WINDOW_NONE)){
+        XCorrDeinit(xcorr);
+        return false;
+    }
+    XCorrReset(xcorr);
+    return true;
+}
+
+void XCorrUpdate(xcorr_t * xcorr, const float * x, const float * y, uint16_t signal_lenght){
+    uint16_t n = xcorr->plan.signal_lenght;
+    uint16_t l = xcorr->block_lenght;
+    uint16_t m = xcorr->max_lag;
+    float * z = xcorr->plan.buffer;
+    float * c = xcorr->cross;
+    float * xs = xcorr->x_spectrum;
+    for (uint16_t start = 0; start < signal_lenght; start += l){
+        memcpy(&xcorr->x_line[m], &x[start], l * sizeof(float));
+        memcpy(&xcorr->y_line[2 * m], &y[start], l * sizeof(float));
+        // x block max_lag samples ago, zero padded: no wrap around for lags up to 2 * max_lag
+        memcpy(z, xcorr->x_line, l * sizeof(float));
+        memset(&z[l], 0, (n - l) * sizeof(float));
+        FFTPlanForward(&xcorr->plan);
+        memcpy(xs, z, n * sizeof(float));
+        // y from max_lag before to max_lag after that block
+        memcpy(z, xcorr->y_line, (l + 2 * m) * sizeof(float));
+        memset(&z[l + 2 * m], 0, (n - l - 2 * m) * sizeof(float));
+        FFTPlanForward(&xcorr->plan);
+        memmove(xcorr->x_line, &xcorr->x_line[l], m * sizeof(float));
+        memmove(xcorr->y_line, &xcorr->y_line[l], 2 * m * sizeof(float));
+        // Accumulate conj(X) * Y (X[0] and X[n / 2] are real)
+        float keep = 1, gain = 1;
+        if (xcorr->alpha > 0){
+            keep = (xcorr->blocks == 0) ? 0 : 1 - xcorr->alpha;
+            gain = (xcorr->blocks == 0) ? 1 : xcorr->alpha;
+        }
+        c[0] = keep * c[0] + gain * xs[0] * z[0];
+        c[1] = keep * c[1] + gain * xs[1] * z[1];
+        for (uint16_t k = 2; k < n; k += 2){
+            float re = xs[k] * z[k] + xs[k + 1] * z[k + 1];
+            float im = xs[k] * z[k + 1] - xs[k + 1] * z[k];
+            c[k] = keep * c[k] + gain * re;
+            c[k + 1] = keep * c[k + 1] + gain * im;
+        }
+        xcorr->blocks++;
+    }
+}
+
+void XCorrGet(xcorr_t * xcorr, float * corr){
+    XCorrCompute(xcorr);
+    memcpy(corr, xcorr->plan.buffer, (2 * xcorr->max_lag + 1) * sizeof(float));
+}
+
+float XCorrDelay(xcorr_t * xcorr, float * peak){
+    uint16_t last = 2 * xcorr->max_lag;
+    float * r = xcorr->plan.buffer;
+    XCorrCompute(xcorr);
+    uint16_t max = 0;
+    for (uint16_t i = 1; i <= last; i++){
+        if (r[i] > r[max]){
+            max = i;
+        }
+    }
+    // Parabola through the peak and its neighbours
+    float delta = 0;
+    float value = r[max];
+    if ((max > 0) && (max < last)){
+        float a = r[max - 1];
+        float b = r[max];
+        float c = r[max + 1];
+        float den = a - 2 * b + c;
+        if (den < 0){
+            delta = 0.5f * (a - c) / den;
+            value = b - 0.25f * (a - c) * delta;
+        }
+        // The parabola is biased up to 0.2 samples on a sharp peak (GCC-PHAT, wideband signals): Newton
+        // steps on the derivative of the band-limited correlation, n / 2 complex products each
+        float d[3];
+        for (uint8_t i = 0; i < REFINE_STEPS; i++){
+            XCorrAt(xcorr, max + delta, d);
+            if (d[2] >= 0){
+                break;
+            }
+            delta -= d[1] / d[2];
+            delta = (delta > 1) ? 1 : (delta < -1) ? -1 : delta;
+        }
+        XCorrAt(xcorr, max + delta, d);
+        value = d[0];
+    }
+    if (peak != NULL){
+        *peak = value;
+    }
+    return (float)max - xcorr->max_lag + delta;
+}
+
+void XCorrReset(xcorr_t * xcorr){
+    memset(xcorr->cross, 0, xcorr->plan.signal_lenght * sizeof(float));
+    memset(xcorr->x_line, 0, xcorr->max_lag * sizeof(float));
+    memset(xcorr->y_line, 0, 2 * xcorr->max_lag * sizeof(float));
+    xcorr->blocks = 0;
+}
+
+void XCorrDeinit(xcorr_t * xcorr){
+    FFTPlanDestroy(&xcorr->plan);
+    free(xcorr->cross);
+    free(xcorr->x_spectrum);
+    free(xcorr->x_line);
+    free(xcorr->y_line);
+    memset(xcorr, 0, sizeof(xcorr_t));
+}
+
+/*==================[end of file]============================================*/
@@ -0,0 +1,187 @@
+/**
+ * @file test_attitude.c
+ * @author Albano Peñalva (albano.penalva@uner.edu.ar)
+ * @brief Unity tests and benchmarks of the attitude module
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2023
+ *
+ */
+
+/*==================[inclusions]=============================================*/
+#include <string.h>
+#include <stdlib.h>
+#include <math.h>
+#include "unity.h"
+#include "dsp_platform.h"
+#include "esp_log.h"
+#include "attitude.h"
+/*==================[macros and definitions]=================================*/
+#define SAMPLE_FREC     1000
+#define REPLAY_TIME     120         /* Replay lenght (s) */
+#define SETTLE_TIME     10          /* Tilt errors are measured from then on (s) */
+#define BURST           20          /* Samples per FIFO burst */
+#define GYRO_RANGE      500         /* °/s */
+#define GYRO_LSB        65.5        /* LSB per °/s at GYRO_RANGE */
+#define ACCEL_LSB       16384       /* LSB per g at 2 g */
+#define Q30_ONE         1073741824.0
+static const char *TAG = "attitude";
+
+typedef struct {
+    double q[4];
+    double integral[3];
+    bool aligned;
+} mahony_t;
+/*==================[internal functions definition]==========================*/
+/**
+ * @brief Deterministic gaussian noise (Box-Muller on a LCG)
+ */
+static double Gauss(uint32_t * seed){
+    *seed = *seed * 1664525 + 1013904223;
+    double u = ((*seed >> 8) + 1.0) / 16777218.0;
+    *seed = *seed * 1664525 + 1013904223;
+    double v = ((*seed >> 8) + 1.0) / 16777218.0;
+    return sqrt(-2 * log(u)) * cos(2 * M_PI * v);
+}
+
+static void QuatProduct(const double * a, const double * b, double * r){
+    r[0] = a[0] * b[0] - a[1] * b[1] - a[2] * b[2] - a[3] * b[3];
+    r[1] = a[0] * b[1] + a[1] * b[0] + a[2] * b[3] - a[3] * b[2];
+    r[2] = a[0] * b[2] - a[1] * b[3] + a[2] * b[0] + a[3] * b[1];
+    r[3] = a[0] * b[3] + a[1] * b[2] - a[2] * b[1] + a[3] * b[0];
+}
+
+/**
+ * @brief Gravity direction in the body frame of a body to earth quaternion
+ */
+static void QuatGravity(const double * q, double * g){
+    g[0] = 2 * (q[1] * q[3] - q[0] * q[2]);
+    g[1] = 2 * (q[0] * q[1] + q[2] * q[3]);
+    g[2] = q[0] * q[0] - q[1] * q[1] - q[2] * q[2] + q[3] * q[3];
+}
+
+/**
+ * @brief Same Mahony filter as AttitudeUpdate(), in double
+ */
+static void MahonyRef(mahony_t * m, const attitude_sample_t * s){
+    double dt = 1.0 / SAMPLE_FREC;
+    double gyro_scale = GYRO_RANGE * M_PI / 180 / 32768;
+    double n = sqrt((double)s->ax * s->ax + (double)s->ay * s->ay + (double)s->az * s->az);
+    double a[3] = {s->ax / n, s->ay / n, s->az / n};
+    double * q = m->q;
+    if (!m->aligned){
+        double c = sqrt((1 + a[2]) / 2);
+        q[0] = c;
+        q[1] = a[1] / (2 * c);
+        q[2] = -a[0] / (2 * c);
+        q[3] = 0;
+        m->aligned = true;
+    }
+    double w[3] = {s->gx * gyro_scale, s->gy * gyro_scale, s->gz * gyro_scale};
+    double v[3];
+    QuatGravity(q, v);
+    double e[3] = {a[1] * v[2] - a[2] * v[1], a[2] * v[0] - a[0] * v[2], a[0] * v[1] - a[1] * v[0]};
+    for (uint8_t i = 0; i < 3; i++){
+        m->integral[i] += ATTITUDE_KI * e[i] * dt;
+        w[i] += ATTITUDE_KP * e[i] + m->integral[i];
+    }
+    double h[3] = {w[0] * dt / 2, w[1] * dt / 2, w[2] * dt / 2};
+    double q0 = q[0], q1 = q[1], q2 = q[2], q3 = q[3];
+    q[0] += -q1 * h[0] - q2 * h[1] - q3 * h[2];
+    q[1] += q0 * h[0] + q2 * h[2] - q3 * h[1];
+    q[2] += q0 * h[1] - q1 * h[2] + q3 * h[0];
+    q[3] += q0 * h[2] + q1 * h[1] - q2 * h[0];
+    n = sqrt(q[0] * q[0] + q[1] * q[1] + q[2] * q[2] + q[3] * q[3]);
+    for (uint8_t i = 0; i < 4; i++){
+        q[i] /= n;
+    }
+}
+
+TEST_CASE("AttitudeUpdate replay", "[attitude]")
+{
+    // Synthesized MPU6050 data: slow rotation on the three axes from a tilted start, gyroscope bias
+    // and noise, accelerometer noise and a 3 Hz vibration
+    const double bias[3] = {1.5, -2.0, 0.8};        /* °/s */
+    double qt[4] = {cos(0.3), sin(0.3) * 0.6, sin(0.3) * 0.8, 0};
+    uint8_t fifo[BURST * ATTITUDE_PACKET];
+    attitude_sample_t samples[BURST];
+    attitude_t attitude;
+    mahony_t ref = {0};
+    uint32_t seed = 1;
+    TEST_ASSERT_TRUE(AttitudeInit(&attitude, SAMPLE_FREC, GYRO_RANGE, ATTITUDE_KP, ATTITUDE_KI));
+
+    uint32_t n_samples = REPLAY_TIME * SAMPLE_FREC;
+    uint32_t cycles = 0, tilt_count = 0;
+    double tilt_sum = 0, tilt_max = 0, ref_error = 0, norm_error = 0;
+    for (uint32_t start = 0; start < n_samples; start += BURST){
+        for (uint16_t j = 0; j < BURST; j++){
+            double t = (double)(start + j) / SAMPLE_FREC;
+            double w[3] = {1.2 * sin(2 * M_PI * 0.11 * t), 0.9 * sin(2 * M_PI * 0.07 * t + 1), 0.6 * sin(2 * M_PI * 0.05 * t + 2)};
+            // True attitude: exact axis-angle step over the sample
+            double angle = sqrt(w[0] * w[0] + w[1] * w[1] + w[2] * w[2]) / SAMPLE_FREC;
+            double dq[4] = {1, 0, 0, 0}, r[4];
+            if (angle > 0){
+                dq[0] = cos(angle / 2);
+                for (uint8_t i = 0; i < 3; i++){
+                    dq[i + 1] = sin(angle / 2) * w[i] / SAMPLE_FREC / angle;
+                }
+            }
+            QuatProduct(qt, dq, r);
+            memcpy(qt, r, sizeof(qt));
+            double g[3];
+            QuatGravity(qt, g);
+            int16_t raw[6];
+            for (uint8_t i = 0; i < 3; i++){
+                raw[i] = lround((g[i] + 0.01 * Gauss(&seed) + 0.02 * sin(2 * M_PI * 3 * t + i)) * ACCEL_LSB);
+                raw[3 + i] = lround((w[i] * 180 / M_PI + bias[i]) * GYRO_LSB + 3 * Gauss(&seed));
+            }
+            // Big endian packets, as read from the FIFO
+            for (uint8_t i = 0; i < 6; i++){
+                fifo[j * ATTITUDE_PACKET + 2 * i] = (uint16_t)raw[i] >> 8;
+                fifo[j * ATTITUDE_PACKET + 2 * i + 1] = raw[i] & 0xFF;
+            }
+        }
+        uint16_t n = AttitudeUnpackFIFO(fifo, sizeof(fifo), samples);
+        TEST_ASSERT_EQUAL(BURST, n);
+        unsigned int start_b = xthal_get_ccount();
+        AttitudeUpdate(&attitude, samples, n);
+        unsigned int end_b = xthal_get_ccount();
+        cycles += end_b - start_b;
+        for (uint16_t j = 0; j < n; j++){
+            MahonyRef(&ref, &samples[j]);
+        }
+        double q[4], norm = 0;
+        for (uint8_t i = 0; i < 4; i++){
+            q[i] = attitude.q[i] / Q30_ONE;
+            ref_error = fmax(ref_error, fabs(q[i] - ref.q[i]));
+            norm += q[i] * q[i];
+        }
+        norm_error = fmax(norm_error, fabs(sqrt(norm) - 1));
+        // Tilt error: angle between the true and estimated gravity directions
+        if (start + BURST >= SETTLE_TIME * SAMPLE_FREC){
+            double gt[3], ge[3];
+            QuatGravity(qt, gt);
+            QuatGravity(q, ge);
+            double dot = gt[0] * ge[0] + gt[1] * ge[1] + gt[2] * ge[2];
+            double tilt = acos((dot > 1) ? 1 : dot) * 180 / M_PI;
+            tilt_sum += tilt * tilt;
+            tilt_max = fmax(tilt_max, tilt);
+            tilt_count++;
+        }
+    }
+    int16_t gyro_bias[3];
+    AttitudeGetGyroBias(&attitude, gyro_bias);
+    ESP_LOGI(TAG, "tilt error %.2f ° rms, %.2f ° max; gyroscope bias %d %d %d LSB (true %.0f %.0f %.0f)",
+             sqrt(tilt_sum / tilt_count), tilt_max, gyro_bias[0], gyro_bias[1], gyro_bias[2],
+             bias[0] * GYRO_LSB, bias[1] * GYRO_LSB, bias[2] * GYRO_LSB);
+    ESP_LOGI(TAG, "max error vs double Mahony %.2e, max |q| error %.2e, %.1f cycles per update",
+             ref_error, norm_error, (float)cycles / n_samples);
+    TEST_ASSERT_LESS_THAN(1.5, sqrt(tilt_sum / tilt_count));
+    TEST_ASSERT_LESS_THAN(4, tilt_max);
+    for (uint8_t i = 0; i < 3; i++){
+        TEST_ASSERT_INT_WITHIN(lround(0.3 * GYRO_LSB), lround(bias[i] * GYRO_LSB), gyro_bias[i]);
+    }
+    TEST_ASSERT_LESS_THAN(1e-4, ref_error);
+    TEST_ASSERT_LESS_THAN(1e-6, norm_error);
+}
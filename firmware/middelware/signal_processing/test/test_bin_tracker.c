@@ -0,0 +1,174 @@
+/**
+ * @file test_bin_tracker.c
+ * @author Albano Peñalva (albano.penalva@uner.edu.ar)
+ * @brief Unity tests and benchmarks of the bin tracker module
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2023
+ *
+ */
+
+/*==================[inclusions]=============================================*/
+#include <string.h>
+#include <stdlib.h>
+#include <math.h>
+#include "unity.h"
+#include "dsp_platform.h"
+#include "esp_log.h"
+#include "fft.h"
+#include "bin_tracker.h"
+/*==================[macros and definitions]=================================*/
+#define SAMPLE_FREC     1000
+#define MAX_BINS        8
+static const char *TAG = "bin_tracker";
+/*==================[internal functions definition]==========================*/
+/**
+ * @brief Tones of the given amplitudes at the bin frequencies, plus an offset
+ */
+static void TestSignal(float * signal, uint16_t signal_lenght, uint32_t start, float * bin_frec, float * amplitude, uint8_t n_bins){
+    for (uint16_t i = 0; i < signal_lenght; i++){
+        signal[i] = 0.1f;
+        for (uint8_t b = 0; b < n_bins; b++){
+            signal[i] += amplitude[b] * cosf(2 * M_PI * bin_frec[b] * (start + i) / SAMPLE_FREC + b);
+        }
+    }
+}
+
+TEST_CASE("BinTracker functionality", "[bin_tracker]")
+{
+    const uint16_t n = 250;         /* 4 Hz bins */
+    float bin_frec[] = {48, 100, 252, 400};
+    float tone[] = {0.4f, 0.2f, 0.1f, 0.05f};     /* Peak below 1.0 with the offset: no Q15 overflow */
+    uint8_t n_bins = sizeof(bin_frec) / sizeof(float);
+    float * signal = malloc(n * sizeof(float));
+    int16_t * signal_q15 = malloc(n * sizeof(int16_t));
+    TEST_ASSERT_NOT_NULL(signal_q15);
+    float amplitude[MAX_BINS];
+    float amplitude_slide[MAX_BINS];
+    int16_t amplitude_q15[MAX_BINS];
+    bin_tracker_t tracker;
+    bin_tracker_q15_t tracker_q15;
+    TEST_ASSERT_TRUE(BinTrackerInit(&tracker, SAMPLE_FREC, bin_frec, n_bins, n));
+    TEST_ASSERT_TRUE(BinTrackerInitQ15(&tracker_q15, SAMPLE_FREC, bin_frec, n_bins, n));
+
+    // Two windows, slid in uneven blocks: the sliding DFT covers the last window_lenght samples
+    for (uint32_t start = 0; start < 2 * n; start += n){
+        TestSignal(signal, n, start, bin_frec, tone, n_bins);
+        for (uint16_t i = 0; i < n; i++){
+            signal_q15[i] = lroundf(signal[i] * INT16_MAX);
+        }
+        BinTrackerGoertzel(&tracker, signal, amplitude);
+        BinTrackerSlide(&tracker, signal, 17);
+        BinTrackerSlide(&tracker, &signal[17], n - 17);
+        BinTrackerAmplitude(&tracker, amplitude_slide);
+        for (uint8_t b = 0; b < n_bins; b++){
+            TEST_ASSERT_FLOAT_WITHIN(1e-4f, tone[b], amplitude[b]);
+            TEST_ASSERT_FLOAT_WITHIN(1e-4f, tone[b], amplitude_slide[b]);
+        }
+        BinTrackerGoertzelQ15(&tracker_q15, signal_q15, amplitude_q15);
+        for (uint8_t b = 0; b < n_bins; b++){
+            TEST_ASSERT_INT_WITHIN(4, lroundf(tone[b] * INT16_MAX), amplitude_q15[b]);
+        }
+        BinTrackerSlideQ15(&tracker_q15, signal_q15, 17);
+        BinTrackerSlideQ15(&tracker_q15, &signal_q15[17], n - 17);
+        BinTrackerAmplitudeQ15(&tracker_q15, amplitude_q15);
+        for (uint8_t b = 0; b < n_bins; b++){
+            TEST_ASSERT_INT_WITHIN(4, lroundf(tone[b] * INT16_MAX), amplitude_q15[b]);
+        }
+    }
+    BinTrackerDeinit(&tracker);
+    BinTrackerDeinitQ15(&tracker_q15);
+    free(signal);
+    free(signal_q15);
+}
+
+TEST_CASE("BinTracker benchmark", "[bin_tracker]")
+{
+    float * signal = malloc(MAX_SIGNAL_LENGHT * sizeof(float));
+    float * fft = malloc(MAX_SIGNAL_LENGHT / 2 * sizeof(float));
+    int16_t * signal_q15 = malloc(MAX_SIGNAL_LENGHT * sizeof(int16_t));
+    uint16_t * raw = malloc(MAX_SIGNAL_LENGHT * sizeof(uint16_t));
+    int16_t * fft_q15 = malloc(MAX_SIGNAL_LENGHT / 2 * sizeof(int16_t));
+    TEST_ASSERT_NOT_NULL(fft_q15);
+    TEST_ASSERT_TRUE(FFTInit());
+    TEST_ASSERT_TRUE(FFTInitQ15());
+    float bin_frec[MAX_BINS];
+    float tone[MAX_BINS];
+    float amplitude[MAX_BINS];
+    int16_t amplitude_q15[MAX_BINS];
+    for (uint8_t b = 0; b < MAX_BINS; b++){
+        bin_frec[b] = 50 * (b + 1);
+        tone[b] = 0.1f;
+    }
+    int repeat_count = 4;
+    for (uint16_t n = 256; n <= MAX_SIGNAL_LENGHT; n *= 2){
+        TestSignal(signal, n, 0, bin_frec, tone, MAX_BINS);
+        for (uint16_t i = 0; i < n; i++){
+            signal_q15[i] = lroundf(signal[i] * INT16_MAX / 2);
+            raw[i] = 2048 + lroundf(signal[i] * 1024);
+        }
+        // FFT path: all the bins of the window (rectangular window, as the trackers)
+        fft_plan_t plan;
+        TEST_ASSERT_TRUE(FFTPlanCreate(&plan, n, FFT_WINDOW_NONE));
+        unsigned int start_b = xthal_get_ccount();
+        for (int i = 0; i < repeat_count; i++){
+            FFTPlanMagnitude(&plan, signal, fft);
+        }
+        unsigned int end_b = xthal_get_ccount();
+        float cycles_fft = (float)(end_b - start_b) / repeat_count;
+        FFTPlanDestroy(&plan);
+        start_b = xthal_get_ccount();
+        for (int i = 0; i < repeat_count; i++){
+            FFTMagnitudeQ15(raw, fft_q15, n);
+        }
+        end_b = xthal_get_ccount();
+        float cycles_fft_q15 = (float)(end_b - start_b) / repeat_count;
+        ESP_LOGI(TAG, "%d points: FFT %.0f cycles per window, FFT Q15 %.0f cycles per window", n, cycles_fft, cycles_fft_q15);
+
+        for (uint8_t n_bins = 1; n_bins <= MAX_BINS; n_bins *= 2){
+            bin_tracker_t tracker;
+            bin_tracker_q15_t tracker_q15;
+            TEST_ASSERT_TRUE(BinTrackerInit(&tracker, SAMPLE_FREC, bin_frec, n_bins, n));
+            TEST_ASSERT_TRUE(BinTrackerInitQ15(&tracker_q15, SAMPLE_FREC, bin_frec, n_bins, n));
+            start_b = xthal_get_ccount();
+            for (int i = 0; i < repeat_count; i++){
+                BinTrackerGoertzel(&tracker, signal, amplitude);
+            }
+            end_b = xthal_get_ccount();
+            float cycles_goertzel = (float)(end_b - start_b) / repeat_count;
+            // Sliding DFT: a window worth of samples and one readout
+            start_b = xthal_get_ccount();
+            for (int i = 0; i < repeat_count; i++){
+                BinTrackerSlide(&tracker, signal, n);
+                BinTrackerAmplitude(&tracker, amplitude);
+            }
+            end_b = xthal_get_ccount();
+            float cycles_slide = (float)(end_b - start_b) / repeat_count;
+            start_b = xthal_get_ccount();
+            for (int i = 0; i < repeat_count; i++){
+                BinTrackerGoertzelQ15(&tracker_q15, signal_q15, amplitude_q15);
+            }
+            end_b = xthal_get_ccount();
+            float cycles_goertzel_q15 = (float)(end_b - start_b) / repeat_count;
+            start_b = xthal_get_ccount();
+            for (int i = 0; i < repeat_count; i++){
+                BinTrackerSlideQ15(&tracker_q15, signal_q15, n);
+                BinTrackerAmplitudeQ15(&tracker_q15, amplitude_q15);
+            }
+            end_b = xthal_get_ccount();
+            float cycles_slide_q15 = (float)(end_b - start_b) / repeat_count;
+            ESP_LOGI(TAG, "%d points, %d bins: Goertzel %.0f (x%.1f vs FFT), sliding DFT %.0f (x%.1f), "
+                     "Goertzel Q15 %.0f (x%.1f vs FFT Q15), sliding DFT Q15 %.0f (x%.1f) cycles per window",
+                     n, n_bins, cycles_goertzel, cycles_fft / cycles_goertzel, cycles_slide, cycles_fft / cycles_slide,
+                     cycles_goertzel_q15, cycles_fft_q15 / cycles_goertzel_q15, cycles_slide_q15, cycles_fft_q15 / cycles_slide_q15);
+            BinTrackerDeinit(&tracker);
+            BinTrackerDeinitQ15(&tracker_q15);
+        }
+    }
+    free(signal);
+    free(fft);
+    free(signal_q15);
+    free(raw);
+    free(fft_q15);
+}
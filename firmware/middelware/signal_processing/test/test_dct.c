@@ -0,0 +1,105 @@
+/**
+ * @file test_dct.c
+ * @author Albano Peñalva (albano.penalva@uner.edu.ar)
+ * @brief Unity tests and benchmarks of the DCT module
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2023
+ *
+ */
+
+/*==================[inclusions]=============================================*/
+#include <string.h>
+#include <stdlib.h>
+#include <math.h>
+#include "unity.h"
+#include "dsp_platform.h"
+#include "esp_log.h"
+#include "esp_dsp.h"
+#include "dct.h"
+/*==================[macros and definitions]=================================*/
+static const char *TAG = "dct";
+/*==================[internal functions definition]==========================*/
+/**
+ * @brief Deterministic noise in -1000..1000
+ */
+static void TestSignal(float * signal, uint16_t signal_lenght){
+    uint32_t seed = signal_lenght;
+    for (uint16_t i = 0; i < signal_lenght; i++){
+        seed = seed * 1664525 + 1013904223;
+        signal[i] = ((int32_t)(seed >> 16) - 32768) / 32.768f;
+    }
+}
+
+TEST_CASE("DCTForward and DCTInverse functionality", "[dct]")
+{
+    float * x = malloc(DCT_MAX_LENGHT * sizeof(float));
+    float * y = malloc(DCT_MAX_LENGHT * sizeof(float));
+    TEST_ASSERT_NOT_NULL(y);
+    dct_plan_t plan;
+    TEST_ASSERT_FALSE(DCTPlanCreate(&plan, 1));
+    TEST_ASSERT_FALSE(DCTPlanCreate(&plan, 96));
+    TEST_ASSERT_FALSE(DCTPlanCreate(&plan, 2 * DCT_MAX_LENGHT));
+    for (uint16_t n = 2; n <= DCT_MAX_LENGHT; n *= 2){
+        TEST_ASSERT_TRUE(DCTPlanCreate(&plan, n));
+        TestSignal(x, n);
+        memcpy(y, x, n * sizeof(float));
+        DCTForward(&plan, y);
+        // Direct DCT-II in double
+        double max_error = 0, max_value = 0;
+        for (uint16_t k = 0; k < n; k++){
+            double sum = 0;
+            for (uint16_t i = 0; i < n; i++){
+                sum += x[i] * cos(M_PI * (i + 0.5) * k / n);
+            }
+            max_value = fmax(max_value, fabs(sum));
+            max_error = fmax(max_error, fabs(sum - y[k]));
+        }
+        DCTInverse(&plan, y);
+        float round_trip = 0;
+        for (uint16_t i = 0; i < n; i++){
+            round_trip = fmaxf(round_trip, fabsf(y[i] - x[i]));
+        }
+        ESP_LOGI(TAG, "%d points: forward error %.2e (relative to the peak), round trip error %.2e (relative)",
+                 n, max_error / max_value, round_trip / 1000);
+        TEST_ASSERT_LESS_THAN(1e-5, max_error / max_value);
+        TEST_ASSERT_LESS_THAN(1e-4f, round_trip / 1000);
+        DCTPlanDestroy(&plan);
+    }
+    free(x);
+    free(y);
+}
+
+TEST_CASE("DCTForward benchmark", "[dct]")
+{
+    float * x = malloc(DCT_MAX_LENGHT * sizeof(float));
+    float * y = malloc(DCT_MAX_LENGHT * sizeof(float));
+    TEST_ASSERT_NOT_NULL(y);
+    for (uint16_t n = 64; n <= DCT_MAX_LENGHT; n *= 2){
+        dct_plan_t plan;
+        TEST_ASSERT_TRUE(DCTPlanCreate(&plan, n));
+        TestSignal(x, n);
+        unsigned int start_b = xthal_get_ccount();
+        DCTForward(&plan, x);
+        unsigned int end_b = xthal_get_ccount();
+        unsigned int cycles_forward = end_b - start_b;
+        start_b = xthal_get_ccount();
+        DCTInverse(&plan, x);
+        end_b = xthal_get_ccount();
+        unsigned int cycles_inverse = end_b - start_b;
+        DCTPlanDestroy(&plan);
+        if (n > 256){
+            ESP_LOGI(TAG, "%d points: DCTForward %u, DCTInverse %u cycles", n, cycles_forward, cycles_inverse);
+            continue;
+        }
+        // O(N^2) reference, only up to 256 points
+        start_b = xthal_get_ccount();
+        dsps_dct_f32_ref(x, n, y);
+        end_b = xthal_get_ccount();
+        ESP_LOGI(TAG, "%d points: DCTForward %u, DCTInverse %u, dsps_dct_f32_ref %u cycles",
+                 n, cycles_forward, cycles_inverse, end_b - start_b);
+    }
+    free(x);
+    free(y);
+}
@@ -0,0 +1,162 @@
+/**
+ * @file test_dct_codec.c
+ * @author Albano Peñalva (albano.penalva@uner.edu.ar)
+ * @brief Unity tests and benchmarks of the DCT codec module
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2023
+ *
+ */
+
+/*==================[inclusions]=============================================*/
+#include <string.h>
+#include <stdlib.h>
+#include <math.h>
+#include "unity.h"
+#include "dsp_platform.h"
+#include "esp_log.h"
+#include "dct_codec.h"
+/*==================[macros and definitions]=================================*/
+#define SIGNAL_TIME     100         /* Coded signal lenght (s) */
+#define ECG_FREC        360
+#define ACCEL_FREC      100
+#define MAX_BLOCK       256
+static const char *TAG = "dct_codec";
+
+typedef int16_t (*test_signal_t)(uint32_t n, uint32_t * seed);
+
+typedef struct {
+    test_signal_t signal;
+    const char * name;
+    uint16_t sample_frec;
+    uint16_t block_lenght;
+    float step;
+    float min_ratio;            /* Compression ratio against 16 bit samples */
+    float min_snr;              /* dB */
+} codec_case_t;
+/*==================[internal functions definition]==========================*/
+/**
+ * @brief Deterministic gaussian noise (Box-Muller on a LCG)
+ */
+static float Gauss(uint32_t * seed){
+    *seed = *seed * 1664525 + 1013904223;
+    float u = ((*seed >> 8) + 1.0f) / 16777218.0f;
+    *seed = *seed * 1664525 + 1013904223;
+    float v = ((*seed >> 8) + 1.0f) / 16777218.0f;
+    return sqrtf(-2 * logf(u)) * cosf(2 * M_PI * v);
+}
+
+/**
+ * @brief Synthetic ECG: 11 bit ADC, 200 LSB/mV, 72 bpm, baseline wander, 1 LSB noise
+ */
+static int16_t ECGSignal(uint32_t n, uint32_t * seed){
+    float t = (float)n / ECG_FREC;
+    float phase = fmodf(t * 1.2f, 1.0f);
+    float v = 0.12f * expf(-powf((phase - 0.2f) / 0.025f, 2)) - 0.1f * expf(-powf((phase - 0.32f) / 0.01f, 2)) +
+              1.1f * expf(-powf((phase - 0.35f) / 0.01f, 2)) - 0.25f * expf(-powf((phase - 0.38f) / 0.012f, 2)) +
+              0.3f * expf(-powf((phase - 0.6f) / 0.05f, 2)) + 0.15f * sinf(2 * M_PI * 0.25f * t);
+    return lroundf(1024 + 200 * v + Gauss(seed));
+}
+
+/**
+ * @brief Synthetic accelerometer (walking at 1.8 Hz): 16384 LSB/g, 20 LSB noise
+ */
+static int16_t AccelSignal(uint32_t n, uint32_t * seed){
+    float t = (float)n / ACCEL_FREC;
+    float v = 1 + 0.25f * sinf(2 * M_PI * 1.8f * t) + 0.1f * sinf(2 * M_PI * 3.6f * t + 1) + 0.05f * sinf(2 * M_PI * 5.4f * t + 2);
+    return lroundf(16384 * v + 20 * Gauss(seed));
+}
+
+TEST_CASE("DCTCodec compression", "[dct_codec]")
+{
+    const codec_case_t cases[] = {
+        {ECGSignal, "ECG", ECG_FREC, 128, 4, 4.3f, 29.5f},
+        {ECGSignal, "ECG", ECG_FREC, 128, 8, 6.4f, 26.5f},
+        {ECGSignal, "ECG", ECG_FREC, 128, 16, 9.0f, 22.3f},
+        {AccelSignal, "accel", ACCEL_FREC, 64, 128, 3.6f, 39.5f},
+        {AccelSignal, "accel", ACCEL_FREC, 64, 256, 4.9f, 35.0f},
+    };
+    int16_t signal[MAX_BLOCK];
+    int16_t decoded[MAX_BLOCK];
+    uint8_t * data = malloc(DCT_CODEC_MAX_BYTES(MAX_BLOCK));
+    TEST_ASSERT_NOT_NULL(data);
+    for (uint8_t c = 0; c < sizeof(cases) / sizeof(codec_case_t); c++){
+        const codec_case_t * t = &cases[c];
+        uint16_t n = t->block_lenght;
+        dct_codec_t codec;
+        TEST_ASSERT_TRUE(DCTCodecInit(&codec, n, t->step));
+        uint32_t seed = 1;
+        uint32_t n_samples = (SIGNAL_TIME * t->sample_frec / n) * n;
+        uint32_t bytes = 0, cycles_encode = 0, cycles_decode = 0;
+        double sum = 0, sum_square = 0, error_square = 0;
+        // Block by block: encoded, decoded and compared
+        for (uint32_t start = 0; start < n_samples; start += n){
+            for (uint16_t i = 0; i < n; i++){
+                signal[i] = t->signal(start + i, &seed);
+            }
+            unsigned int start_b = xthal_get_ccount();
+            uint16_t size = DCTCodecEncode(&codec, signal, data, DCT_CODEC_MAX_BYTES(n));
+            unsigned int end_b = xthal_get_ccount();
+            cycles_encode += end_b - start_b;
+            TEST_ASSERT_NOT_EQUAL(0, size);
+            start_b = xthal_get_ccount();
+            TEST_ASSERT_EQUAL(size, DCTCodecDecode(&codec, data, size, decoded));
+            end_b = xthal_get_ccount();
+            cycles_decode += end_b - start_b;
+            bytes += size;
+            for (uint16_t i = 0; i < n; i++){
+                double e = signal[i] - decoded[i];
+                sum += signal[i];
+                sum_square += (double)signal[i] * signal[i];
+                error_square += e * e;
+            }
+        }
+        // SNR against the signal variance (the offset is not information)
+        double variance = sum_square - sum * sum / n_samples;
+        float snr = 10 * log10(variance / error_square);
+        float ratio = 2.0f * n_samples / bytes;
+        ESP_LOGI(TAG, "%s, blocks of %d, step %.0f: CR %.1f (%.2f bits per sample), SNR %.1f dB, PRDN %.2f %%, "
+                 "encode %.1f, decode %.1f cycles per sample", t->name, n, t->step, ratio, 16 / ratio, snr,
+                 100 * sqrt(error_square / variance), (float)cycles_encode / n_samples, (float)cycles_decode / n_samples);
+        TEST_ASSERT_GREATER_THAN(t->min_ratio, ratio);
+        TEST_ASSERT_GREATER_THAN(t->min_snr, snr);
+        DCTCodecDeinit(&codec);
+    }
+    free(data);
+}
+
+TEST_CASE("DCTCodec corrupt data", "[dct_codec]")
+{
+    const uint16_t n = 64;
+    int16_t signal[64];
+    int16_t decoded[64];
+    uint8_t data[DCT_CODEC_MAX_BYTES(64)];
+    dct_codec_t codec;
+    TEST_ASSERT_TRUE(DCTCodecInit(&codec, n, 4));
+    uint32_t seed = 1;
+    for (uint16_t i = 0; i < n; i++){
+        signal[i] = ECGSignal(i, &seed);
+    }
+    // Output buffer too small
+    TEST_ASSERT_EQUAL(0, DCTCodecEncode(&codec, signal, data, 4));
+    // Truncated block
+    uint16_t size = DCTCodecEncode(&codec, signal, data, sizeof(data));
+    TEST_ASSERT_NOT_EQUAL(0, size);
+    for (uint16_t lenght = 0; lenght < size; lenght++){
+        TEST_ASSERT_EQUAL(0, DCTCodecDecode(&codec, data, lenght, decoded));
+    }
+    // Random streams are decoded within bounds (run with a memory sanitizer on the host)
+    uint32_t valid = 0;
+    for (uint32_t i = 0; i < 10000; i++){
+        for (uint16_t j = 0; j < 40; j++){
+            seed = seed * 1664525 + 1013904223;
+            data[j] = seed >> 24;
+        }
+        if (DCTCodecDecode(&codec, data, 40, decoded)){
+            valid++;
+        }
+    }
+    ESP_LOGI(TAG, "random streams decoded as valid blocks: %u of 10000", valid);
+    DCTCodecDeinit(&codec);
+}
@@ -0,0 +1,293 @@
+/**
+ * @file test_fft.c
+ * @author Albano Peñalva (albano.penalva@uner.edu.ar)
+ * @brief Unity tests and benchmarks of the FFT module
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2023
+ *
+ */
+
+/*==================[inclusions]=============================================*/
+#include <string.h>
+#include <stdlib.h>
+#include <math.h>
+#include "unity.h"
+#include "dsp_platform.h"
+#include "esp_log.h"
+#include "esp_dsp.h"
+#include "fft.h"
+/*==================[macros and definitions]=================================*/
+static const char *TAG = "fft";
+/*==================[internal functions definition]==========================*/
+/**
+ * @brief FFTMagnitude() before the plans: zero padded full lenght complex transform
+ */
+static void FFTMagnitudeRef(float * signal, float * fft, uint16_t signal_lenght, float * wind, float * fft_complex){
+    dsps_wind_hann_f32(wind, signal_lenght);
+    memset(fft_complex, 0, 2 * signal_lenght * sizeof(float));
+    dsps_mul_f32(signal, wind, fft_complex, signal_lenght, 1, 1, 2);
+    dsps_fft2r_fc32(fft_complex, signal_lenght);
+    dsps_bit_rev_fc32(fft_complex, signal_lenght);
+    dsps_cplx2reC_fc32(fft_complex, signal_lenght);
+    for (int j = 0; j < signal_lenght; j++){
+        fft_complex[j] = 2 * (sqrt(fft_complex[j * 2 + 0] * fft_complex[j * 2 + 0] + fft_complex[j * 2 + 1] * fft_complex[j * 2 + 1])) / (signal_lenght / 2);
+    }
+    fft_complex[0] = fft_complex[0] / 2;
+    memcpy(fft, fft_complex, (signal_lenght / 2) * sizeof(float));
+}
+
+/**
+ * @brief Test signal: ADC offset, two tones and a deterministic noise
+ */
+static void TestSignal(float * signal, uint16_t signal_lenght){
+    uint32_t seed = 12345;
+    for (uint16_t i = 0; i < signal_lenght; i++){
+        seed = seed * 1664525 + 1013904223;
+        signal[i] = 2048 + 1500 * sinf(2 * M_PI * 0.1234f * i) + 300 * cosf(2 * M_PI * 0.3711f * i) +
+                    ((int32_t)(seed >> 20) - 2048) / 256.0f;
+    }
+}
+
+/*==================[test cases]=============================================*/
+TEST_CASE("FFTPlanMagnitude functionality", "[fft]")
+{
+    float * signal = malloc(MAX_SIGNAL_LENGHT * sizeof(float));
+    float * fft = malloc(MAX_SIGNAL_LENGHT / 2 * sizeof(float));
+    float * ref = malloc(MAX_SIGNAL_LENGHT / 2 * sizeof(float));
+    float * wind = malloc(MAX_SIGNAL_LENGHT * sizeof(float));
+    float * fft_complex = malloc(2 * MAX_SIGNAL_LENGHT * sizeof(float));
+    TEST_ASSERT_NOT_NULL(fft_complex);
+    TEST_ASSERT_TRUE(FFTInit());
+    for (uint16_t n = 16; n <= MAX_SIGNAL_LENGHT; n *= 2){
+        fft_plan_t plan;
+        TEST_ASSERT_TRUE(FFTPlanCreate(&plan, n, FFT_WINDOW_HANN));
+        TestSignal(signal, n);
+        FFTMagnitudeRef(signal, ref, n, wind, fft_complex);
+        FFTPlanMagnitude(&plan, signal, fft);
+        float max_error = 0;
+        for (uint16_t k = 0; k < n / 2; k++){
+            max_error = fmaxf(max_error, fabsf(fft[k] - ref[k]));
+        }
+        // Same transform up to float rounding (peak about 1500)
+        ESP_LOGI(TAG, "%d points: max error %g", n, max_error);
+        TEST_ASSERT_LESS_THAN(2e-3f, max_error);
+        // FFTMagnitude() reuses an internal plan with the same result
+        FFTMagnitude(signal, ref, n);
+        TEST_ASSERT_EQUAL(0, memcmp(fft, ref, n / 2 * sizeof(float)));
+        FFTPlanDestroy(&plan);
+    }
+    TEST_ASSERT_FALSE(FFTPlanCreate(&(fft_plan_t){0}, 24, FFT_WINDOW_HANN));
+    TEST_ASSERT_FALSE(FFTPlanCreate(&(fft_plan_t){0}, 2 * MAX_SIGNAL_LENGHT, FFT_WINDOW_HANN));
+    free(signal);
+    free(fft);
+    free(ref);
+    free(wind);
+    free(fft_complex);
+}
+
+TEST_CASE("FFTPlanMagnitude benchmark", "[fft]")
+{
+    float * signal = malloc(MAX_SIGNAL_LENGHT * sizeof(float));
+    float * fft = malloc(MAX_SIGNAL_LENGHT / 2 * sizeof(float));
+    float * wind = malloc(MAX_SIGNAL_LENGHT * sizeof(float));
+    float * fft_complex = malloc(2 * MAX_SIGNAL_LENGHT * sizeof(float));
+    TEST_ASSERT_NOT_NULL(fft_complex);
+    TEST_ASSERT_TRUE(FFTInit());
+    int repeat_count = 16;
+    for (uint16_t n = 256; n <= MAX_SIGNAL_LENGHT; n *= 2){
+        fft_plan_t plan;
+        TEST_ASSERT_TRUE(FFTPlanCreate(&plan, n, FFT_WINDOW_HANN));
+        TestSignal(signal, n);
+        unsigned int start_b = xthal_get_ccount();
+        for (int i = 0; i < repeat_count; i++){
+            FFTMagnitudeRef(signal, fft, n, wind, fft_complex);
+        }
+        unsigned int end_b = xthal_get_ccount();
+        float cycles_ref = (float)(end_b - start_b) / repeat_count;
+        start_b = xthal_get_ccount();
+        for (int i = 0; i < repeat_count; i++){
+            FFTPlanMagnitude(&plan, signal, fft);
+        }
+        end_b = xthal_get_ccount();
+        float cycles_plan = (float)(end_b - start_b) / repeat_count;
+        ESP_LOGI(TAG, "%d points: full lenght complex transform %.0f cycles per frame, plan %.0f cycles per frame (x%.1f)",
+                 n, cycles_ref, cycles_plan, cycles_ref / cycles_plan);
+        FFTPlanDestroy(&plan);
+    }
+    free(signal);
+    free(fft);
+    free(wind);
+    free(fft_complex);
+}
+
+TEST_CASE("FFTPlanSetOutput accuracy", "[fft]")
+{
+    const uint16_t n = 1024;
+    float * signal = malloc(n * sizeof(float));
+    float * ref = malloc(n / 2 * sizeof(float));
+    float * fft = malloc(n / 2 * sizeof(float));
+    TEST_ASSERT_NOT_NULL(fft);
+    TEST_ASSERT_TRUE(FFTInit());
+    fft_plan_t plan;
+    TEST_ASSERT_TRUE(FFTPlanCreate(&plan, n, FFT_WINDOW_HANN));
+    TEST_ASSERT_EQUAL(FFT_OUTPUT_MAGNITUDE, plan.output);
+    // Test signal over 7 decades of amplitude, every output against the sqrtf() magnitude
+    float max_fast = 0, max_power = 0, max_db = 0;
+    for (int8_t decade = 0; decade < 7; decade++){
+        TestSignal(signal, n);
+        for (uint16_t i = 0; i < n; i++){
+            signal[i] *= powf(10, -decade);
+        }
+        FFTPlanSetOutput(&plan, FFT_OUTPUT_MAGNITUDE);
+        FFTPlanMagnitude(&plan, signal, ref);
+        FFTPlanSetOutput(&plan, FFT_OUTPUT_MAGNITUDE_FAST);
+        FFTPlanMagnitude(&plan, signal, fft);
+        for (uint16_t k = 0; k < n / 2; k++){
+            max_fast = fmaxf(max_fast, fabsf(fft[k] - ref[k]) / ref[k]);
+        }
+        FFTPlanSetOutput(&plan, FFT_OUTPUT_POWER);
+        FFTPlanMagnitude(&plan, signal, fft);
+        for (uint16_t k = 0; k < n / 2; k++){
+            max_power = fmaxf(max_power, fabsf(fft[k] - ref[k] * ref[k]) / (ref[k] * ref[k]));
+        }
+        FFTPlanSetOutput(&plan, FFT_OUTPUT_DB);
+        FFTPlanMagnitude(&plan, signal, fft);
+        for (uint16_t k = 0; k < n / 2; k++){
+            max_db = fmaxf(max_db, fabsf(fft[k] - 20 * log10f(ref[k])));
+        }
+    }
+    ESP_LOGI(TAG, "%d points: fast magnitude %.2e relative, power %.2e relative, dB %.2e dB max error", n, max_fast, max_power, max_db);
+    TEST_ASSERT_LESS_THAN(2e-3f, max_fast);
+    TEST_ASSERT_LESS_THAN(1e-6f, max_power);
+    TEST_ASSERT_LESS_THAN(1e-3f, max_db);
+    FFTPlanDestroy(&plan);
+    free(signal);
+    free(ref);
+    free(fft);
+}
+
+// The approximated outputs pay off without FPU, where sqrtf() and log10f() are software routines
+TEST_CASE("FFTPlanSetOutput benchmark", "[fft]")
+{
+    const char * names[] = {"magnitude", "fast magnitude", "power", "dB"};
+    float * signal = malloc(MAX_SIGNAL_LENGHT * sizeof(float));
+    float * fft = malloc(MAX_SIGNAL_LENGHT / 2 * sizeof(float));
+    TEST_ASSERT_NOT_NULL(fft);
+    TEST_ASSERT_TRUE(FFTInit());
+    int repeat_count = 16;
+    for (uint16_t n = 256; n <= MAX_SIGNAL_LENGHT; n *= 2){
+        fft_plan_t plan;
+        TEST_ASSERT_TRUE(FFTPlanCreate(&plan, n, FFT_WINDOW_HANN));
+        TestSignal(signal, n);
+        float cycles[FFT_OUTPUT_DB + 1];
+        for (fft_output_t output = FFT_OUTPUT_MAGNITUDE; output <= FFT_OUTPUT_DB; output++){
+            FFTPlanSetOutput(&plan, output);
+            unsigned int start_b = xthal_get_ccount();
+            for (int i = 0; i < repeat_count; i++){
+                FFTPlanMagnitude(&plan, signal, fft);
+            }
+            unsigned int end_b = xthal_get_ccount();
+            cycles[output] = (float)(end_b - start_b) / repeat_count;
+        }
+        ESP_LOGI(TAG, "%d points: %s %.0f, %s %.0f, %s %.0f, %s %.0f cycles per frame", n, names[0], cycles[0],
+                 names[1], cycles[1], names[2], cycles[2], names[3], cycles[3]);
+        FFTPlanDestroy(&plan);
+    }
+    free(signal);
+    free(fft);
+}
+
+/**
+ * @brief Raw ADC test block: mid-scale offset, two tones scaled by amplitude and a small deterministic noise
+ */
+static void TestSignalADC(uint16_t * raw, float * signal, uint16_t signal_lenght, float amplitude){
+    uint32_t seed = 54321;
+    for (uint16_t i = 0; i < signal_lenght; i++){
+        seed = seed * 1664525 + 1013904223;
+        float x = 2048 + amplitude * sinf(2 * M_PI * 0.0917f * i) + 0.1f * amplitude * sinf(2 * M_PI * 0.2873f * i) +
+                  ((int32_t)(seed >> 28) - 8) / 4.0f;
+        raw[i] = (x < 0) ? 0 : (x > 4095) ? 4095 : (uint16_t)lroundf(x);
+        signal[i] = raw[i];
+    }
+}
+
+TEST_CASE("FFTMagnitudeQ15 accuracy", "[fft]")
+{
+    uint16_t * raw = malloc(MAX_SIGNAL_LENGHT * sizeof(uint16_t));
+    float * signal = malloc(MAX_SIGNAL_LENGHT * sizeof(float));
+    float * ref = malloc(MAX_SIGNAL_LENGHT / 2 * sizeof(float));
+    int16_t * fft = malloc(MAX_SIGNAL_LENGHT / 2 * sizeof(int16_t));
+    uint32_t * power = malloc(MAX_SIGNAL_LENGHT / 2 * sizeof(uint32_t));
+    TEST_ASSERT_NOT_NULL(power);
+    TEST_ASSERT_TRUE(FFTInit());
+    TEST_ASSERT_TRUE(FFTInitQ15());
+    const float amplitudes[] = {1500, 150, 15};
+    for (int a = 0; a < sizeof(amplitudes) / sizeof(float); a++){
+        for (uint16_t n = 16; n <= MAX_SIGNAL_LENGHT; n *= 2){
+            TestSignalADC(raw, signal, n, amplitudes[a]);
+            FFTMagnitude(signal, ref, n);
+            FFTMagnitudeQ15(raw, fft, n);
+            FFTPowerQ15(raw, power, n);
+            // Errors in ADC counts (Q15 of 4096 counts)
+            float max_error = 0;
+            float max_power_error = 0;
+            for (uint16_t k = 0; k < n / 2; k++){
+                // Bins beyond the Q15 range (DC leaked to bin 1 by the window) saturate by design
+                if (ref[k] < 4095){
+                    max_error = fmaxf(max_error, fabsf(fft[k] / 8.0f - ref[k]));
+                    max_power_error = fmaxf(max_power_error, fabsf(sqrtf(power[k] / 64.0f) - ref[k]));
+                }
+            }
+            ESP_LOGI(TAG, "amplitude %4.0f, %4d points: max error %.3f counts (magnitude), %.3f counts (power)",
+                     amplitudes[a], n, max_error, max_power_error);
+            TEST_ASSERT_LESS_THAN(1.25f, max_error);
+            TEST_ASSERT_LESS_THAN(1.25f, max_power_error);
+        }
+    }
+    free(raw);
+    free(signal);
+    free(ref);
+    free(fft);
+    free(power);
+}
+
+// Only meaningful on targets without FPU: with hardware float the float path is the faster one
+TEST_CASE("FFTMagnitudeQ15 benchmark", "[fft]")
+{
+    uint16_t * raw = malloc(MAX_SIGNAL_LENGHT * sizeof(uint16_t));
+    float * signal = malloc(MAX_SIGNAL_LENGHT * sizeof(float));
+    float * ref = malloc(MAX_SIGNAL_LENGHT / 2 * sizeof(float));
+    int16_t * fft = malloc(MAX_SIGNAL_LENGHT / 2 * sizeof(int16_t));
+    TEST_ASSERT_NOT_NULL(fft);
+    TEST_ASSERT_TRUE(FFTInit());
+    TEST_ASSERT_TRUE(FFTInitQ15());
+    int repeat_count = 16;
+    for (uint16_t n = 256; n <= MAX_SIGNAL_LENGHT; n *= 2){
+        TestSignalADC(raw, signal, n, 1000);
+        FFTMagnitude(signal, ref, n);
+        unsigned int start_b = xthal_get_ccount();
+        for (int i = 0; i < repeat_count; i++){
+            // Conversion of the raw block included, as done by the float users
+            for (uint16_t j = 0; j < n; j++){
+                signal[j] = raw[j];
+            }
+            FFTMagnitude(signal, ref, n);
+        }
+        unsigned int end_b = xthal_get_ccount();
+        float cycles_float = (float)(end_b - start_b) / repeat_count;
+        start_b = xthal_get_ccount();
+        for (int i = 0; i < repeat_count; i++){
+            FFTMagnitudeQ15(raw, fft, n);
+        }
+        end_b = xthal_get_ccount();
+        float cycles_q15 = (float)(end_b - start_b) / repeat_count;
+        ESP_LOGI(TAG, "%d points: FFTMagnitude %.0f cycles per frame, FFTMagnitudeQ15 %.0f cycles per frame",
+                 n, cycles_float, cycles_q15);
+    }
+    free(raw);
+    free(signal);
+    free(ref);
+    free(fft);
+}
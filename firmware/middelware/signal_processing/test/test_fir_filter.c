@@ -0,0 +1,177 @@
+/**
+ * @file test_fir_filter.c
+ * @author Albano Peñalva (albano.penalva@uner.edu.ar)
+ * @brief Unity tests and benchmarks of the FIR filter module
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2023
+ *
+ */
+
+/*==================[inclusions]=============================================*/
+#include <string.h>
+#include <stdlib.h>
+#include <math.h>
+#include "unity.h"
+#include "dsp_platform.h"
+#include "esp_log.h"
+#include "fir_filter.h"
+/*==================[macros and definitions]=================================*/
+#define N_BLOCKS        4
+#define MAX_TAPS        512
+static const char *TAG = "fir_filter";
+/*==================[internal functions definition]==========================*/
+/**
+ * @brief Deterministic noise in -1..1
+ */
+static void TestSignal(float * signal, uint32_t signal_lenght, uint32_t seed){
+    for (uint32_t i = 0; i < signal_lenght; i++){
+        seed = seed * 1664525 + 1013904223;
+        signal[i] = ((int32_t)(seed >> 16) - 32768) / 32768.0f;
+    }
+}
+
+/**
+ * @brief Windowed sinc low pass taps with a non symmetric tail, so a reversed filter is caught
+ */
+static void TestTaps(float * coeff, uint16_t n_taps){
+    for (uint16_t i = 0; i < n_taps; i++){
+        float m = i - (n_taps - 1) / 2.0f;
+        float sinc = (m == 0) ? 0.4f : sinf(0.4f * M_PI * m) / (M_PI * m);
+        coeff[i] = sinc * (0.54f - 0.46f * cosf(2 * M_PI * i / n_taps)) + 0.01f * i / n_taps;
+    }
+}
+
+/**
+ * @brief Direct form convolution in double, zero initial state
+ */
+static void FIRFilterRef(float * coeff, uint16_t n_taps, float * input_signal, float * output_signal, uint32_t signal_lenght){
+    for (uint32_t i = 0; i < signal_lenght; i++){
+        double sum = 0;
+        for (uint16_t k = 0; (k < n_taps) && (k <= i); k++){
+            sum += (double)coeff[k] * input_signal[i - k];
+        }
+        output_signal[i] = sum;
+    }
+}
+
+TEST_CASE("FIRFilterApply functionality", "[fir_filter]")
+{
+    const uint16_t taps[] = {1, 7, 64, 129, 255};
+    const uint16_t blocks[] = {32, 256};
+    float * coeff = malloc(MAX_TAPS * sizeof(float));
+    float * x = malloc(N_BLOCKS * MAX_SIGNAL_LENGHT * sizeof(float));
+    float * ref = malloc(N_BLOCKS * MAX_SIGNAL_LENGHT * sizeof(float));
+    float * y = malloc(N_BLOCKS * MAX_SIGNAL_LENGHT * sizeof(float));
+    TEST_ASSERT_NOT_NULL(y);
+    TEST_ASSERT_TRUE(FFTInit());
+    for (uint8_t t = 0; t < sizeof(taps) / sizeof(uint16_t); t++){
+        uint16_t n_taps = taps[t];
+        TestTaps(coeff, n_taps);
+        for (uint8_t b = 0; b < sizeof(blocks) / sizeof(uint16_t); b++){
+            uint16_t l = blocks[b];
+            uint32_t lenght = N_BLOCKS * l;
+            TestSignal(x, lenght, n_taps);
+            FIRFilterRef(coeff, n_taps, x, ref, lenght);
+            for (fir_method_t method = FIR_DIRECT; method <= FIR_FFT; method++){
+                fir_filter_t filter;
+                TEST_ASSERT_TRUE(FIRFilterInit(&filter, coeff, n_taps, l, method));
+                TEST_ASSERT_EQUAL(method, filter.method);
+                // One block per call: the state carries the history between calls
+                for (uint32_t start = 0; start < lenght; start += l){
+                    FIRFilterApply(&filter, &x[start], &y[start], l);
+                }
+                float max_error = 0;
+                for (uint32_t i = 0; i < lenght; i++){
+                    max_error = fmaxf(max_error, fabsf(y[i] - ref[i]));
+                }
+                ESP_LOGI(TAG, "%s, %d taps, blocks of %d: max error %g", (method == FIR_FFT) ? "overlap-save" : "direct form",
+                         n_taps, l, max_error);
+                TEST_ASSERT_LESS_THAN(1e-5f, max_error);
+                // In place, several blocks per call, after a reset: same output
+                FIRFilterReset(&filter);
+                memcpy(y, x, lenght * sizeof(float));
+                FIRFilterApply(&filter, y, y, 2 * l);
+                FIRFilterApply(&filter, &y[2 * l], &y[2 * l], lenght - 2 * l);
+                max_error = 0;
+                for (uint32_t i = 0; i < lenght; i++){
+                    max_error = fmaxf(max_error, fabsf(y[i] - ref[i]));
+                }
+                TEST_ASSERT_LESS_THAN(1e-5f, max_error);
+                FIRFilterDeinit(&filter);
+            }
+        }
+    }
+    // Overlap-save needs block_lenght + n_taps - 1 <= MAX_SIGNAL_LENGHT
+    fir_filter_t filter;
+    TEST_ASSERT_FALSE(FIRFilterInit(&filter, coeff, 2, MAX_SIGNAL_LENGHT, FIR_FFT));
+    TEST_ASSERT_TRUE(FIRFilterInit(&filter, coeff, 2, MAX_SIGNAL_LENGHT, FIR_AUTO));
+    TEST_ASSERT_EQUAL(FIR_DIRECT, filter.method);
+    FIRFilterDeinit(&filter);
+    free(coeff);
+    free(x);
+    free(ref);
+    free(y);
+}
+
+TEST_CASE("FIRFilterApply benchmark", "[fir_filter]")
+{
+    const uint16_t l = 256;
+    float * coeff = malloc(MAX_TAPS * sizeof(float));
+    float * x = malloc(l * sizeof(float));
+    float * y = malloc(l * sizeof(float));
+    TEST_ASSERT_NOT_NULL(y);
+    TEST_ASSERT_TRUE(FFTInit());
+    TestSignal(x, l, 1);
+    int repeat_count = 32;
+    uint16_t crossover = 0, crossover_auto = 0;
+    for (uint16_t n_taps = 8; n_taps <= MAX_TAPS; n_taps *= 2){
+        TestTaps(coeff, n_taps);
+        float cycles[FIR_FFT + 1] = {0};
+        for (fir_method_t method = FIR_DIRECT; method <= FIR_FFT; method++){
+            fir_filter_t filter;
+            if (!FIRFilterInit(&filter, coeff, n_taps, l, method)){
+                continue;
+            }
+            unsigned int start_b = xthal_get_ccount();
+            for (int i = 0; i < repeat_count; i++){
+                FIRFilterApply(&filter, x, y, l);
+            }
+            unsigned int end_b = xthal_get_ccount();
+            cycles[method] = (float)(end_b - start_b) / (repeat_count * l);
+            FIRFilterDeinit(&filter);
+        }
+        fir_filter_t filter;
+        TEST_ASSERT_TRUE(FIRFilterInit(&filter, coeff, n_taps, l, FIR_AUTO));
+        fir_method_t method_auto = filter.method;
+        FIRFilterDeinit(&filter);
+        if (cycles[FIR_FFT] == 0){
+            ESP_LOGI(TAG, "%d taps, blocks of %d: direct form %.1f cycles per sample, overlap-save does not fit", n_taps, l, cycles[FIR_DIRECT]);
+            continue;
+        }
+        // Butterfly cost in direct form taps that makes FIRFFTCost() match the measure
+        uint16_t n = 4;
+        while (n < l + n_taps - 1){
+            n <<= 1;
+        }
+        uint8_t stages = 0;
+        while ((2 << stages) < n){
+            stages++;
+        }
+        float butterfly_cost = (cycles[FIR_FFT] / cycles[FIR_DIRECT] * n_taps * l - 4.0f * n) / (2 * (n / 4) * stages);
+        ESP_LOGI(TAG, "%d taps, blocks of %d: direct form %.1f, overlap-save %.1f cycles per sample (FIR_AUTO: %s, "
+                 "measured FIR_FFT_BUTTERFLY_COST %.1f)", n_taps, l, cycles[FIR_DIRECT], cycles[FIR_FFT],
+                 (method_auto == FIR_FFT) ? "overlap-save" : "direct form", butterfly_cost);
+        if ((crossover == 0) && (cycles[FIR_FFT] < cycles[FIR_DIRECT])){
+            crossover = n_taps;
+        }
+        if ((crossover_auto == 0) && (method_auto == FIR_FFT)){
+            crossover_auto = n_taps;
+        }
+    }
+    ESP_LOGI(TAG, "blocks of %d: overlap-save faster from %d taps, FIR_AUTO switches at %d taps", l, crossover, crossover_auto);
+    free(coeff);
+    free(x);
+    free(y);
+}
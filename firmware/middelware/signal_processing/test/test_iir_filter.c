@@ -0,0 +1,133 @@
+/**
+ * @file test_iir_filter.c
+ * @author Albano Peñalva (albano.penalva@uner.edu.ar)
+ * @brief Unity tests and benchmarks of the IIR filter module
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2023
+ *
+ */
+
+/*==================[inclusions]=============================================*/
+#include <string.h>
+#include <stdlib.h>
+#include <math.h>
+#include "unity.h"
+#include "dsp_platform.h"
+#include "esp_log.h"
+#include "esp_dsp.h"
+#include "iir_filter.h"
+/*==================[macros and definitions]=================================*/
+#define SIGNAL_LENGHT   256
+#define SAMPLE_FREC     1000
+#define CUT_FREC        50
+static const char *TAG = "iir_filter";
+/*==================[internal functions definition]==========================*/
+/**
+ * @brief IIRFilterApplyInterleaved() before the multi-channel cascade: the buffer is streamed once per section
+ */
+static void IIRFilterApplyInterleavedRef(iir_filter_t * filter, float * input_signal, float * output_signal, int16_t signal_lenght){
+    uint8_t n_ch = filter->n_channels;
+    float * in = input_signal;
+    for (uint8_t i = 0; i < filter->n_sos; i++){
+        float b0 = filter->coeff[i * 5 + 0];
+        float b1 = filter->coeff[i * 5 + 1];
+        float b2 = filter->coeff[i * 5 + 2];
+        float a1 = filter->coeff[i * 5 + 3];
+        float a2 = filter->coeff[i * 5 + 4];
+        for (uint8_t ch = 0; ch < n_ch; ch++){
+            float * w = &filter->delay[(ch * filter->n_sos + i) * 2];
+            float w0 = w[0], w1 = w[1];
+            for (int32_t j = ch; j < (int32_t)signal_lenght * n_ch; j += n_ch){
+                float d0 = in[j] - a1 * w0 - a2 * w1;
+                output_signal[j] = b0 * d0 + b1 * w0 + b2 * w1;
+                w1 = w0;
+                w0 = d0;
+            }
+            w[0] = w0;
+            w[1] = w1;
+        }
+        in = output_signal;
+    }
+}
+
+/**
+ * @brief Interleaved test block: a different tone and offset on each channel
+ */
+static void TestSignal(float * signal, uint8_t n_channels, uint16_t block){
+    for (uint16_t i = 0; i < SIGNAL_LENGHT; i++){
+        uint32_t n = block * SIGNAL_LENGHT + i;
+        for (uint8_t ch = 0; ch < n_channels; ch++){
+            signal[i * n_channels + ch] = ch + sinf(2 * M_PI * (10 + 15 * ch) * n / SAMPLE_FREC) +
+                                          0.5f * sinf(2 * M_PI * 220 * n / SAMPLE_FREC);
+        }
+    }
+}
+
+TEST_CASE("IIRFilterApplyInterleaved functionality", "[iir_filter]")
+{
+    float * x = malloc(SIGNAL_LENGHT * IIR_MAX_CHANNELS * sizeof(float));
+    float * y = malloc(SIGNAL_LENGHT * IIR_MAX_CHANNELS * sizeof(float));
+    float * z = malloc(SIGNAL_LENGHT * sizeof(float));
+    TEST_ASSERT_NOT_NULL(z);
+    iir_filter_t interleaved, single;
+    for (uint8_t n_ch = 1; n_ch <= IIR_MAX_CHANNELS; n_ch++){
+        for (uint8_t order = 2; order <= 8; order += 2){
+            TEST_ASSERT_TRUE(IIRFilterInit(&interleaved, LOW_PASS, SAMPLE_FREC, CUT_FREC, order, n_ch));
+            TEST_ASSERT_TRUE(IIRFilterInit(&single, LOW_PASS, SAMPLE_FREC, CUT_FREC, order, n_ch));
+            // Two blocks, in place, to check each channel keeps its own state between calls
+            for (uint16_t block = 0; block < 2; block++){
+                TestSignal(x, n_ch, block);
+                memcpy(y, x, SIGNAL_LENGHT * n_ch * sizeof(float));
+                IIRFilterApplyInterleaved(&interleaved, y, y, SIGNAL_LENGHT);
+                for (uint8_t ch = 0; ch < n_ch; ch++){
+                    for (uint16_t i = 0; i < SIGNAL_LENGHT; i++){
+                        z[i] = x[i * n_ch + ch];
+                    }
+                    IIRFilterApply(&single, ch, z, z, SIGNAL_LENGHT);
+                    for (uint16_t i = 0; i < SIGNAL_LENGHT; i++){
+                        TEST_ASSERT_EQUAL_FLOAT(z[i], y[i * n_ch + ch]);
+                    }
+                }
+            }
+            IIRFilterDeinit(&interleaved);
+            IIRFilterDeinit(&single);
+        }
+    }
+    free(x);
+    free(y);
+    free(z);
+}
+
+TEST_CASE("IIRFilterApplyInterleaved benchmark", "[iir_filter]")
+{
+    float * x = malloc(SIGNAL_LENGHT * IIR_MAX_CHANNELS * sizeof(float));
+    float * y = malloc(SIGNAL_LENGHT * IIR_MAX_CHANNELS * sizeof(float));
+    TEST_ASSERT_NOT_NULL(y);
+    iir_filter_t filter;
+    int repeat_count = 16;
+    for (uint8_t n_ch = 1; n_ch <= IIR_MAX_CHANNELS; n_ch++){
+        TestSignal(x, n_ch, 0);
+        for (uint8_t order = 2; order <= 8; order += 2){
+            TEST_ASSERT_TRUE(IIRFilterInit(&filter, LOW_PASS, SAMPLE_FREC, CUT_FREC, order, n_ch));
+            unsigned int start_b = xthal_get_ccount();
+            for (int i = 0; i < repeat_count; i++){
+                IIRFilterApplyInterleavedRef(&filter, x, y, SIGNAL_LENGHT);
+            }
+            unsigned int end_b = xthal_get_ccount();
+            float cycles_ref = (float)(end_b - start_b) / (repeat_count * SIGNAL_LENGHT * n_ch);
+            start_b = xthal_get_ccount();
+            for (int i = 0; i < repeat_count; i++){
+                IIRFilterApplyInterleaved(&filter, x, y, SIGNAL_LENGHT);
+            }
+            end_b = xthal_get_ccount();
+            float cycles = (float)(end_b - start_b) / (repeat_count * SIGNAL_LENGHT * n_ch);
+            ESP_LOGI(TAG, "%d channels, order %d: pass per section %.1f cycles per sample, multi-channel single pass %.1f cycles per sample",
+                     n_ch, order, cycles_ref, cycles);
+            IIRFilterDeinit(&filter);
+        }
+    }
+    free(x);
+    free(y);
+}
@@ -0,0 +1,114 @@
+/**
+ * @file test_qrs_detector.c
+ * @author Albano Peñalva (albano.penalva@uner.edu.ar)
+ * @brief Unity tests and benchmarks of the QRS detector module
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2023
+ *
+ */
+
+/*==================[inclusions]=============================================*/
+#include <string.h>
+#include <stdlib.h>
+#include <math.h>
+#include "unity.h"
+#include "dsp_platform.h"
+#include "esp_log.h"
+#include "qrs_detector.h"
+/*==================[macros and definitions]=================================*/
+#define ECG_LENGHT      231         /* One beat */
+#define ECG_FREC        250         /* ecg[] sample frequency */
+#define ECG_R_PEAK      132         /* R wave index in ecg[] */
+#define ECG_GAIN        8           /* 8 bit DAC values to 12 bit ADC scale */
+#define REPLAY_TIME     60          /* Replay lenght (s) */
+#define BLOCK_LENGHT    25
+#define MAX_BEATS       8
+#define R_TOLERANCE     2           /* Beat position error (samples) */
+#define END_TIME        300         /* Time from the R wave to the end of the integration peak (ms) */
+static const char *TAG = "qrs_detector";
+static const uint16_t sample_frecs[] = {100, 200, 250, 360, 500};
+
+/* ecg[] table of projects/guia2_ej4 */
+static const uint8_t ecg[ECG_LENGHT] = {
+    76, 77, 78, 77, 79, 86, 81, 76, 84, 93, 85, 80, 89, 95, 89, 85,
+    93, 98, 94, 88, 98, 105, 96, 91, 99, 105, 101, 96, 102, 106, 101, 96,
+    100, 107, 101, 94, 100, 104, 100, 91, 99, 103, 98, 91, 96, 105, 95, 88,
+    95, 100, 94, 85, 93, 99, 92, 84, 91, 96, 87, 80, 83, 92, 86, 78,
+    84, 89, 79, 73, 81, 83, 78, 70, 80, 82, 79, 69, 80, 82, 81, 70,
+    75, 81, 77, 74, 79, 83, 82, 72, 80, 87, 79, 76, 85, 95, 87, 81,
+    88, 93, 88, 84, 87, 94, 86, 82, 85, 94, 85, 82, 85, 95, 86, 83,
+    92, 99, 91, 88, 94, 98, 95, 90, 97, 105, 104, 94, 98, 114, 117, 124,
+    144, 180, 210, 236, 253, 227, 171, 99, 49, 34, 29, 43, 69, 89, 89, 90,
+    98, 107, 104, 98, 104, 110, 102, 98, 103, 111, 101, 94, 103, 108, 102, 95,
+    97, 106, 100, 92, 101, 103, 100, 94, 98, 103, 96, 90, 98, 103, 97, 90,
+    99, 104, 95, 90, 99, 104, 100, 93, 100, 106, 101, 93, 101, 105, 103, 96,
+    105, 112, 105, 99, 103, 108, 99, 96, 102, 106, 99, 90, 92, 100, 87, 80,
+    82, 88, 77, 69, 75, 79, 74, 67, 71, 78, 72, 67, 73, 81, 77, 71,
+    75, 84, 79, 77, 77, 76, 76,
+};
+/*==================[internal functions definition]==========================*/
+/**
+ * @brief Sample n of the periodic ecg[] signal at sample_frec (linear interpolation)
+ */
+static int16_t ECGSample(uint32_t n, uint16_t sample_frec){
+    uint32_t pos = (uint64_t)n * ECG_FREC * 256 / sample_frec;
+    uint16_t i = (pos >> 8) % ECG_LENGHT;
+    uint16_t frac = pos & 0xFF;
+    int32_t x = ecg[i] * (256 - frac) + ecg[(i + 1) % ECG_LENGHT] * frac;
+    return (x * ECG_GAIN) >> 8;
+}
+
+TEST_CASE("QRSDetectorProcess ecg[] replay", "[qrs_detector]")
+{
+    int16_t block[BLOCK_LENGHT];
+    qrs_beat_t beats[MAX_BEATS];
+    for (uint8_t f = 0; f < sizeof(sample_frecs) / sizeof(uint16_t); f++){
+        uint16_t sample_frec = sample_frecs[f];
+        uint32_t n_samples = REPLAY_TIME * sample_frec;
+        float period = (float)ECG_LENGHT * sample_frec / ECG_FREC;
+        qrs_detector_t detector;
+        TEST_ASSERT_TRUE(QRSDetectorInit(&detector, sample_frec));
+        uint16_t found = 0, false_beats = 0;
+        float max_error = 0;
+        uint32_t cycles = 0;
+        for (uint32_t start = 0; start < n_samples; start += BLOCK_LENGHT){
+            for (uint16_t i = 0; i < BLOCK_LENGHT; i++){
+                block[i] = ECGSample(start + i, sample_frec);
+            }
+            unsigned int start_b = xthal_get_ccount();
+            uint8_t n_beats = QRSDetectorProcess(&detector, block, BLOCK_LENGHT, beats, MAX_BEATS);
+            unsigned int end_b = xthal_get_ccount();
+            cycles += end_b - start_b;
+            for (uint8_t b = 0; b < n_beats; b++){
+                // Nearest R wave of the replayed signal
+                float r = (float)ECG_R_PEAK * sample_frec / ECG_FREC;
+                float error = beats[b].sample - r - period * roundf((beats[b].sample - r) / period);
+                if (fabsf(error) > R_TOLERANCE){
+                    false_beats++;
+                    continue;
+                }
+                found++;
+                max_error = fmaxf(max_error, fabsf(error));
+                if (found > 1){
+                    TEST_ASSERT_INT_WITHIN(2, lroundf(60 * ECG_FREC / (float)ECG_LENGHT), beats[b].heart_rate);
+                }
+            }
+        }
+        // Beats after the learning phase: R waves from QRS_LEARNING_TIME to the end of the replay, the
+        // last one needs END_TIME to complete its integration peak
+        uint16_t expected = 0;
+        for (float r = (float)ECG_R_PEAK * sample_frec / ECG_FREC; r < n_samples - END_TIME * sample_frec / 1000; r += period){
+            if (r >= (float)QRS_LEARNING_TIME * sample_frec / 1000){
+                expected++;
+            }
+        }
+        ESP_LOGI(TAG, "%d Hz: %d of %d beats, %d false, max R error %.1f samples, %.1f cycles per sample",
+                 sample_frec, found, expected, false_beats, max_error, (float)cycles / n_samples);
+        TEST_ASSERT_EQUAL(63, expected);
+        TEST_ASSERT_EQUAL(expected, found);
+        TEST_ASSERT_EQUAL(0, false_beats);
+        QRSDetectorDeinit(&detector);
+    }
+}
@@ -0,0 +1,136 @@
+/**
+ * @file test_resampler.c
+ * @author Albano Peñalva (albano.penalva@uner.edu.ar)
+ * @brief Unity tests of the resampler module
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2023
+ *
+ */
+
+/*==================[inclusions]=============================================*/
+#include <string.h>
+#include <stdlib.h>
+#include <math.h>
+#include "unity.h"
+#include "dsp_platform.h"
+#include "esp_log.h"
+#include "resampler.h"
+/*==================[macros and definitions]=================================*/
+#define OUT_FREC        1000        /* Output sample frequency */
+#define PASS_FREC       400         /* Highest frequency kept */
+#define OUT_BLOCK       256         /* Output samples per block */
+#define N_BLOCKS        3           /* Blocks per tone, the first one is the filters transient */
+#define TONE_STEP       37          /* Sweep step (Hz), not a divisor of the sample frequencies */
+static const char *TAG = "resampler";
+static const uint8_t decimations[] = {2, 4, 10, 12, 45};
+/*==================[internal functions definition]==========================*/
+/**
+ * @brief Tone of the given amplitude, block b of a continuous signal
+ */
+static void TestTone(float * signal, uint16_t signal_lenght, float sample_frec, float frec, float amplitude, uint8_t block){
+    for (uint16_t i = 0; i < signal_lenght; i++){
+        // Phase wrapped in double: a float argument this large adds phase noise well above the aliases
+        signal[i] = amplitude * sin(2 * M_PI * fmod((double)frec * ((uint32_t)block * signal_lenght + i), sample_frec) / sample_frec);
+    }
+}
+
+/**
+ * @brief Frequency a tone lands on after sampling at OUT_FREC
+ */
+static float AliasFrec(float frec){
+    return fabsf(frec - OUT_FREC * roundf(frec / OUT_FREC));
+}
+
+/**
+ * @brief Output amplitude (peak of a sinusoid of the same RMS value) relative to the input amplitude, in dB
+ */
+static float GainDB(float * output, uint16_t output_lenght, float amplitude){
+    float sum = 0;
+    for (uint16_t i = 0; i < output_lenght; i++){
+        sum += output[i] * output[i];
+    }
+    return 20 * log10f(sqrtf(2 * sum / output_lenght) / amplitude + 1e-9f);
+}
+
+TEST_CASE("DecimatorProcess aliasing", "[resampler]")
+{
+    const float amplitude = 1.0f;
+    for (uint8_t d = 0; d < sizeof(decimations); d++){
+        uint8_t decimation = decimations[d];
+        float sample_frec = OUT_FREC * decimation;
+        uint16_t n = OUT_BLOCK * decimation;
+        float * signal = malloc(n * sizeof(float));
+        TEST_ASSERT_NOT_NULL(signal);
+        decimator_t decimator;
+        TEST_ASSERT_TRUE(DecimatorInit(&decimator, sample_frec, decimation, PASS_FREC));
+        // Passband tone is kept
+        for (uint8_t b = 0; b < N_BLOCKS; b++){
+            TestTone(signal, n, sample_frec, 100, amplitude, b);
+            TEST_ASSERT_EQUAL(OUT_BLOCK, DecimatorProcess(&decimator, signal, signal, n));
+        }
+        TEST_ASSERT_FLOAT_WITHIN(0.1f, 0, GainDB(signal, OUT_BLOCK, amplitude));
+        // Every tone that aliases onto 0..PASS_FREC is rejected (the rest lands on the transition band)
+        float worst = -200, worst_frec = 0;
+        for (float frec = OUT_FREC - PASS_FREC; frec < sample_frec / 2; frec += TONE_STEP){
+            if (AliasFrec(frec) > PASS_FREC){
+                continue;
+            }
+            for (uint8_t b = 0; b < N_BLOCKS; b++){
+                TestTone(signal, n, sample_frec, frec, amplitude, b);
+                DecimatorProcess(&decimator, signal, signal, n);
+            }
+            float gain = GainDB(signal, OUT_BLOCK, amplitude);
+            if (gain > worst){
+                worst = gain;
+                worst_frec = frec;
+            }
+        }
+        ESP_LOGI(TAG, "decimation %d (%d stages): worst alias %.1f dB (%.0f Hz)", decimation, decimator.n_stages, worst, worst_frec);
+        TEST_ASSERT_LESS_THAN(-RESAMPLER_ATTENUATION, worst);
+        DecimatorDeinit(&decimator);
+        free(signal);
+    }
+}
+
+TEST_CASE("DecimatorProcessQ15 aliasing", "[resampler]")
+{
+    const float amplitude = 0.9f;
+    for (uint8_t d = 0; d < sizeof(decimations); d++){
+        uint8_t decimation = decimations[d];
+        float sample_frec = OUT_FREC * decimation;
+        uint16_t n = OUT_BLOCK * decimation;
+        float * signal = malloc(n * sizeof(float));
+        int16_t * signal_q15 = malloc(n * sizeof(int16_t));
+        TEST_ASSERT_NOT_NULL(signal_q15);
+        decimator_q15_t decimator;
+        TEST_ASSERT_TRUE(DecimatorInitQ15(&decimator, sample_frec, decimation, PASS_FREC));
+        float worst = -200, worst_frec = 0;
+        for (float frec = OUT_FREC - PASS_FREC; frec < sample_frec / 2; frec += TONE_STEP){
+            if (AliasFrec(frec) > PASS_FREC){
+                continue;
+            }
+            for (uint8_t b = 0; b < N_BLOCKS; b++){
+                TestTone(signal, n, sample_frec, frec, amplitude, b);
+                for (uint16_t i = 0; i < n; i++){
+                    signal_q15[i] = lroundf(signal[i] * INT16_MAX);
+                }
+                TEST_ASSERT_EQUAL(OUT_BLOCK, DecimatorProcessQ15(&decimator, signal_q15, signal_q15, n));
+            }
+            for (uint16_t i = 0; i < OUT_BLOCK; i++){
+                signal[i] = signal_q15[i] / (float)INT16_MAX;
+            }
+            float gain = GainDB(signal, OUT_BLOCK, amplitude);
+            if (gain > worst){
+                worst = gain;
+                worst_frec = frec;
+            }
+        }
+        ESP_LOGI(TAG, "decimation %d (%d stages), Q15: worst alias %.1f dB (%.0f Hz)", decimation, decimator.n_stages, worst, worst_frec);
+        TEST_ASSERT_LESS_THAN(-RESAMPLER_ATTENUATION, worst);
+        DecimatorDeinitQ15(&decimator);
+        free(signal);
+        free(signal_q15);
+    }
+}
@@ -0,0 +1,139 @@
+/**
+ * @file test_signal_quality.c
+ * @author Albano Peñalva (albano.penalva@uner.edu.ar)
+ * @brief Unity tests of the signal quality module
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2023
+ *
+ */
+
+/*==================[inclusions]=============================================*/
+#include <string.h>
+#include <stdlib.h>
+#include <math.h>
+#include "unity.h"
+#include "dsp_platform.h"
+#include "esp_log.h"
+#include "esp_dsp.h"
+#include "fft.h"
+#include "signal_quality.h"
+/*==================[macros and definitions]=================================*/
+#define SIGNAL_LENGHT   1024
+#define SAMPLE_FREC     1000
+#define FRAMES          16
+#define N_HARMONICS     5
+static const char *TAG = "signal_quality";
+
+typedef struct {
+    float frec;                 /* Fundamental, in cycles per sample (dsps_tone_gen_f32() steps 2 pi freq) */
+    float h2;                   /* 2nd harmonic amplitude (fundamental amplitude is 1) */
+    float h3;                   /* 3rd harmonic amplitude */
+    float sigma;                /* Noise rms */
+} test_signal_t;
+/*==================[internal functions definition]==========================*/
+/**
+ * @brief Average FRAMES frames of a tone with harmonics and uniform noise
+ *
+ * @param sfdr_ref  dsps_sfdr_f32() of the same frames (average)
+ */
+static void Measure(const test_signal_t * t, fft_window_t window, uint8_t lobe, signal_quality_t * quality, float * sfdr_ref){
+    float * signal = malloc(SIGNAL_LENGHT * sizeof(float));
+    float * tone = malloc(SIGNAL_LENGHT * sizeof(float));
+    float * fft = malloc(SIGNAL_LENGHT / 2 * sizeof(float));
+    TEST_ASSERT_NOT_NULL(fft);
+    signal_quality_monitor_t monitor;
+    TEST_ASSERT_TRUE(SignalQualityInit(&monitor, SAMPLE_FREC, SIGNAL_LENGHT, lobe, N_HARMONICS, FRAMES));
+    fft_plan_t plan;
+    TEST_ASSERT_TRUE(FFTPlanCreate(&plan, SIGNAL_LENGHT, window));
+    uint32_t seed = 1;
+    *sfdr_ref = 0;
+    for (uint8_t f = 0; f < FRAMES; f++){
+        float phase = 37.0f * f;
+        dsps_tone_gen_f32(signal, SIGNAL_LENGHT, 1.0f, t->frec, phase);
+        dsps_tone_gen_f32(tone, SIGNAL_LENGHT, t->h2, 2 * t->frec, 2 * phase);
+        dsps_add_f32(signal, tone, signal, SIGNAL_LENGHT, 1, 1, 1);
+        dsps_tone_gen_f32(tone, SIGNAL_LENGHT, t->h3, 3 * t->frec, 3 * phase);
+        dsps_add_f32(signal, tone, signal, SIGNAL_LENGHT, 1, 1, 1);
+        for (uint16_t i = 0; i < SIGNAL_LENGHT; i++){
+            seed = seed * 1664525 + 1013904223;
+            signal[i] += t->sigma * sqrtf(3) * (((int32_t)(seed >> 8) - 8388608) / 8388608.0f);
+        }
+        *sfdr_ref += dsps_sfdr_f32(signal, SIGNAL_LENGHT, 0) / FRAMES;
+        FFTPlanMagnitude(&plan, signal, fft);
+        SignalQualityUpdate(&monitor, fft);
+    }
+    SignalQualityGet(&monitor, quality);
+    FFTPlanDestroy(&plan);
+    free(signal);
+    free(tone);
+    free(fft);
+}
+
+TEST_CASE("SignalQuality SNR and frequency", "[signal_quality]")
+{
+    // Tone between bins, SNR = 10 log10(0.5 / sigma^2): 17.0, 37.0 and 57.0 dB. The Hann leakage
+    // outside +-SIGNAL_QUALITY_LOBE_HANN bins limits the last one.
+    const test_signal_t signals[] = {{0.1013f, 0, 0, 0.1f}, {0.1013f, 0, 0, 0.01f}, {0.1013f, 0, 0, 0.001f}};
+    const float snr[] = {17.2f, 37.1f, 54.5f};
+    TEST_ASSERT_TRUE(FFTInit());
+    for (uint8_t s = 0; s < sizeof(snr) / sizeof(float); s++){
+        signal_quality_t quality;
+        float sfdr_ref;
+        Measure(&signals[s], FFT_WINDOW_HANN, SIGNAL_QUALITY_LOBE_HANN, &quality, &sfdr_ref);
+        ESP_LOGI(TAG, "Hann, noise %g: SNR %.2f dB (expected %.2f), frequency %.3f Hz (expected %.3f), noise floor %.3g",
+                 signals[s].sigma, quality.snr, 10 * log10f(0.5f / (signals[s].sigma * signals[s].sigma)),
+                 quality.frequency, signals[s].frec * SAMPLE_FREC, quality.noise_floor);
+        TEST_ASSERT_FLOAT_WITHIN(0.5f, snr[s], quality.snr);
+        TEST_ASSERT_FLOAT_WITHIN(0.05f, signals[s].frec * SAMPLE_FREC, quality.frequency);
+    }
+    // Lower side lobe windows: the estimate follows the noise at every level
+    const fft_window_t windows[] = {FFT_WINDOW_BLACKMAN_HARRIS, FFT_WINDOW_NUTTALL, FFT_WINDOW_FLAT_TOP};
+    const uint8_t lobes[] = {4, 4, 6};
+    for (uint8_t w = 0; w < sizeof(lobes); w++){
+        for (uint8_t s = 0; s < sizeof(snr) / sizeof(float); s++){
+            signal_quality_t quality;
+            float sfdr_ref;
+            float expected = 10 * log10f(0.5f / (signals[s].sigma * signals[s].sigma));
+            Measure(&signals[s], windows[w], lobes[w], &quality, &sfdr_ref);
+            ESP_LOGI(TAG, "window %d, lobe %d, noise %g: SNR %.2f dB (expected %.2f)", windows[w], lobes[w],
+                     signals[s].sigma, quality.snr, expected);
+            TEST_ASSERT_FLOAT_WITHIN(0.3f, expected, quality.snr);
+        }
+    }
+    // Frequency of a tone anywhere between two bins (the flat top main lobe interpolates worse)
+    const fft_window_t sweep_windows[] = {FFT_WINDOW_HANN, FFT_WINDOW_BLACKMAN_HARRIS, FFT_WINDOW_NUTTALL, FFT_WINDOW_FLAT_TOP};
+    const uint8_t sweep_lobes[] = {SIGNAL_QUALITY_LOBE_HANN, 4, 4, 6};
+    const float sweep_error[] = {0.05f, 0.05f, 0.05f, 0.15f};
+    for (uint8_t w = 0; w < sizeof(sweep_lobes); w++){
+        float max_error = 0;
+        for (uint8_t i = 0; i <= 8; i++){
+            test_signal_t t = {(100 + i / 8.0f) / SIGNAL_LENGHT, 0, 0, 0.01f};
+            signal_quality_t quality;
+            float sfdr_ref;
+            Measure(&t, sweep_windows[w], sweep_lobes[w], &quality, &sfdr_ref);
+            max_error = fmaxf(max_error, fabsf(quality.frequency - t.frec * SAMPLE_FREC));
+        }
+        ESP_LOGI(TAG, "window %d: frequency error %.3f Hz max (bins of %.3f Hz)", sweep_windows[w], max_error, (float)SAMPLE_FREC / SIGNAL_LENGHT);
+        TEST_ASSERT_LESS_THAN(sweep_error[w], max_error);
+    }
+}
+
+TEST_CASE("SignalQuality THD and SFDR", "[signal_quality]")
+{
+    // Fundamental at 0.3 fs: the 2nd (0.6 fs) and 3rd (0.9 fs) harmonics alias to 0.4 fs and 0.1 fs
+    const test_signal_t signals[] = {{0.3f, 0.01f, 0.00316f, 0.001f}, {0.3f, 0.03f, 0, 0.001f}, {0.1013f, 0.03f, 0.01f, 0.001f}};
+    TEST_ASSERT_TRUE(FFTInit());
+    for (uint8_t s = 0; s < sizeof(signals) / sizeof(test_signal_t); s++){
+        const test_signal_t * t = &signals[s];
+        signal_quality_t quality;
+        float sfdr_ref;
+        Measure(t, FFT_WINDOW_HANN, SIGNAL_QUALITY_LOBE_HANN, &quality, &sfdr_ref);
+        float thd = 10 * log10f(t->h2 * t->h2 + t->h3 * t->h3);
+        ESP_LOGI(TAG, "harmonics %g %g: THD %.2f dB (expected %.2f), SFDR %.2f dB (dsps_sfdr_f32 %.2f)",
+                 t->h2, t->h3, quality.thd, thd, quality.sfdr, sfdr_ref);
+        TEST_ASSERT_FLOAT_WITHIN(0.1f, thd, quality.thd);
+        TEST_ASSERT_FLOAT_WITHIN(0.1f, sfdr_ref, quality.sfdr);
+    }
+}
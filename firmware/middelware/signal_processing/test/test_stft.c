@@ -0,0 +1,143 @@
+/**
+ * @file test_stft.c
+ * @author Albano Peñalva (albano.penalva@uner.edu.ar)
+ * @brief Unity tests and benchmarks of the STFT module
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2023
+ *
+ */
+
+/*==================[inclusions]=============================================*/
+#include <string.h>
+#include <stdlib.h>
+#include <math.h>
+#include "unity.h"
+#include "dsp_platform.h"
+#include "esp_log.h"
+#include "sdkconfig.h"
+#include "stft.h"
+/*==================[macros and definitions]=================================*/
+#define FRAME_LENGHT    256
+#define HOP             64
+#define N_FRAMES        12
+#define SIGNAL_LENGHT   (FRAME_LENGHT + (N_FRAMES - 1) * HOP)
+static const char *TAG = "stft";
+
+typedef struct {
+    float * spectrogram;        /* N_FRAMES frames of FRAME_LENGHT / 2 values */
+    uint16_t frames;
+} spectrogram_t;
+/*==================[internal functions definition]==========================*/
+/**
+ * @brief Linear chirp plus an offset
+ */
+static void TestSignal(float * signal, uint32_t signal_lenght){
+    for (uint32_t i = 0; i < signal_lenght; i++){
+        signal[i] = 0.5f + sinf(M_PI * (0.01f + 0.4f * i / signal_lenght) * i);
+    }
+}
+
+/**
+ * @brief Offline spectrogram: direct DFT in double of every Hann windowed frame, FFTMagnitude() scale
+ */
+static void SpectrogramRef(float * signal, float * spectrogram){
+    for (uint16_t m = 0; m < N_FRAMES; m++){
+        float * x = &signal[m * HOP];
+        for (uint16_t k = 0; k < FRAME_LENGHT / 2; k++){
+            double re = 0, im = 0;
+            for (uint16_t i = 0; i < FRAME_LENGHT; i++){
+                double w = 0.5 * (1 - cos(2 * M_PI * i / (FRAME_LENGHT - 1)));
+                re += w * x[i] * cos(2 * M_PI * k * i / FRAME_LENGHT);
+                im -= w * x[i] * sin(2 * M_PI * k * i / FRAME_LENGHT);
+            }
+            // 4 * |X[k]| / (FRAME_LENGHT / 2), DC not doubled
+            double mag = sqrt(re * re + im * im) / (FRAME_LENGHT / 2);
+            spectrogram[m * FRAME_LENGHT / 2 + k] = (k == 0) ? mag : 4 * mag;
+        }
+    }
+}
+
+static void StoreFrame(void * param, float * frame){
+    spectrogram_t * s = (spectrogram_t *)param;
+    if (s->frames < N_FRAMES){
+        memcpy(&s->spectrogram[s->frames * FRAME_LENGHT / 2], frame, FRAME_LENGHT / 2 * sizeof(float));
+    }
+    s->frames++;
+}
+
+TEST_CASE("STFTProcess functionality", "[stft]")
+{
+    float * signal = malloc(SIGNAL_LENGHT * sizeof(float));
+    float * ref = malloc(N_FRAMES * FRAME_LENGHT / 2 * sizeof(float));
+    spectrogram_t out = {.spectrogram = malloc(N_FRAMES * FRAME_LENGHT / 2 * sizeof(float))};
+    TEST_ASSERT_NOT_NULL(out.spectrogram);
+    TEST_ASSERT_TRUE(FFTInit());
+    TestSignal(signal, SIGNAL_LENGHT);
+    SpectrogramRef(signal, ref);
+
+    // Blocks of uneven sizes, so frames end anywhere in a block and the ring wraps mid block
+    const uint16_t blocks[] = {1, 37, 100, 5, 256, 63};
+    stft_t stft;
+    TEST_ASSERT_TRUE(STFTInit(&stft, FRAME_LENGHT, HOP, FFT_WINDOW_HANN, StoreFrame, &out));
+    uint32_t fed = 0;
+    uint16_t emitted = 0;
+    for (uint8_t b = 0; fed < SIGNAL_LENGHT; b = (b + 1) % (sizeof(blocks) / sizeof(uint16_t))){
+        uint16_t lenght = (blocks[b] < SIGNAL_LENGHT - fed) ? blocks[b] : SIGNAL_LENGHT - fed;
+        emitted += STFTProcess(&stft, &signal[fed], lenght);
+        fed += lenght;
+    }
+    TEST_ASSERT_EQUAL(N_FRAMES, emitted);
+    TEST_ASSERT_EQUAL(N_FRAMES, out.frames);
+    TEST_ASSERT_EQUAL(N_FRAMES, stft.frames);
+
+    float max_error = 0;
+    for (uint32_t i = 0; i < N_FRAMES * FRAME_LENGHT / 2; i++){
+        max_error = fmaxf(max_error, fabsf(out.spectrogram[i] - ref[i]));
+    }
+    ESP_LOGI(TAG, "%d frames of %d points, hop %d: max error %g", N_FRAMES, FRAME_LENGHT, HOP, max_error);
+    TEST_ASSERT_LESS_THAN(1e-5f, max_error);
+    // Last frame also kept in the object
+    TEST_ASSERT_EQUAL(0, memcmp(&out.spectrogram[(N_FRAMES - 1) * FRAME_LENGHT / 2], stft.frame, FRAME_LENGHT / 2 * sizeof(float)));
+
+    // After a reset the first frame needs a whole frame lenght again
+    STFTReset(&stft);
+    TEST_ASSERT_EQUAL(0, STFTProcess(&stft, signal, FRAME_LENGHT - 1));
+    TEST_ASSERT_EQUAL(1, STFTProcess(&stft, &signal[FRAME_LENGHT - 1], 1));
+    STFTDeinit(&stft);
+    free(signal);
+    free(ref);
+    free(out.spectrogram);
+}
+
+TEST_CASE("STFTProcess benchmark", "[stft]")
+{
+    const uint16_t block = 128;
+    float * signal = malloc(block * sizeof(float));
+    TEST_ASSERT_NOT_NULL(signal);
+    TEST_ASSERT_TRUE(FFTInit());
+    TestSignal(signal, block);
+    for (uint16_t n = 256; n <= MAX_SIGNAL_LENGHT; n *= 2){
+        for (uint16_t hop = n / 4; hop <= n / 2; hop *= 2){
+            stft_t stft;
+            TEST_ASSERT_TRUE(STFTInit(&stft, n, hop, FFT_WINDOW_HANN, NULL, NULL));
+            // Fill the first frame before measuring
+            while (stft.frames == 0){
+                STFTProcess(&stft, signal, block);
+            }
+            uint32_t frames = stft.frames;
+            unsigned int start_b = xthal_get_ccount();
+            while (stft.frames - frames < 16){
+                STFTProcess(&stft, signal, block);
+            }
+            unsigned int end_b = xthal_get_ccount();
+            float cycles = (float)(end_b - start_b) / (stft.frames - frames);
+            ESP_LOGI(TAG, "%d points, hop %d: %.0f cycles per frame, %.0f frames/s at %d MHz (%.0f samples/s)",
+                     n, hop, cycles, CONFIG_ESP_DEFAULT_CPU_FREQ_MHZ * 1e6f / cycles, CONFIG_ESP_DEFAULT_CPU_FREQ_MHZ,
+                     CONFIG_ESP_DEFAULT_CPU_FREQ_MHZ * 1e6f / cycles * hop);
+            STFTDeinit(&stft);
+        }
+    }
+    free(signal);
+}
@@ -0,0 +1,246 @@
+/**
+ * @file test_xcorr.c
+ * @author Albano Peñalva (albano.penalva@uner.edu.ar)
+ * @brief Unity tests and benchmarks of the cross-correlation module
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2023
+ *
+ */
+
+/*==================[inclusions]=============================================*/
+#include <string.h>
+#include <stdlib.h>
+#include <math.h>
+#include "unity.h"
+#include "dsp_platform.h"
+#include "esp_log.h"
+#include "esp_dsp.h"
+#include "fft.h"
+#include "xcorr.h"
+/*==================[macros and definitions]=================================*/
+#define MAX_RECORD      4096
+#define SINC_HALF       32          /* Fractional delay filter half lenght */
+#define PASS_BAND       0.25f       /* Band-limited noise cut-off (cycles per sample) */
+static const char *TAG = "xcorr";
+/*==================[internal functions definition]==========================*/
+/**
+ * @brief Deterministic gaussian noise (Box-Muller on a LCG)
+ */
+static float Gauss(uint32_t * seed){
+    *seed = *seed * 1664525 + 1013904223;
+    float u = ((*seed >> 8) + 1.0f) / 16777218.0f;
+    *seed = *seed * 1664525 + 1013904223;
+    float v = ((*seed >> 8) + 1.0f) / 16777218.0f;
+    return sqrtf(-2 * logf(u)) * cosf(2 * M_PI * v);
+}
+
+/**
+ * @brief White noise through a Hann windowed sinc low pass delayed by delay samples
+ *
+ * The same noise with different delays gives channels with an exact fractional delay between them.
+ */
+static void BandNoise(const float * noise, float * signal, uint32_t signal_lenght, float delay){
+    for (uint32_t i = 0; i < signal_lenght; i++){
+        float sum = 0;
+        for (int16_t k = -SINC_HALF; k <= SINC_HALF; k++){
+            float m = k - delay;
+            float sinc = (m == 0) ? 2 * PASS_BAND : sinf(2 * M_PI * PASS_BAND * m) / (M_PI * m);
+            float window = (fabsf(m) < SINC_HALF) ? 0.5f + 0.5f * cosf(M_PI * m / SINC_HALF) : 0;
+            sum += sinc * window * noise[i + SINC_HALF - k];
+        }
+        signal[i] = sum;
+    }
+}
+
+/**
+ * @brief Lags -max_lag ... max_lag of the correlation of two records, with dsps_corr_f32_ansi()
+ *
+ * @param padded    signal_lenght + 2 * max_lag values of work memory
+ */
+static void XCorrRef(const float * x, const float * y, uint32_t signal_lenght, uint16_t max_lag, float * padded, float * corr){
+    memset(padded, 0, max_lag * sizeof(float));
+    memcpy(&padded[max_lag], y, signal_lenght * sizeof(float));
+    memset(&padded[max_lag + signal_lenght], 0, max_lag * sizeof(float));
+    dsps_corr_f32_ansi(padded, signal_lenght + 2 * max_lag, x, signal_lenght, corr);
+}
+
+/**
+ * @brief Whole record followed by the zero blocks that flush the x delay line
+ */
+static void XCorrRecord(xcorr_t * xcorr, const float * x, const float * y, uint32_t signal_lenght, float * zeros){
+    XCorrReset(xcorr);
+    for (uint32_t start = 0; start < signal_lenght; start += xcorr->block_lenght){
+        XCorrUpdate(xcorr, &x[start], &y[start], xcorr->block_lenght);
+    }
+    for (uint16_t flushed = 0; flushed < xcorr->max_lag; flushed += xcorr->block_lenght){
+        XCorrUpdate(xcorr, zeros, zeros, xcorr->block_lenght);
+    }
+}
+
+TEST_CASE("XCorr functionality", "[xcorr]")
+{
+    const uint16_t blocks[] = {64, 256, 448};
+    const uint16_t lags[] = {8, 128, 32};
+    const uint32_t l = 1792;            /* Multiple of every block */
+    float * noise = malloc((l + 2 * SINC_HALF) * sizeof(float));
+    float * x = malloc(l * sizeof(float));
+    float * y = malloc(l * sizeof(float));
+    float * zeros = calloc(MAX_SIGNAL_LENGHT, sizeof(float));
+    float * padded = malloc((l + 2 * MAX_SIGNAL_LENGHT) * sizeof(float));
+    float * ref = malloc((2 * MAX_SIGNAL_LENGHT + 1) * sizeof(float));
+    float * corr = malloc((2 * MAX_SIGNAL_LENGHT + 1) * sizeof(float));
+    TEST_ASSERT_NOT_NULL(corr);
+    TEST_ASSERT_TRUE(FFTInit());
+    uint32_t seed = 1;
+    for (uint32_t i = 0; i < l + 2 * SINC_HALF; i++){
+        noise[i] = Gauss(&seed);
+    }
+    BandNoise(noise, x, l, 0);
+    BandNoise(noise, y, l, 5.0f);
+    for (uint8_t t = 0; t < sizeof(blocks) / sizeof(uint16_t); t++){
+        xcorr_t xcorr;
+        TEST_ASSERT_TRUE(XCorrInit(&xcorr, blocks[t], lags[t], XCORR_PLAIN, 0));
+        XCorrRecord(&xcorr, x, y, l, zeros);
+        XCorrGet(&xcorr, corr);
+        XCorrRef(x, y, l, lags[t], padded, ref);
+        float max_error = 0, max_ref = 0;
+        for (uint16_t i = 0; i <= 2 * lags[t]; i++){
+            max_error = fmaxf(max_error, fabsf(corr[i] - ref[i]));
+            max_ref = fmaxf(max_ref, fabsf(ref[i]));
+        }
+        ESP_LOGI(TAG, "blocks of %d, max lag %d: relative error vs dsps_corr_f32 %.2e", blocks[t], lags[t], max_error / max_ref);
+        TEST_ASSERT_LESS_THAN(1e-5f, max_error / max_ref);
+        TEST_ASSERT_FLOAT_WITHIN(0.01f, 5.0f, XCorrDelay(&xcorr, NULL));
+        XCorrDeinit(&xcorr);
+    }
+    // Block and lags must fit a plan
+    xcorr_t xcorr;
+    TEST_ASSERT_FALSE(XCorrInit(&xcorr, MAX_SIGNAL_LENGHT, 1, XCORR_PLAIN, 0));
+    TEST_ASSERT_FALSE(XCorrInit(&xcorr, 0, 8, XCORR_PLAIN, 0));
+    free(noise);
+    free(x);
+    free(y);
+    free(zeros);
+    free(padded);
+    free(ref);
+    free(corr);
+}
+
+TEST_CASE("XCorrDelay accuracy", "[xcorr]")
+{
+    // Band-limited noise with fractional delays, uncorrelated noise on both channels (SNR 10 dB)
+    const uint16_t block = 256;
+    const uint16_t max_lag = 32;
+    const uint32_t l = 2048;
+    const float snr = 10;
+    float * noise = malloc((l + 2 * SINC_HALF) * sizeof(float));
+    float * x = malloc(l * sizeof(float));
+    float * y = malloc(l * sizeof(float));
+    float * zeros = calloc(block, sizeof(float));
+    TEST_ASSERT_NOT_NULL(zeros);
+    TEST_ASSERT_TRUE(FFTInit());
+    uint32_t seed = 7;
+    for (xcorr_weighting_t weighting = XCORR_PLAIN; weighting <= XCORR_PHAT; weighting++){
+        xcorr_t xcorr;
+        TEST_ASSERT_TRUE(XCorrInit(&xcorr, block, max_lag, weighting, 0));
+        float max_error = 0;
+        for (float delay = -20; delay <= 20; delay += 1.7f){
+            for (uint32_t i = 0; i < l + 2 * SINC_HALF; i++){
+                noise[i] = Gauss(&seed);
+            }
+            BandNoise(noise, x, l, 0);
+            BandNoise(noise, y, l, delay);
+            // Band-limited signal power is 2 * PASS_BAND
+            float sigma = sqrtf(2 * PASS_BAND / powf(10, snr / 10));
+            for (uint32_t i = 0; i < l; i++){
+                x[i] += sigma * Gauss(&seed);
+                y[i] += sigma * Gauss(&seed);
+            }
+            XCorrRecord(&xcorr, x, y, l, zeros);
+            max_error = fmaxf(max_error, fabsf(XCorrDelay(&xcorr, NULL) - delay));
+        }
+        ESP_LOGI(TAG, "%s: max delay error %.3f samples", (weighting == XCORR_PHAT) ? "PHAT" : "plain", max_error);
+        TEST_ASSERT_LESS_THAN(0.13f, max_error);
+        XCorrDeinit(&xcorr);
+    }
+    // Streaming with averaging: a delay step is followed within a few blocks
+    xcorr_t xcorr;
+    TEST_ASSERT_TRUE(XCorrInit(&xcorr, block, max_lag, XCORR_PHAT, 4));
+    for (uint32_t i = 0; i < l + 2 * SINC_HALF; i++){
+        noise[i] = Gauss(&seed);
+    }
+    BandNoise(noise, x, l, 0);
+    BandNoise(noise, y, l, 5);
+    XCorrUpdate(&xcorr, x, y, l);
+    TEST_ASSERT_FLOAT_WITHIN(0.5f, 5, XCorrDelay(&xcorr, NULL));
+    BandNoise(noise, y, l, -9);
+    uint8_t blocks = 0;
+    for (uint32_t start = 0; start < l; start += block){
+        XCorrUpdate(&xcorr, &x[start], &y[start], block);
+        blocks++;
+        if (fabsf(XCorrDelay(&xcorr, NULL) + 9) < 0.5f){
+            break;
+        }
+    }
+    ESP_LOGI(TAG, "PHAT, averaging 4: delay step from 5 to -9 samples followed in %d blocks", blocks);
+    TEST_ASSERT_LESS_THAN(4, blocks);
+    XCorrDeinit(&xcorr);
+    free(noise);
+    free(x);
+    free(y);
+    free(zeros);
+}
+
+TEST_CASE("XCorr benchmark", "[xcorr]")
+{
+    // Same lag window with the streaming FFT correlation and with dsps_corr_f32_ansi() on the whole record
+    const uint16_t blocks[] = {256, 448};
+    const uint16_t lags[] = {128, 32};
+    float * x = malloc(MAX_RECORD * sizeof(float));
+    float * y = malloc(MAX_RECORD * sizeof(float));
+    float * zeros = calloc(MAX_SIGNAL_LENGHT, sizeof(float));
+    float * padded = malloc((MAX_RECORD + 2 * MAX_SIGNAL_LENGHT) * sizeof(float));
+    float * ref = malloc((2 * MAX_SIGNAL_LENGHT + 1) * sizeof(float));
+    TEST_ASSERT_NOT_NULL(ref);
+    TEST_ASSERT_TRUE(FFTInit());
+    uint32_t seed = 3;
+    for (uint32_t i = 0; i < MAX_RECORD; i++){
+        x[i] = Gauss(&seed);
+        y[i] = Gauss(&seed);
+    }
+    int repeat_count = 4;
+    for (uint8_t t = 0; t < sizeof(blocks) / sizeof(uint16_t); t++){
+        xcorr_t xcorr;
+        TEST_ASSERT_TRUE(XCorrInit(&xcorr, blocks[t], lags[t], XCORR_PLAIN, 0));
+        for (uint32_t l = 256; l <= MAX_RECORD; l *= 2){
+            // Record rounded up to whole blocks
+            uint32_t l_blocks = (l + blocks[t] - 1) / blocks[t] * blocks[t];
+            if (l_blocks > MAX_RECORD){
+                continue;
+            }
+            unsigned int start_b = xthal_get_ccount();
+            for (int i = 0; i < repeat_count; i++){
+                XCorrRecord(&xcorr, x, y, l_blocks, zeros);
+                XCorrDelay(&xcorr, NULL);
+            }
+            unsigned int end_b = xthal_get_ccount();
+            float cycles_xcorr = (float)(end_b - start_b) / repeat_count;
+            start_b = xthal_get_ccount();
+            for (int i = 0; i < repeat_count; i++){
+                XCorrRef(x, y, l_blocks, lags[t], padded, ref);
+            }
+            end_b = xthal_get_ccount();
+            float cycles_corr = (float)(end_b - start_b) / repeat_count;
+            ESP_LOGI(TAG, "%d samples, blocks of %d, max lag %d: XCorr %.0f, dsps_corr_f32_ansi %.0f cycles (x%.1f)",
+                     l_blocks, blocks[t], lags[t], cycles_xcorr, cycles_corr, cycles_corr / cycles_xcorr);
+        }
+        XCorrDeinit(&xcorr);
+    }
+    free(x);
+    free(y);
+    free(zeros);
+    free(padded);
+    free(ref);
+}